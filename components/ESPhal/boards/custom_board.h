@@ -13,10 +13,7 @@
 
 #include "driver/gpio.h"
 #include "esp_adc/adc_oneshot.h"
-
-// I2C port definitions
-#define I2C_NUM_0 0
-#define I2C_NUM_1 1
+#include "hal/i2c_types.h"
 
 namespace BoardConfig {
 
@@ -77,11 +74,12 @@ struct OneWireConfig {
     gpio_num_t data_pin;
     gpio_num_t power_pin;  // GPIO_NUM_NC if not used
     const char* description;
+    OneWireDriver driver;
 };
 
 static const OneWireConfig ONEWIRE_BUSES[] = {
-    {"ONEWIRE_BUS_1",  GPIO_NUM_8, GPIO_NUM_NC, "DS18B20 Sensor 1"},
-    {"ONEWIRE_BUS_2",  GPIO_NUM_7, GPIO_NUM_NC, "DS18B20 Sensor 2"}
+    {"ONEWIRE_BUS_1",  GPIO_NUM_8, GPIO_NUM_NC, "DS18B20 Sensor 1", OneWireDriver::GPIO},
+    {"ONEWIRE_BUS_2",  GPIO_NUM_7, GPIO_NUM_NC, "DS18B20 Sensor 2", OneWireDriver::GPIO}
 };
 
 static const size_t ONEWIRE_BUSES_COUNT = sizeof(ONEWIRE_BUSES) / sizeof(ONEWIRE_BUSES[0]);
@@ -102,6 +100,21 @@ static const AdcConfig ADC_CHANNELS[] = {
 
 static const size_t ADC_CHANNELS_COUNT = sizeof(ADC_CHANNELS) / sizeof(ADC_CHANNELS[0]);
 
+// Імпульсні входи (PCNT) - тахометри, витратоміри
+struct PulseInputConfig {
+    const char* hal_id;
+    gpio_num_t pin;
+    uint32_t glitch_ns;     // Ignore pulses shorter than this
+    bool pull_up;
+    const char* description;
+};
+
+static const PulseInputConfig PULSE_INPUTS[] = {
+    {"PULSE_1", GPIO_NUM_17, 1000, true, "Pulse input 1"}
+};
+
+static const size_t PULSE_INPUTS_COUNT = sizeof(PULSE_INPUTS) / sizeof(PULSE_INPUTS[0]);
+
 // Board-specific constants
 static const char* BOARD_NAME = "Custom Board";
 static const char* BOARD_VERSION = "1.0";
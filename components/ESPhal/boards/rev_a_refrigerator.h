@@ -13,10 +13,7 @@
 
 #include "driver/gpio.h"
 #include "esp_adc/adc_oneshot.h"
-
-// I2C port definitions
-#define I2C_NUM_0 0
-#define I2C_NUM_1 1
+#include "hal/i2c_types.h"
 
 namespace BoardConfig {
 
@@ -75,12 +72,13 @@ struct OneWireConfig {
     gpio_num_t data_pin;
     gpio_num_t power_pin;  // GPIO_NUM_NC if not used
     const char* description;
+    OneWireDriver driver;
 };
 
 static const OneWireConfig ONEWIRE_BUSES[] = {
-    {"EVAP_TEMP",      GPIO_NUM_8, GPIO_NUM_NC, "Evaporator temperature"},
-    {"AMBIENT_TEMP",   GPIO_NUM_7, GPIO_NUM_NC, "Ambient temperature"},
-    {"PRODUCT_TEMP",   GPIO_NUM_6, GPIO_NUM_NC, "Product temperature"}
+    {"EVAP_TEMP",      GPIO_NUM_8, GPIO_NUM_NC, "Evaporator temperature", OneWireDriver::RMT},
+    {"AMBIENT_TEMP",   GPIO_NUM_7, GPIO_NUM_NC, "Ambient temperature", OneWireDriver::RMT},
+    {"PRODUCT_TEMP",   GPIO_NUM_6, GPIO_NUM_NC, "Product temperature", OneWireDriver::RMT}
 };
 
 static const size_t ONEWIRE_BUSES_COUNT = sizeof(ONEWIRE_BUSES) / sizeof(ONEWIRE_BUSES[0]);
@@ -100,6 +98,22 @@ static const AdcConfig ADC_CHANNELS[] = {
 
 static const size_t ADC_CHANNELS_COUNT = sizeof(ADC_CHANNELS) / sizeof(ADC_CHANNELS[0]);
 
+// Pulse counter inputs (PCNT) for tachometers and flow meters
+struct PulseInputConfig {
+    const char* hal_id;
+    gpio_num_t pin;
+    uint32_t glitch_ns;     // Ignore pulses shorter than this
+    bool pull_up;
+    const char* description;
+};
+
+static const PulseInputConfig PULSE_INPUTS[] = {
+    {"EVAP_FAN_TACH", GPIO_NUM_17, 1000, true, "Evaporator fan tachometer"},
+    {"COND_FAN_TACH", GPIO_NUM_18, 1000, true, "Condenser fan tachometer"}
+};
+
+static const size_t PULSE_INPUTS_COUNT = sizeof(PULSE_INPUTS) / sizeof(PULSE_INPUTS[0]);
+
 // Board-specific constants
 static const char* BOARD_NAME = "Rev A Refrigerator Controller";
 static const char* BOARD_VERSION = "1.0";
@@ -13,10 +13,7 @@
 
 #include "driver/gpio.h"
 #include "esp_adc/adc_oneshot.h"
-
-// I2C port definitions
-#define I2C_NUM_0 0
-#define I2C_NUM_1 1
+#include "hal/i2c_types.h"
 
 namespace BoardConfig {
 
@@ -78,12 +75,13 @@ struct OneWireConfig {
     gpio_num_t data_pin;
     gpio_num_t power_pin;
     const char* description;
+    OneWireDriver driver;
 };
 
 static const OneWireConfig ONEWIRE_BUSES[] = {
-    {"CHAMBER_TEMP",    GPIO_NUM_8, GPIO_NUM_NC, "Chamber temperature"},
-    {"PRODUCT_TEMP",    GPIO_NUM_7, GPIO_NUM_NC, "Product temperature"},
-    {"EXHAUST_TEMP",    GPIO_NUM_14, GPIO_NUM_NC, "Exhaust temperature"}
+    {"CHAMBER_TEMP",    GPIO_NUM_8, GPIO_NUM_NC, "Chamber temperature", OneWireDriver::GPIO},
+    {"PRODUCT_TEMP",    GPIO_NUM_7, GPIO_NUM_NC, "Product temperature", OneWireDriver::GPIO},
+    {"EXHAUST_TEMP",    GPIO_NUM_14, GPIO_NUM_NC, "Exhaust temperature", OneWireDriver::GPIO}
 };
 
 static const size_t ONEWIRE_BUSES_COUNT = sizeof(ONEWIRE_BUSES) / sizeof(ONEWIRE_BUSES[0]);
@@ -105,6 +103,22 @@ static const AdcConfig ADC_CHANNELS[] = {
 
 static const size_t ADC_CHANNELS_COUNT = sizeof(ADC_CHANNELS) / sizeof(ADC_CHANNELS[0]);
 
+// Pulse counter inputs (PCNT) for tachometers and flow meters
+struct PulseInputConfig {
+    const char* hal_id;
+    gpio_num_t pin;
+    uint32_t glitch_ns;     // Ignore pulses shorter than this
+    bool pull_up;
+    const char* description;
+};
+
+static const PulseInputConfig PULSE_INPUTS[] = {
+    {"VENT_FAN_TACH", GPIO_NUM_17, 1000, true, "Ventilation fan tachometer"},
+    {"WATER_FLOW",    GPIO_NUM_18, 1000, true, "Humidifier water flow meter"}
+};
+
+static const size_t PULSE_INPUTS_COUNT = sizeof(PULSE_INPUTS) / sizeof(PULSE_INPUTS[0]);
+
 // Board-specific constants
 static const char* BOARD_NAME = "Rev B Ripening Chamber Controller";
 static const char* BOARD_VERSION = "2.0";
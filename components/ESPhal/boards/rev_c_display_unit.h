@@ -13,10 +13,7 @@
 
 #include "driver/gpio.h"
 #include "esp_adc/adc_oneshot.h"
-
-// I2C port definitions
-#define I2C_NUM_0 0
-#define I2C_NUM_1 1
+#include "hal/i2c_types.h"
 
 namespace BoardConfig {
 
@@ -78,10 +75,11 @@ struct OneWireConfig {
     gpio_num_t data_pin;
     gpio_num_t power_pin;
     const char* description;
+    OneWireDriver driver;
 };
 
 static const OneWireConfig ONEWIRE_BUSES[] = {
-    {"LOCAL_TEMP", GPIO_NUM_8, GPIO_NUM_NC, "Local ambient temperature"}
+    {"LOCAL_TEMP", GPIO_NUM_8, GPIO_NUM_NC, "Local ambient temperature", OneWireDriver::GPIO}
 };
 
 static const size_t ONEWIRE_BUSES_COUNT = sizeof(ONEWIRE_BUSES) / sizeof(ONEWIRE_BUSES[0]);
@@ -101,6 +99,21 @@ static const AdcConfig ADC_CHANNELS[] = {
 
 static const size_t ADC_CHANNELS_COUNT = sizeof(ADC_CHANNELS) / sizeof(ADC_CHANNELS[0]);
 
+// Pulse counter inputs (PCNT)
+struct PulseInputConfig {
+    const char* hal_id;
+    gpio_num_t pin;
+    uint32_t glitch_ns;     // Ignore pulses shorter than this
+    bool pull_up;
+    const char* description;
+};
+
+static const PulseInputConfig PULSE_INPUTS[] = {
+    {"PULSE_AUX", GPIO_NUM_17, 1000, true, "Auxiliary pulse input"}
+};
+
+static const size_t PULSE_INPUTS_COUNT = sizeof(PULSE_INPUTS) / sizeof(PULSE_INPUTS[0]);
+
 // Board-specific constants
 static const char* BOARD_NAME = "Rev C Display Unit";
 static const char* BOARD_VERSION = "3.0";
@@ -0,0 +1,101 @@
+/**
+ * @file adc_continuous_service.h
+ * @brief Background ADC sampling of all board ADC1 channels via DMA
+ */
+
+#pragma once
+
+#include <esp_err.h>
+#include <esp_adc/adc_continuous.h>
+#include <soc/soc_caps.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Continuous-mode ADC service
+ *
+ * The ADC digital controller samples the registered channels round-robin
+ * and DMA fills a ring buffer. A service task drains it on each
+ * conversion-done interrupt, oversamples every channel and applies an IIR
+ * filter. Readers get the latest filtered value in O(1) without touching
+ * the ADC.
+ *
+ * Values are kept in 12.4 fixed point (raw 12-bit units * 16), so
+ * oversampling adds up to 4 bits of resolution.
+ */
+class AdcContinuousService {
+public:
+    static constexpr int MAX_CHANNELS = SOC_ADC_MAX_CHANNEL_NUM;
+    static constexpr int FRACTION_BITS = 4;
+
+    /**
+     * @param sample_freq_hz Total conversion rate for all channels
+     * @param oversample Samples averaged per channel before the filter
+     * @param filter_shift IIR weight 1/2^shift for a new averaged value (0 = no filter)
+     */
+    AdcContinuousService(uint32_t sample_freq_hz, uint8_t oversample, uint8_t filter_shift);
+    ~AdcContinuousService();
+
+    /**
+     * @brief Register an ADC1 channel (before start())
+     * @return Slot index, or -1 if the channel cannot be added
+     */
+    int add_channel(adc_channel_t channel, adc_atten_t attenuation);
+
+    esp_err_t start();
+    void stop();
+
+    bool is_running() const { return handle_ != nullptr; }
+    size_t channel_count() const { return channel_count_; }
+
+    /**
+     * @brief Latest filtered value of a slot in 12.4 fixed point
+     * @return false if no value has been produced yet
+     */
+    bool latest(int index, int32_t& value_q4) const;
+
+    uint32_t samples(int index) const;
+    uint32_t frames() const { return frames_.load(std::memory_order_relaxed); }
+    uint32_t overflows() const { return overflows_.load(std::memory_order_relaxed); }
+
+private:
+    struct Slot {
+        adc_channel_t channel;
+        adc_atten_t attenuation;
+
+        // Touched only by the service task
+        uint32_t sum;
+        uint8_t count;
+        int32_t filtered_q4;
+
+        // Published to readers
+        std::atomic<int32_t> value_q4;
+        std::atomic<uint32_t> samples;
+    };
+
+    static void task_entry(void* arg);
+    void task_loop();
+    void process(const uint8_t* data, uint32_t length);
+    void accumulate(Slot& slot, uint32_t raw);
+
+    static bool on_conv_done(adc_continuous_handle_t handle,
+                             const adc_continuous_evt_data_t* edata, void* user_data);
+    static bool on_pool_ovf(adc_continuous_handle_t handle,
+                            const adc_continuous_evt_data_t* edata, void* user_data);
+
+    uint32_t sample_freq_hz_;
+    uint8_t oversample_;
+    uint8_t filter_shift_;
+
+    Slot slots_[MAX_CHANNELS];
+    size_t channel_count_ = 0;
+    int8_t slot_by_channel_[MAX_CHANNELS];
+
+    adc_continuous_handle_t handle_ = nullptr;
+    TaskHandle_t task_ = nullptr;
+
+    std::atomic<uint32_t> frames_{0};
+    std::atomic<uint32_t> overflows_{0};
+};
@@ -10,6 +10,14 @@
 
 #include "sdkconfig.h"
 
+/**
+ * @brief OneWire bus implementation, selected per bus in ONEWIRE_BUSES
+ */
+enum class OneWireDriver {
+    GPIO,   // Bit-banged slots (OneWireBusImpl)
+    RMT     // RMT TX/RX channels (OneWireRmtBus), falls back to GPIO if no channel is free
+};
+
 // Include appropriate board configuration based on Kconfig selection
 #if defined(CONFIG_ESPHAL_BOARD_REV_A_REFRIGERATOR)
     #include "rev_a_refrigerator.h"
@@ -15,6 +15,8 @@
 #include <optional>
 #include "esp_err.h"
 #include "hal_interfaces.h"
+#include "i2c_interfaces.h"
+#include "ledc_allocator.h"
 
 /**
  * @brief Main Hardware Abstraction Layer class
@@ -105,6 +107,44 @@ public:
      */
     IAdcChannel* get_adc_channel_ptr(const std::string& hal_id);
     
+    /**
+     * @brief Get pulse counter driver pointer
+     * 
+     * @param hal_id Hardware ID from board configuration (e.g., "EVAP_FAN_TACH")
+     * @return Pointer to pulse counter interface, or nullptr if not found
+     */
+    IPulseCounter* get_pulse_counter_ptr(const std::string& hal_id);
+    
+    /**
+     * @brief Get I2C bus pointer
+     * 
+     * @param hal_id Hardware ID from board configuration (e.g., "I2C_SENSORS")
+     * @return Pointer to I2C bus interface, or nullptr if not found
+     */
+    II2CBus* get_i2c_bus_ptr(const std::string& hal_id);
+    
+    /**
+     * @brief Get shared handle of a device on an I2C bus
+     * 
+     * Drivers on the same bus and address (e.g. RTC and its alarm logic)
+     * get the same handle; all transfers are queued by the bus.
+     * 
+     * @param hal_id Hardware ID of the bus
+     * @param address 7-bit device address
+     * @return Pointer to device handle, or nullptr if the bus is not found
+     */
+    II2CDevice* get_i2c_device(const std::string& hal_id, uint8_t address);
+    
+    /**
+     * @brief Get LEDC allocator
+     * 
+     * PWM drivers acquire channels here instead of picking channel and
+     * timer numbers themselves; equal frequencies share a timer.
+     * 
+     * @return Reference to the allocator owned by ESPhal
+     */
+    LedcAllocator& get_ledc_allocator() { return ledc_allocator_; }
+    
     /**
      * @brief Check if GPIO output exists
      * @param hal_id Hardware ID to check
@@ -132,6 +172,20 @@ public:
      * @return true if hal_id is configured as ADC channel
      */
     bool has_adc_channel(const std::string& hal_id) const;
+    
+    /**
+     * @brief Check if pulse counter exists
+     * @param hal_id Hardware ID to check
+     * @return true if hal_id is configured as pulse input
+     */
+    bool has_pulse_counter(const std::string& hal_id) const;
+    
+    /**
+     * @brief Check if I2C bus exists
+     * @param hal_id Hardware ID to check
+     * @return true if hal_id is configured as I2C bus
+     */
+    bool has_i2c_bus(const std::string& hal_id) const;
 
     /**
      * @brief Get board information
@@ -145,6 +199,9 @@ private:
     std::unordered_map<std::string, std::unique_ptr<IGpioInput>> gpio_inputs_;
     std::unordered_map<std::string, std::unique_ptr<IOneWireBus>> onewire_buses_;
     std::unordered_map<std::string, std::unique_ptr<IAdcChannel>> adc_channels_;
+    std::unordered_map<std::string, std::unique_ptr<IPulseCounter>> pulse_counters_;
+    std::unordered_map<std::string, std::unique_ptr<II2CBus>> i2c_buses_;
+    LedcAllocator ledc_allocator_;
     
     // Initialization state
     bool initialized_ = false;
@@ -154,6 +211,8 @@ private:
     esp_err_t init_gpio_inputs();
     esp_err_t init_onewire_buses();
     esp_err_t init_adc_channels();
+    esp_err_t init_pulse_counters();
+    esp_err_t init_i2c_buses();
     
     // Helper method for error reporting
     void throw_if_not_found(const std::string& hal_id, const std::string& resource_type) const;
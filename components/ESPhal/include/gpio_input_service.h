@@ -0,0 +1,106 @@
+/**
+ * @file gpio_input_service.h
+ * @brief Interrupt-driven digital inputs with timer-based debouncing
+ */
+
+#pragma once
+
+#include <esp_err.h>
+#include <esp_timer.h>
+#include <driver/gpio.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Edge interrupt service for all board GPIO inputs
+ *
+ * Every edge is timestamped in the ISR and pushed into a lock-free ring.
+ * The service task drains the ring and re-arms a one-shot esp_timer per
+ * input; when the level has been stable for the debounce time the timer
+ * callback samples the pin and reports a change. Unchanged pins cost no
+ * CPU at all.
+ *
+ * The ring has a single producer: all GPIO interrupts are dispatched by
+ * the IDF GPIO ISR service on one core.
+ */
+class GpioInputService {
+public:
+    using Callback = void (*)(void* context, bool level, uint32_t timestamp_ms);
+
+    static constexpr size_t MAX_INPUTS = 16;
+    static constexpr size_t QUEUE_SIZE = 64;    // Power of two
+
+    explicit GpioInputService(uint32_t debounce_ms);
+    ~GpioInputService();
+
+    /**
+     * @brief Register an input pin (before start())
+     * @return Input index, or -1 if no slot is left
+     */
+    int add_input(gpio_num_t pin, bool pull_up);
+
+    esp_err_t start();
+    void stop();
+
+    bool is_running() const { return task_ != nullptr; }
+
+    /**
+     * @brief Debounced level of an input
+     */
+    bool level(int index) const;
+
+    /**
+     * @brief Set the change callback and debounce time of an input
+     * @param callback nullptr to unsubscribe; returns after any running callback
+     */
+    esp_err_t subscribe(int index, Callback callback, void* context, uint32_t debounce_ms);
+
+    uint32_t edges(int index) const;
+    uint32_t overflows() const { return overflows_.load(std::memory_order_relaxed); }
+
+private:
+    struct Edge {
+        uint8_t index;
+        uint8_t level;
+        uint32_t time_us;
+    };
+
+    struct Input {
+        GpioInputService* owner;
+        gpio_num_t pin;
+        bool pull_up;
+        uint8_t index;
+        esp_timer_handle_t timer;
+        uint32_t debounce_us;
+        std::atomic<uint32_t> last_edge_us; // Time of the latest edge
+
+        std::atomic<bool> level;            // Debounced level
+        std::atomic<uint32_t> edges;
+
+        Callback callback;                  // Guarded by callback_mutex_
+        void* context;
+    };
+
+    static void on_edge(void* arg);
+    static void on_debounce(void* arg);
+    static void task_entry(void* arg);
+    void task_loop();
+    void arm(Input& input);
+
+    uint32_t debounce_us_;
+    Input inputs_[MAX_INPUTS];
+    size_t input_count_ = 0;
+
+    // Lock-free single-producer ring: ISR writes head_, task writes tail_
+    Edge queue_[QUEUE_SIZE];
+    std::atomic<uint32_t> head_{0};
+    std::atomic<uint32_t> tail_{0};
+    std::atomic<uint32_t> overflows_{0};
+
+    TaskHandle_t task_ = nullptr;
+    SemaphoreHandle_t callback_mutex_ = nullptr;
+    bool isr_service_installed_ = false;
+};
@@ -67,8 +67,26 @@ public:
      * @return true якщо активний, false якщо неактивний
      */
     virtual bool get_state() = 0;
-    
-    // В майбутньому можна додати set_interrupt(), set_debounce() і т.д.
+
+    /**
+     * @brief Обробник зміни стану входу після антибрязкоту
+     *
+     * Викликається з задачі esp_timer, не з ISR. Має бути коротким.
+     */
+    using ChangeCallback = void (*)(void* context, bool state, uint32_t timestamp_ms);
+
+    /**
+     * @brief Підписатися на зміни стану (переривання по фронтах)
+     * @param callback Обробник, nullptr - відписатися
+     * @param context Аргумент обробника
+     * @param debounce_ms Час стабільного рівня для антибрязкоту
+     * @return ESP_OK, або ESP_ERR_NOT_SUPPORTED якщо вхід можна лише опитувати
+     *
+     * Після повернення з відписки обробник більше не викликається.
+     */
+    virtual esp_err_t subscribe(ChangeCallback callback, void* context, uint32_t debounce_ms) {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
 };
 
 /**
@@ -105,6 +123,38 @@ public:
     virtual HalResult<float> read_temperature(uint64_t address) = 0;
 };
 
+/**
+ * @brief Інтерфейс лічильника імпульсів (тахометр вентилятора, витратомір)
+ *
+ * Імпульси рахує апаратура, тож навантаження на CPU не залежить від
+ * частоти імпульсів.
+ */
+class IPulseCounter {
+public:
+    virtual ~IPulseCounter() = default;
+
+    /**
+     * @brief Загальна кількість імпульсів з моменту запуску або reset()
+     * @return Результат з кількістю імпульсів
+     */
+    virtual HalResult<uint64_t> get_count() = 0;
+
+    /**
+     * @brief Частота імпульсів, усереднена за вікно між викликами
+     *
+     * Вікно не коротше за налаштований мінімум; частіші виклики повертають
+     * останнє значення. До завершення першого вікна - ESP_ERR_NOT_FINISHED.
+     * @return Результат з частотою в Гц
+     */
+    virtual HalResult<float> get_frequency_hz() = 0;
+
+    /**
+     * @brief Обнулити загальну кількість імпульсів
+     * @return ESP_OK при успіху
+     */
+    virtual esp_err_t reset() = 0;
+};
+
 /**
  * @brief Інтерфейс для каналу АЦП
  */
@@ -123,4 +173,23 @@ public:
      * @return Результат з напругою в мВ
      */
     virtual HalResult<int> read_voltage_mv() = 0;
+    
+    /**
+     * @brief Повертає відфільтроване значення АЦП
+     * 
+     * Для каналів у безперервному режимі - останнє значення після
+     * оверсемплінгу і фільтра (дробова частина = додаткова роздільність),
+     * читання O(1) без звернення до АЦП.
+     * @return Результат у одиницях сирого 12-бітного значення
+     */
+    virtual HalResult<float> read_filtered() {
+        auto raw = read_raw();
+        return {static_cast<float>(raw.value), raw.error};
+    }
+    
+    /**
+     * @brief Чи оновлюється канал у фоні (безперервний режим з DMA)
+     * @return true якщо read_filtered() вже усереднене і не чекає АЦП
+     */
+    virtual bool is_continuous() const { return false; }
 };
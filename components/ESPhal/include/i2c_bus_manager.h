@@ -0,0 +1,101 @@
+/**
+ * @file i2c_bus_manager.h
+ * @brief Shared I2C bus with a transaction queue and bus recovery
+ */
+
+#pragma once
+
+#include "i2c_interfaces.h"
+#include <driver/gpio.h>
+#include <driver/i2c_master.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+
+/**
+ * @brief One I2C master bus served by its own task
+ *
+ * Drivers submit transactions to a FIFO queue through II2CDevice handles;
+ * the bus task runs them one after another, so callers never hold the bus
+ * and a slow sensor cannot stall another driver's task. A transaction may
+ * batch several transfers (e.g. register reads of an RTC and its status)
+ * that run without other devices in between.
+ *
+ * A transfer that times out usually means a slave holds SDA low after a
+ * reset in the middle of a byte. The bus is then cleared (SCL pulses until
+ * SDA is released, then a STOP) and the transfer retried once.
+ */
+class I2CBusManager : public II2CBus {
+public:
+    static constexpr size_t MAX_BATCH = 4;      // Transfers per transaction
+
+    I2CBusManager(int port, gpio_num_t scl_pin, gpio_num_t sda_pin, uint32_t frequency_hz,
+                  uint32_t timeout_ms, size_t queue_depth);
+    ~I2CBusManager() override;
+
+    /**
+     * @brief Create the master bus, queue and bus task
+     */
+    esp_err_t init();
+
+    // II2CBus interface implementation
+    II2CDevice* get_device(uint8_t device_addr, uint32_t speed_hz = 0) override;
+    esp_err_t write(uint8_t device_addr, const uint8_t* data, size_t len) override;
+    esp_err_t read(uint8_t device_addr, uint8_t* data, size_t len) override;
+    esp_err_t write_read(uint8_t device_addr, uint8_t reg_addr, uint8_t* data, size_t len) override;
+    std::vector<uint8_t> scan() override;
+
+    uint32_t transactions() const { return transactions_.load(std::memory_order_relaxed); }
+    uint32_t errors() const { return errors_.load(std::memory_order_relaxed); }
+    uint32_t recoveries() const { return recoveries_.load(std::memory_order_relaxed); }
+
+private:
+    class Device;
+
+    enum class Op : uint8_t {
+        TRANSFER,
+        PROBE,
+        STOP
+    };
+
+    struct Request {
+        Op op;
+        Device* device;
+        uint8_t address;                        // PROBE
+        uint8_t count;
+        I2CTransfer transfers[MAX_BATCH];
+        I2CCompletion callback;
+        void* context;
+    };
+
+    esp_err_t enqueue(const Request& request, TickType_t wait);
+    esp_err_t run_sync(Request& request);
+    esp_err_t execute(const Request& request);
+    esp_err_t run_transfer(Device& device, const I2CTransfer& transfer);
+    esp_err_t recover();
+    static void task_entry(void* arg);
+    void task_loop();
+
+    int port_;
+    gpio_num_t scl_pin_;
+    gpio_num_t sda_pin_;
+    uint32_t frequency_hz_;
+    uint32_t timeout_ms_;
+    size_t queue_depth_;
+
+    i2c_master_bus_handle_t bus_ = nullptr;
+    QueueHandle_t queue_ = nullptr;
+    TaskHandle_t task_ = nullptr;
+
+    // Device handles, shared by all drivers on the same address
+    SemaphoreHandle_t devices_mutex_ = nullptr;
+    std::unordered_map<uint8_t, std::unique_ptr<Device>> devices_;
+
+    std::atomic<uint32_t> transactions_{0};
+    std::atomic<uint32_t> errors_{0};
+    std::atomic<uint32_t> recoveries_{0};
+};
@@ -5,10 +5,90 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 #include "esp_err.h"
-#include "driver/i2c.h"
+
+/**
+ * @brief One segment of an I2C transaction
+ *
+ * tx only: write; rx only: read; both: write, repeated start, read
+ * (register read). Buffers must stay valid until the transaction completes.
+ */
+struct I2CTransfer {
+    const uint8_t* tx_data;
+    size_t tx_len;
+    uint8_t* rx_data;
+    size_t rx_len;
+};
+
+/**
+ * @brief Completion of an asynchronous I2C transaction
+ * @param context Pointer passed to submit()
+ * @param status ESP_OK, ESP_ERR_TIMEOUT after bus recovery failed, or the driver error
+ */
+using I2CCompletion = void (*)(void* context, esp_err_t status);
+
+/**
+ * @brief Handle of one device on a shared I2C bus
+ *
+ * Handles are owned by the bus and shared by every driver that talks to
+ * the same address. All transactions go through the bus queue, so drivers
+ * never block each other on the bus lock.
+ */
+class II2CDevice {
+public:
+    virtual ~II2CDevice() = default;
+
+    /**
+     * @brief 7-bit device address
+     */
+    virtual uint8_t address() const = 0;
+
+    /**
+     * @brief Queue a transaction and return immediately
+     *
+     * The transfers run back to back without other devices in between.
+     * The descriptors are copied; the data buffers are not.
+     * @param transfers Transaction segments
+     * @param count Number of segments (up to the bus batch limit)
+     * @param callback Called from the bus task when done
+     * @param context Argument of the callback
+     * @return ESP_OK if queued, ESP_ERR_NO_MEM if the queue is full
+     */
+    virtual esp_err_t submit(const I2CTransfer* transfers, size_t count,
+                             I2CCompletion callback, void* context) = 0;
+
+    /**
+     * @brief Queue a transaction and wait for its completion
+     * @return Transaction status; ESP_ERR_INVALID_STATE when called from a completion callback
+     */
+    virtual esp_err_t transfer(const I2CTransfer* transfers, size_t count) = 0;
+
+    esp_err_t write(const uint8_t* data, size_t len) {
+        I2CTransfer t = {data, len, nullptr, 0};
+        return transfer(&t, 1);
+    }
+
+    esp_err_t read(uint8_t* data, size_t len) {
+        I2CTransfer t = {nullptr, 0, data, len};
+        return transfer(&t, 1);
+    }
+
+    /**
+     * @brief Read consecutive registers starting at reg in one transaction
+     */
+    esp_err_t read_registers(uint8_t reg, uint8_t* data, size_t len) {
+        I2CTransfer t = {&reg, 1, data, len};
+        return transfer(&t, 1);
+    }
+
+    esp_err_t write_register(uint8_t reg, uint8_t value) {
+        uint8_t buffer[2] = {reg, value};
+        return write(buffer, sizeof(buffer));
+    }
+};
 
 /**
  * @brief I2C Bus interface
@@ -16,7 +96,16 @@
 class II2CBus {
 public:
     virtual ~II2CBus() = default;
-    
+
+    /**
+     * @brief Get the shared handle of a device on this bus
+     * @param device_addr 7-bit device address
+     * @param speed_hz SCL frequency for this device, 0 for the bus default.
+     *                 Only the first request for an address sets it.
+     * @return Device handle owned by the bus, or nullptr on error
+     */
+    virtual II2CDevice* get_device(uint8_t device_addr, uint32_t speed_hz = 0) = 0;
+
     /**
      * @brief Write data to I2C device
      * @param device_addr 7-bit device address
@@ -25,7 +114,7 @@ public:
      * @return ESP_OK on success
      */
     virtual esp_err_t write(uint8_t device_addr, const uint8_t* data, size_t len) = 0;
-    
+
     /**
      * @brief Read data from I2C device
      * @param device_addr 7-bit device address
@@ -34,7 +123,7 @@ public:
      * @return ESP_OK on success
      */
     virtual esp_err_t read(uint8_t device_addr, uint8_t* data, size_t len) = 0;
-    
+
     /**
      * @brief Write to register and read data
      * @param device_addr 7-bit device address
@@ -44,7 +133,7 @@ public:
      * @return ESP_OK on success
      */
     virtual esp_err_t write_read(uint8_t device_addr, uint8_t reg_addr, uint8_t* data, size_t len) = 0;
-    
+
     /**
      * @brief Scan I2C bus for devices
      * @return Vector of found device addresses
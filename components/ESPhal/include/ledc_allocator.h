@@ -0,0 +1,63 @@
+/**
+ * @file ledc_allocator.h
+ * @brief Allocation of LEDC channels and shared timers
+ */
+
+#pragma once
+
+#include <driver/ledc.h>
+#include <cstdint>
+#include "esp_err.h"
+
+/**
+ * @brief Owner of the LEDC low-speed channels and timers
+ *
+ * Channels that run at the same frequency and resolution share one timer,
+ * so e.g. four 25 kHz fans use a single timer. A request fails with
+ * ESP_ERR_NOT_FOUND when no channel is free or when a new frequency needs
+ * a timer and all timers are in use; nothing is reused silently.
+ *
+ * The hardware fade service is installed with the first channel, so
+ * drivers may use ledc_set_fade_with_time() and fade-end callbacks.
+ *
+ * Not thread-safe: channels are acquired during configuration.
+ */
+class LedcAllocator {
+public:
+    static constexpr ledc_mode_t SPEED_MODE = LEDC_LOW_SPEED_MODE;
+
+    struct Lease {
+        ledc_channel_t channel = LEDC_CHANNEL_MAX;
+        ledc_timer_t timer = LEDC_TIMER_MAX;
+    };
+
+    /**
+     * @brief Reserve a channel on a timer with the given settings
+     * @param frequency_hz PWM frequency
+     * @param resolution_bits Duty resolution
+     * @param lease Receives channel and timer
+     * @return ESP_OK, ESP_ERR_NOT_FOUND when exhausted, or the timer configuration error
+     */
+    esp_err_t acquire(uint32_t frequency_hz, uint8_t resolution_bits, Lease& lease);
+
+    /**
+     * @brief Return a channel; its timer is freed with the last channel
+     */
+    void release(const Lease& lease);
+
+    uint8_t free_channels() const;
+    uint8_t free_timers() const;
+
+private:
+    struct Timer {
+        uint32_t frequency_hz = 0;
+        uint8_t resolution_bits = 0;
+        uint8_t users = 0;              // 0 = free
+    };
+
+    esp_err_t acquire_timer(uint32_t frequency_hz, uint8_t resolution_bits, ledc_timer_t& timer);
+
+    uint32_t used_channels_ = 0;        // Bit per channel
+    Timer timers_[LEDC_TIMER_MAX];
+    bool fade_installed_ = false;
+};
@@ -37,7 +37,9 @@ private:
     gpio_num_t data_pin_;
     gpio_num_t power_pin_;
     
-    // Search state variables
+    static constexpr size_t MAX_SEARCH_DEVICES = 16;
+    
+    // Search state variables (kept between devices of one search)
     uint8_t last_discrepancy_ = 0;
     bool last_device_flag_ = false;
     uint8_t last_family_discrepancy_ = 0;
@@ -0,0 +1,84 @@
+/**
+ * @file onewire_rmt.h
+ * @brief OneWire bus for DS18B20 sensors driven by the RMT peripheral
+ */
+
+#pragma once
+
+#include "hal_interfaces.h"
+#include <soc/soc_caps.h>
+
+#if SOC_RMT_SUPPORTED
+
+#include <driver/gpio.h>
+#include <driver/rmt_tx.h>
+#include <driver/rmt_rx.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <vector>
+#include <cstdint>
+
+/**
+ * @brief Implementation of OneWire bus using ESP32 RMT TX/RX channels
+ *
+ * TX channel generates reset and time slots in open-drain mode, RX channel
+ * on the same pin (loop back) samples presence and read slots. Whole
+ * commands are queued as one transmission and read bytes are received in
+ * chunks of one RMT memory block, so the calling task sleeps on the
+ * transfer instead of spinning in ets_delay_us() with interrupts disabled.
+ */
+class OneWireRmtBus : public IOneWireBus {
+public:
+    /**
+     * @brief Constructor
+     * @param data_pin GPIO pin for OneWire data line
+     * @param power_pin GPIO pin for power (GPIO_NUM_NC if not used)
+     */
+    OneWireRmtBus(gpio_num_t data_pin, gpio_num_t power_pin = GPIO_NUM_NC);
+
+    /**
+     * @brief Destructor
+     */
+    virtual ~OneWireRmtBus();
+
+    /**
+     * @brief Allocate RMT channels and encoders
+     * @return ESP_OK on success, error if no free RMT channel
+     */
+    esp_err_t init();
+
+    // IOneWireBus interface implementation
+    std::vector<uint64_t> search_devices() override;
+    esp_err_t request_temperatures() override;
+    esp_err_t start_temperature_conversion(uint64_t address) override;
+    HalResult<float> read_temperature(uint64_t address) override;
+
+private:
+    gpio_num_t data_pin_;
+    gpio_num_t power_pin_;
+
+    rmt_channel_handle_t tx_channel_ = nullptr;
+    rmt_channel_handle_t rx_channel_ = nullptr;
+    rmt_encoder_handle_t bytes_encoder_ = nullptr;
+    rmt_encoder_handle_t copy_encoder_ = nullptr;
+    QueueHandle_t rx_queue_ = nullptr;
+    std::vector<rmt_symbol_word_t> rx_symbols_;
+
+    // Low-level OneWire protocol methods
+    bool reset();
+    esp_err_t write_bytes(const uint8_t* data, size_t len);
+    esp_err_t read_bytes(uint8_t* data, size_t len);
+    esp_err_t write_bit(bool bit);
+    esp_err_t read_bits(uint8_t* bits, size_t count);
+    esp_err_t select(uint64_t address);
+    bool search_device(uint8_t* address, int& last_discrepancy);
+
+    esp_err_t receive_slots(const void* tx_data, size_t tx_len, rmt_encoder_handle_t encoder,
+                            size_t expected_symbols, uint32_t range_max_ns, size_t& received);
+
+    static bool rx_done_callback(rmt_channel_handle_t channel,
+                                 const rmt_rx_done_event_data_t* edata, void* user_ctx);
+    static uint8_t crc8(const uint8_t* data, size_t len);
+};
+
+#endif // SOC_RMT_SUPPORTED
@@ -0,0 +1,70 @@
+/**
+ * @file pulse_counter_pcnt.h
+ * @brief Pulse counter input driven by the PCNT peripheral
+ */
+
+#pragma once
+
+#include "hal_interfaces.h"
+#include <soc/soc_caps.h>
+
+#if SOC_PCNT_SUPPORTED
+
+#include <driver/gpio.h>
+#include <driver/pulse_cnt.h>
+#include <cstdint>
+
+/**
+ * @brief Implementation of IPulseCounter using one PCNT unit
+ *
+ * Rising edges are counted in hardware with the glitch filter enabled.
+ * The unit accumulates across its 16-bit limits (one interrupt per 32767
+ * pulses), and the 32-bit driver count is extended to 64 bits on read.
+ * Frequency is the count difference over a gate window measured between
+ * reads, so nothing runs while the counter is not read.
+ */
+class PcntPulseCounter : public IPulseCounter {
+public:
+    /**
+     * @param pin Pulse input GPIO
+     * @param glitch_ns Pulses shorter than this are ignored (0 = no filter)
+     * @param pull_up Enable the internal pull-up (open collector outputs)
+     * @param gate_ms Minimum frequency measurement window
+     */
+    PcntPulseCounter(gpio_num_t pin, uint32_t glitch_ns, bool pull_up, uint32_t gate_ms);
+    ~PcntPulseCounter() override;
+
+    /**
+     * @brief Allocate and start the PCNT unit
+     * @return ESP_OK on success, ESP_ERR_NOT_FOUND if no PCNT unit is free
+     */
+    esp_err_t init();
+
+    // IPulseCounter interface implementation
+    HalResult<uint64_t> get_count() override;
+    HalResult<float> get_frequency_hz() override;
+    esp_err_t reset() override;
+
+private:
+    esp_err_t update_count();
+
+    gpio_num_t pin_;
+    uint32_t glitch_ns_;
+    bool pull_up_;
+    uint32_t gate_us_;
+
+    pcnt_unit_handle_t unit_ = nullptr;
+    pcnt_channel_handle_t channel_ = nullptr;
+
+    // 64-bit extension of the accumulated driver count
+    int last_raw_ = 0;
+    uint64_t total_ = 0;
+
+    // Frequency gate
+    uint64_t gate_count_ = 0;
+    int64_t gate_start_us_ = 0;
+    float frequency_hz_ = 0.0f;
+    bool has_frequency_ = false;
+};
+
+#endif // SOC_PCNT_SUPPORTED
@@ -0,0 +1,90 @@
+/**
+ * @file sim_hal.h
+ * @brief Simulated HAL backend driven by the cold room plant model
+ *
+ * With CONFIG_ESPHAL_SIMULATION ESPhal creates these drivers instead of
+ * real GPIO, OneWire and ADC ones. Outputs drive the plant inputs, inputs
+ * and sensors read the plant state. Plant time runs at a configurable
+ * multiple of the clock, so hours of cold room behaviour pass in minutes.
+ */
+
+#pragma once
+
+#include "hal_interfaces.h"
+#include "sim_plant.h"
+#include <memory>
+#include <mutex>
+
+/**
+ * @brief Shared simulation context: plant, clock and driver factory
+ *
+ * Drivers are bound to plant signals by their hal_id:
+ * - outputs: "COMPRESSOR", "EVAP"+"FAN", "DEFROST"/"HEATER"
+ * - inputs: "DOOR"
+ * - OneWire buses and ADC channels: "EVAP", "PRODUCT", "AMBIENT", else room air
+ * - pulse inputs: "COND"+"FAN" follows the compressor, other "FAN" the
+ *   evaporator fan (2 pulses per revolution at 1400 rpm)
+ * Unbound outputs and inputs behave as plain latches.
+ */
+class SimHal {
+public:
+    /**
+     * @brief Clock source in microseconds
+     */
+    using ClockFn = int64_t (*)();
+
+    static SimHal& instance();
+
+    /**
+     * @brief Advance the plant to the current clock
+     */
+    void sync();
+
+    /**
+     * @brief Run a function on the plant under the simulation lock
+     */
+    template <typename Fn>
+    void with_plant(Fn&& fn) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        fn(plant_);
+    }
+
+    float temperature(ColdRoomPlant::Probe probe);
+
+    /**
+     * @brief Simulated seconds per clock second
+     */
+    void set_time_scale(uint32_t scale) { time_scale_ = scale; }
+    uint32_t time_scale() const { return time_scale_; }
+
+    /**
+     * @brief Replace the clock (host tests drive time explicitly)
+     */
+    void set_clock(ClockFn clock);
+
+    /**
+     * @brief Current clock time in microseconds (not scaled)
+     */
+    int64_t clock_us() const { return clock_(); }
+
+    // Driver factory
+    std::unique_ptr<IGpioOutput> create_gpio_output(const char* hal_id);
+    std::unique_ptr<IGpioInput> create_gpio_input(const char* hal_id);
+    std::unique_ptr<IOneWireBus> create_onewire_bus(const char* hal_id);
+    std::unique_ptr<IAdcChannel> create_adc_channel(const char* hal_id);
+    std::unique_ptr<IPulseCounter> create_pulse_counter(const char* hal_id);
+
+    /**
+     * @brief Derive a stable DS18B20 ROM address (family 0x28, valid CRC)
+     */
+    static uint64_t make_rom_address(const char* seed);
+
+private:
+    SimHal();
+
+    ColdRoomPlant plant_;
+    std::mutex mutex_;
+    ClockFn clock_;
+    int64_t last_clock_us_ = -1;
+    uint32_t time_scale_ = 1;
+};
@@ -0,0 +1,105 @@
+/**
+ * @file sim_plant.h
+ * @brief Lumped thermal model of a cold room for the simulated HAL
+ *
+ * Pure C++ (no ESP-IDF dependencies), so the same model drives the
+ * simulated HAL on the target and host-side tests.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Cold room with compressor, evaporator fan, defrost heater and door
+ *
+ * Four heat capacities (room air, evaporator coil, product, frost on the
+ * coil) are integrated with explicit Euler steps of at most one second.
+ * The model is deterministic: the same inputs and step sequence give the
+ * same trajectory.
+ */
+class ColdRoomPlant {
+public:
+    /**
+     * @brief Temperature probe locations
+     */
+    enum class Probe : uint8_t {
+        AIR,
+        EVAPORATOR,
+        PRODUCT,
+        AMBIENT
+    };
+
+    /**
+     * @brief Actuators and disturbances
+     */
+    struct Inputs {
+        bool compressor = false;
+        bool evaporator_fan = false;
+        bool defrost_heater = false;
+        bool door_open = false;
+    };
+
+    /**
+     * @brief Physical parameters (SI units, temperatures in °C)
+     */
+    struct Params {
+        float ambient_c = 25.0f;
+        float air_capacity_j_k = 60000.0f;          // Room air and shelving
+        float evaporator_capacity_j_k = 8000.0f;    // Coil and fins
+        float product_capacity_j_k = 400000.0f;     // Stored product
+        float wall_ua_w_k = 25.0f;                  // Insulation losses
+        float door_ua_w_k = 250.0f;                 // Extra exchange with open door
+        float coil_ua_fan_w_k = 180.0f;             // Coil to air, fan running
+        float coil_ua_still_w_k = 25.0f;            // Coil to air, natural convection
+        float product_ua_w_k = 40.0f;               // Product to air
+        float compressor_w = 1800.0f;               // Cooling capacity at -10 °C coil
+        float compressor_slope = 0.03f;             // Capacity change per K of coil temperature
+        float fan_w = 60.0f;                        // Fan motor heat
+        float heater_w = 1500.0f;                   // Defrost heater
+        float frost_rate_kg_s = 2.0e-6f;            // Frost build-up on a cold coil
+        float frost_door_factor = 8.0f;             // Moisture from an open door
+        float frost_latent_j_kg = 334000.0f;        // Heat to melt frost
+    };
+
+    ColdRoomPlant();
+    explicit ColdRoomPlant(const Params& params);
+
+    /**
+     * @brief Advance the model
+     * @param dt_s Simulated time step in seconds
+     */
+    void step(float dt_s);
+
+    Inputs& inputs() { return inputs_; }
+    const Inputs& inputs() const { return inputs_; }
+    Params& params() { return params_; }
+
+    float temperature(Probe probe) const;
+    float frost_kg() const { return frost_kg_; }
+    double time_s() const { return time_s_; }
+
+    /**
+     * @brief Total compressor run time in simulated seconds
+     */
+    double compressor_runtime_s() const { return compressor_runtime_s_; }
+
+    /**
+     * @brief Reset to thermal equilibrium with the ambient
+     */
+    void reset();
+
+private:
+    void integrate(float dt_s);
+
+    Params params_;
+    Inputs inputs_;
+
+    float air_c_;
+    float evaporator_c_;
+    float product_c_;
+    float frost_kg_ = 0.0f;
+
+    double time_s_ = 0.0;
+    double compressor_runtime_s_ = 0.0;
+};
@@ -10,8 +10,11 @@
  * - Dynamic driver loading through registry
  * - Type-agnostic actuator management  
  * - Configuration-driven actuator creation
- * - Command routing from SharedState
- * - Status feedback to SharedState
+ * - Typed commands through lock-free per-actuator mailboxes
+ * - JSON command adapter for SharedState and external APIs
+ * - Change-driven status feedback to SharedState
+ * - Board-wide staggering of relay switch-on (SwitchingScheduler)
+ * - Runtime, start and duty-cycle accounting for maintenance
  */
 
 #pragma once
@@ -20,11 +23,15 @@
 #include "esphal.h"
 #include "shared_state.h"
 #include "actuator_driver_interface.h"
+#include "actuator_command_mailbox.h"
+#include "actuator_usage.h"
 #include "nlohmann/json.hpp"
 #include <vector>
 #include <memory>
+#include <optional>
 #include <string>
 #include <functional>
+#include <mutex>
 
 /**
  * @brief Configuration for a single actuator instance
@@ -77,11 +84,13 @@ public:
     void configure(const nlohmann::json& config) override;
     bool is_healthy() const override;
     uint8_t get_health_score() const override;
-    uint32_t get_max_update_time_us() const override;    
+    uint32_t get_max_update_time_us() const override;
+    void register_rpc(IJsonRpcRegistrar& rpc) override;
+    
     // === ActuatorModule specific methods ===
     
     /**
-     * @brief Get actuator status by role
+     * @brief Get the last published actuator status by role
      * @param role Actuator role (e.g., "compressor")
      * @return Status or nullopt if actuator not found
      */
@@ -95,9 +104,30 @@ public:
     std::optional<ActuatorConfig> get_actuator_config(const std::string& role) const;
     
     /**
-     * @brief Execute command immediately (bypass SharedState)
+     * @brief Resolve an actuator role to its index (once, at setup)
      * @param role Actuator role
-     * @param command Command to execute
+     * @return Index for post_command(), or -1 if not found
+     */
+    int find_actuator(const std::string& role) const;
+    
+    /**
+     * @brief Queue a typed command (any task, lock-free)
+     * 
+     * Applied at the start of the next update() in arrival order; a run
+     * of consecutive setpoints in one cycle collapses to the last one,
+     * STOP, TOGGLE and BLINK always execute. No JSON, event or string
+     * lookup on this path.
+     * 
+     * @param index Index from find_actuator()
+     * @param command Command to queue
+     * @return ESP_OK, ESP_ERR_NOT_FOUND for a bad index, ESP_ERR_NO_MEM if the mailbox is full
+     */
+    esp_err_t post_command(int index, const ActuatorCommand& command);
+    
+    /**
+     * @brief Execute JSON command immediately (adapter for external APIs)
+     * @param role Actuator role
+     * @param command Command in a form accepted by actuator_command_from_json()
      * @return ESP_OK on success
      */
     esp_err_t execute_command(const std::string& role, const nlohmann::json& command);
@@ -108,6 +138,23 @@ public:
      */
     esp_err_t emergency_stop_all();
     
+    /**
+     * @brief Get the pending relay switch-on queue and its timing statistics
+     * @return SwitchingScheduler diagnostics
+     */
+    nlohmann::json get_switching_diagnostics() const;
+    
+    /**
+     * @brief Get usage counters by role
+     * 
+     * Lifetime starts and runtime, starts and duty cycle over the last
+     * hour and day, worst starts per hour.
+     * 
+     * @param role Actuator role
+     * @return Usage or nullopt if actuator not found
+     */
+    std::optional<nlohmann::json> get_usage(const std::string& role);
+    
     /**
      * @brief Get available actuator driver types
      * @return List of registered driver type identifiers
@@ -119,9 +166,21 @@ private:
     struct ActuatorInstance {
         std::unique_ptr<IActuatorDriver> driver;
         ActuatorConfig config;
-        std::string subscription_id;     // SharedState subscription ID
+        SharedState::SubscriptionHandle subscription_id = 0;  // 0 = not subscribed
+        std::unique_ptr<ActuatorCommandMailbox> mailbox;
         uint32_t command_count = 0;
         uint32_t error_count = 0;
+        uint32_t last_latency_us = 0;    // Post to execution of the last command
+        uint32_t max_latency_us = 0;
+        
+        // Last published status; republished when the driver's version
+        // moves, after a command, or on the keep-alive interval
+        ActuatorStatus status;
+        uint32_t status_version = 0;
+        bool status_dirty = true;
+        uint64_t last_publish_ms = 0;
+        
+        ActuatorUsage usage;             // Guarded by usage_mutex_
     };    
     // Reference to HAL for hardware access
     ESPhal& hal_;
@@ -138,12 +197,26 @@ private:
     // Configuration
     uint32_t update_interval_ms_ = 100;  // Update interval for time-based drivers
     bool publish_on_error_ = true;       // Publish error states
+    uint32_t status_keepalive_ms_ = 30000;  // Republish unchanged status
+    uint32_t usage_publish_interval_s_ = 60;
+    uint32_t usage_persist_interval_s_ = 900;  // Flash write at most this often
+    
+    // Usage accounting, read by RPC from another task
+    static constexpr const char* USAGE_PATH = "/storage/actuator_usage.dat";
+    static constexpr const char* USAGE_KEY = "state.actuator.usage";
+    std::mutex usage_mutex_;
+    std::vector<ActuatorUsageRecord> orphan_usage_;  // Roles not configured now
+    uint64_t last_usage_publish_ms_ = 0;
+    uint64_t last_usage_persist_ms_ = 0;
     
     // Helper methods
     esp_err_t create_actuator_from_config(const nlohmann::json& actuator_config);
-    void handle_command(const std::string& role, const nlohmann::json& value);
-    void publish_actuator_status(const ActuatorInstance& actuator);
+    void handle_command(size_t index, const nlohmann::json& value);
+    esp_err_t apply_command(ActuatorInstance& actuator, const ActuatorCommand& command);
+    void publish_actuator_status(ActuatorInstance& actuator, uint64_t now_ms);
+    uint64_t get_time_ms() const;
+    void load_usage();
+    esp_err_t persist_usage();
+    void publish_usage(uint64_t now_ms);
     std::unique_ptr<IActuatorDriver> create_driver(const std::string& type);
-};
-
-#endif // ACTUATOR_MODULE_H
\ No newline at end of file
+};
\ No newline at end of file
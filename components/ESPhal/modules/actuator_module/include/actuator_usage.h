@@ -0,0 +1,107 @@
+/**
+ * @file actuator_usage.h
+ * @brief Runtime, start and duty-cycle accounting of one actuator
+ *
+ * Feeds predictive maintenance: compressor starts per hour, contact
+ * cycles of relays and running hours, without scanning logs.
+ */
+
+#pragma once
+
+#include "nlohmann/json.hpp"
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Persisted part of the accounting (lifetime totals)
+ */
+struct ActuatorUsageRecord {
+    static constexpr size_t ROLE_LEN = 24;
+
+    char role[ROLE_LEN];
+    uint32_t starts;                // OFF->ON transitions (relay contact cycles)
+    uint32_t runtime_s;             // Cumulative active time
+    uint32_t max_starts_per_hour;   // Worst rolling hour seen
+} __attribute__((packed));
+
+/**
+ * @brief Usage counters of one actuator
+ *
+ * record() is called with the current active state whenever the status
+ * changes and on the keep-alive, so the cost is O(1) per transition.
+ * Rolling windows are rings of fixed slots: twelve 5-minute slots for the
+ * last hour and twenty-four 1-hour slots for the last day. Windows count
+ * from boot; only the lifetime totals are persisted.
+ */
+class ActuatorUsage {
+public:
+    /**
+     * @brief Account elapsed time and a possible transition
+     * @param active Current active state
+     * @param now_ms Monotonic time
+     */
+    void record(bool active, uint64_t now_ms);
+
+    /**
+     * @brief Load lifetime totals (windows stay empty)
+     */
+    void restore(const ActuatorUsageRecord& record);
+
+    /**
+     * @brief Store lifetime totals under the role name
+     */
+    void fill(ActuatorUsageRecord& record, const std::string& role) const;
+
+    /**
+     * @brief Clear all counters (after maintenance)
+     */
+    void reset(uint64_t now_ms);
+
+    /**
+     * @brief Totals and rolling windows up to now_ms
+     */
+    nlohmann::json to_json(uint64_t now_ms);
+
+    bool is_dirty() const { return dirty_; }
+    void clear_dirty() { dirty_ = false; }
+
+private:
+    /**
+     * @brief Ring of equal time slots; a slot is cleared when time re-enters it
+     */
+    template <size_t SLOTS, uint32_t SLOT_MS>
+    struct Window {
+        uint32_t on_ms[SLOTS] = {};
+        uint16_t starts[SLOTS] = {};
+        uint64_t slot_index = 0;        // Absolute index of the current slot
+
+        void advance(uint64_t now_ms);
+        void add_on_time(uint64_t from_ms, uint64_t to_ms);
+        void add_start(uint64_t now_ms);
+        uint32_t total_on_ms() const;
+        uint32_t total_starts() const;
+        
+        // Current slot is partial: the window spans SLOTS-1 full slots plus it
+        static uint32_t span_ms(uint64_t now_ms) {
+            return (SLOTS - 1) * SLOT_MS + static_cast<uint32_t>(now_ms % SLOT_MS);
+        }
+    };
+
+    static constexpr uint32_t FIVE_MINUTES_MS = 5 * 60 * 1000;
+    static constexpr uint32_t HOUR_MS = 60 * 60 * 1000;
+
+    uint32_t covered_ms(uint64_t now_ms, uint32_t span_ms) const;
+
+    bool active_ = false;
+    bool tracking_ = false;             // First record() seen
+    uint64_t last_ms_ = 0;
+    uint64_t tracking_since_ms_ = 0;
+
+    uint32_t starts_ = 0;
+    uint64_t runtime_ms_ = 0;
+    uint32_t max_starts_per_hour_ = 0;
+    bool dirty_ = false;
+
+    Window<12, FIVE_MINUTES_MS> hour_;
+    Window<24, HOUR_MS> day_;
+};
@@ -8,14 +8,29 @@
 
 #include "actuator_module.h"
 #include "actuator_driver_registry.h"
+#include "switching_scheduler.h"
 #include "shared_state.h"
 #include "event_bus.h"
+#include "json_rpc_interface.h"
 #include <esp_log.h>
 #include <esp_timer.h>
 #include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <unistd.h>
 
 static const char* TAG = "ActuatorModule";
 
+// Usage file: header followed by one record per role
+struct UsageFileHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t count;
+} __attribute__((packed));
+
+static constexpr uint32_t USAGE_MAGIC = 0x47535541;  // "AUSG"
+static constexpr uint16_t USAGE_VERSION = 1;
+
 // === ActuatorModule implementation ===
 
 ActuatorModule::ActuatorModule(ESPhal& hal) 
@@ -49,9 +64,12 @@ esp_err_t ActuatorModule::init() {
 void ActuatorModule::configure(const nlohmann::json& config) {
     ESP_LOGI(TAG, "Configuring ActuatorModule");
     
+    // Keep usage of the actuators about to be replaced
+    persist_usage();
+    
     // Clear existing actuators
     for (auto& actuator : actuators_) {
-        if (!actuator.subscription_id.empty()) {
+        if (actuator.subscription_id != 0) {
             SharedState::unsubscribe(actuator.subscription_id);
         }
     }
@@ -65,6 +83,19 @@ void ActuatorModule::configure(const nlohmann::json& config) {
     
     if (config.contains("publish_on_error")) {
         publish_on_error_ = config["publish_on_error"].get<bool>();
+    }
+    
+    if (config.contains("status_keepalive_ms")) {
+        status_keepalive_ms_ = config["status_keepalive_ms"].get<uint32_t>();
+    }
+    
+    usage_publish_interval_s_ = config.value("usage_publish_interval_s", usage_publish_interval_s_);
+    usage_persist_interval_s_ = config.value("usage_persist_interval_s", usage_persist_interval_s_);
+    
+    // Before the relays register: the startup hold counts from here
+    if (SwitchingScheduler::instance().configure(
+            config.value("switching", nlohmann::json::object()), get_time_ms()) != ESP_OK) {
+        ESP_LOGE(TAG, "Invalid switching settings, using defaults");
     }    
     // Create actuators from configuration
     if (config.contains("actuators")) {
@@ -78,6 +109,8 @@ void ActuatorModule::configure(const nlohmann::json& config) {
         }
     }
     
+    load_usage();
+    
     ESP_LOGI(TAG, "Configured %zu actuators", actuators_.size());
 }
 
@@ -113,19 +146,20 @@ esp_err_t ActuatorModule::create_actuator_from_config(const nlohmann::json& actu
         ActuatorInstance instance;
         instance.driver = std::move(driver);
         instance.config = config;
+        instance.mailbox = std::make_unique<ActuatorCommandMailbox>();
         
-        // Subscribe to command key
+        // Subscribe to command key - JSON commands are parsed once and queued
         instance.subscription_id = SharedState::subscribe(
             config.command_key,
-            [this, role = config.role](const std::string& key, const nlohmann::json& value) {
-                this->handle_command(role, value);
+            [this, index = actuators_.size()](const std::string& key, const nlohmann::json& value) {
+                this->handle_command(index, value);
             }
         );
         
         actuators_.push_back(std::move(instance));
         
         // Publish initial status
-        publish_actuator_status(actuators_.back());
+        publish_actuator_status(actuators_.back(), get_time_ms());
         
         ESP_LOGI(TAG, "Actuator created successfully: %s", config.role.c_str());
         return ESP_OK;
@@ -138,34 +172,22 @@ esp_err_t ActuatorModule::create_actuator_from_config(const nlohmann::json& actu
         return ESP_FAIL;
     }
 }
-void ActuatorModule::handle_command(const std::string& role, const nlohmann::json& value) {
-    // Find actuator by role
-    auto it = std::find_if(actuators_.begin(), actuators_.end(),
-        [&role](const ActuatorInstance& actuator) {
-            return actuator.config.role == role;
-        });
+void ActuatorModule::handle_command(size_t index, const nlohmann::json& value) {
+    const std::string& role = actuators_[index].config.role;
     
-    if (it == actuators_.end()) {
-        ESP_LOGE(TAG, "Actuator not found: %s", role.c_str());
-        return;
+    ActuatorCommand command;
+    esp_err_t ret = actuator_command_from_json(value, command);
+    if (ret == ESP_OK) {
+        ret = post_command(index, command);
     }
     
-    // Execute command
-    esp_err_t ret = it->driver->execute_command(value);
-    it->command_count++;
-    total_commands_++;
-    
     if (ret != ESP_OK) {
-        it->error_count++;
+        actuators_[index].error_count++;
         total_errors_++;
-        ESP_LOGE(TAG, "Command execution failed for %s: %s", 
-                 role.c_str(), esp_err_to_name(ret));
+        ESP_LOGE(TAG, "Command rejected for %s: %s", role.c_str(), esp_err_to_name(ret));
     }
     
-    // Publish updated status
-    publish_actuator_status(*it);
-    
-    // Publish event
+    // External API path: keep the JSON event for observers
     nlohmann::json event_data = {
         {"role", role},
         {"command", value},
@@ -174,41 +196,107 @@ void ActuatorModule::handle_command(const std::string& role, const nlohmann::jso
     EventBus::publish("actuator.command", event_data);
 }
 
+int ActuatorModule::find_actuator(const std::string& role) const {
+    for (size_t i = 0; i < actuators_.size(); i++) {
+        if (actuators_[i].config.role == role) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+esp_err_t ActuatorModule::post_command(int index, const ActuatorCommand& command) {
+    if (index < 0 || index >= static_cast<int>(actuators_.size())) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    
+    ActuatorCommand stamped = command;
+    if (stamped.issued_us == 0) {
+        stamped.issued_us = static_cast<uint32_t>(esp_timer_get_time());
+    }
+    return actuators_[index].mailbox->post(stamped) ? ESP_OK : ESP_ERR_NO_MEM;
+}
+
+esp_err_t ActuatorModule::apply_command(ActuatorInstance& actuator, const ActuatorCommand& command) {
+    esp_err_t ret = actuator.driver->execute(command);
+    actuator.command_count++;
+    total_commands_++;
+    
+    uint32_t latency_us = static_cast<uint32_t>(esp_timer_get_time()) - command.issued_us;
+    actuator.last_latency_us = latency_us;
+    actuator.max_latency_us = std::max(actuator.max_latency_us, latency_us);
+    
+    if (ret != ESP_OK) {
+        actuator.error_count++;
+        total_errors_++;
+        ESP_LOGE(TAG, "Command execution failed for %s: %s", 
+                 actuator.config.role.c_str(), esp_err_to_name(ret));
+    }
+    
+    // Counters and latency changed; published on the next update
+    actuator.status_dirty = true;
+    return ret;
+}
+
 void ActuatorModule::update() {
     if (!initialized_) {
         return;
     }
     
     update_count_++;
+    uint64_t now_ms = get_time_ms();
     
-    // Update all actuators (allows time-based operations like ramping)
     for (auto& actuator : actuators_) {
-        try {
-            actuator.driver->update();
-            
-            // Periodically publish status
-            if (update_count_ % (1000 / update_interval_ms_) == 0) {
-                publish_actuator_status(actuator);
-            }
-            
-        } catch (const std::exception& e) {
-            ESP_LOGE(TAG, "Exception updating actuator %s: %s", 
-                     actuator.config.role.c_str(), e.what());
-            actuator.error_count++;
-            total_errors_++;
+        // Queued commands in order, then time-based operations like ramping.
+        // Bounded so producers that keep posting cannot starve the loop.
+        ActuatorCommand command;
+        for (uint32_t i = 0; i < ActuatorCommandMailbox::CAPACITY &&
+                             actuator.mailbox->take_next(command); i++) {
+            apply_command(actuator, command);
         }
+        
+        actuator.driver->update();
+        
+        // Publish on change, otherwise only as a slow keep-alive
+        if (actuator.status_dirty ||
+            actuator.driver->get_status_version() != actuator.status_version ||
+            now_ms - actuator.last_publish_ms >= status_keepalive_ms_) {
+            publish_actuator_status(actuator, now_ms);
+        }
+    }
+    
+    if (now_ms - last_usage_publish_ms_ >= usage_publish_interval_s_ * 1000ULL) {
+        publish_usage(now_ms);
+    }
+    
+    // Batched: one file write per interval, only if a counter moved
+    if (now_ms - last_usage_persist_ms_ >= usage_persist_interval_s_ * 1000ULL) {
+        last_usage_persist_ms_ = now_ms;
+        persist_usage();
     }
 }
-void ActuatorModule::publish_actuator_status(const ActuatorInstance& actuator) {
-    // Get current status from driver
-    ActuatorStatus status = actuator.driver->get_status();
+
+void ActuatorModule::publish_actuator_status(ActuatorInstance& actuator, uint64_t now_ms) {
+    // Version first: a change racing the snapshot is published next cycle
+    actuator.status_version = actuator.driver->get_status_version();
+    actuator.status = actuator.driver->get_status();
+    actuator.status_dirty = false;
+    actuator.last_publish_ms = now_ms;
+    
+    // Every active-state change bumps the version, so transitions land here
+    {
+        std::lock_guard<std::mutex> lock(usage_mutex_);
+        actuator.usage.record(actuator.status.is_active, now_ms);
+    }
     
     // Add metadata
-    nlohmann::json status_json = status.to_json();
+    nlohmann::json status_json = actuator.status.to_json();
     status_json["role"] = actuator.config.role;
     status_json["type"] = actuator.config.type;
     status_json["command_count"] = actuator.command_count;
     status_json["error_count"] = actuator.error_count;
+    status_json["command_latency_us"] = actuator.last_latency_us;
+    status_json["max_command_latency_us"] = actuator.max_latency_us;
     
     // Publish to SharedState
     SharedState::set(actuator.config.status_key, status_json);
@@ -219,10 +307,11 @@ void ActuatorModule::stop() {
     
     // Emergency stop all actuators
     emergency_stop_all();
+    persist_usage();
     
     // Unsubscribe from SharedState
     for (auto& actuator : actuators_) {
-        if (!actuator.subscription_id.empty()) {
+        if (actuator.subscription_id != 0) {
             SharedState::unsubscribe(actuator.subscription_id);
         }
     }
@@ -276,7 +365,7 @@ std::optional<ActuatorStatus> ActuatorModule::get_actuator_status(const std::str
         });
     
     if (it != actuators_.end()) {
-        return it->driver->get_status();
+        return it->status;
     }
     
     return std::nullopt;
@@ -295,32 +384,23 @@ std::optional<ActuatorConfig> ActuatorModule::get_actuator_config(const std::str
     return std::nullopt;
 }
 esp_err_t ActuatorModule::execute_command(const std::string& role, const nlohmann::json& command) {
-    auto it = std::find_if(actuators_.begin(), actuators_.end(),
-        [&role](const ActuatorInstance& actuator) {
-            return actuator.config.role == role;
-        });
-    
-    if (it == actuators_.end()) {
+    int index = find_actuator(role);
+    if (index < 0) {
         ESP_LOGE(TAG, "Actuator not found: %s", role.c_str());
         return ESP_ERR_NOT_FOUND;
     }
     
-    // Execute command directly
-    esp_err_t ret = it->driver->execute_command(command);
-    
-    // Update statistics
-    it->command_count++;
-    total_commands_++;
-    
+    ActuatorCommand typed;
+    esp_err_t ret = actuator_command_from_json(command, typed);
     if (ret != ESP_OK) {
-        it->error_count++;
+        actuators_[index].error_count++;
         total_errors_++;
+        return ret;
     }
     
-    // Publish updated status
-    publish_actuator_status(*it);
-    
-    return ret;
+    // Execute command directly
+    typed.issued_us = static_cast<uint32_t>(esp_timer_get_time());
+    return apply_command(actuators_[index], typed);
 }
 
 esp_err_t ActuatorModule::emergency_stop_all() {
@@ -337,7 +417,7 @@ esp_err_t ActuatorModule::emergency_stop_all() {
         }
         
         // Publish status after emergency stop
-        publish_actuator_status(actuator);
+        publish_actuator_status(actuator, get_time_ms());
     }
     
     // Publish event
@@ -346,6 +426,180 @@ esp_err_t ActuatorModule::emergency_stop_all() {
     return overall_result;
 }
 
+std::optional<nlohmann::json> ActuatorModule::get_usage(const std::string& role) {
+    int index = find_actuator(role);
+    if (index < 0) {
+        return std::nullopt;
+    }
+    
+    std::lock_guard<std::mutex> lock(usage_mutex_);
+    nlohmann::json usage = actuators_[index].usage.to_json(get_time_ms());
+    usage["role"] = role;
+    return usage;
+}
+
+void ActuatorModule::register_rpc(IJsonRpcRegistrar& rpc) {
+    rpc.register_method("actuator.usage",
+        [this](const nlohmann::json& params, nlohmann::json& result) -> esp_err_t {
+            if (params.contains("role")) {
+                auto usage = get_usage(params.value("role", ""));
+                if (!usage) {
+                    return ESP_ERR_NOT_FOUND;
+                }
+                result = *usage;
+                return ESP_OK;
+            }
+            
+            result = nlohmann::json::object();
+            uint64_t now_ms = get_time_ms();
+            std::lock_guard<std::mutex> lock(usage_mutex_);
+            for (auto& actuator : actuators_) {
+                result[actuator.config.role] = actuator.usage.to_json(now_ms);
+            }
+            return ESP_OK;
+        },
+        "Actuator starts, runtime and duty cycle: {role?}");
+    
+    rpc.register_method("actuator.reset_usage",
+        [this](const nlohmann::json& params, nlohmann::json& result) -> esp_err_t {
+            int index = find_actuator(params.value("role", ""));
+            if (index < 0) {
+                return ESP_ERR_NOT_FOUND;
+            }
+            {
+                std::lock_guard<std::mutex> lock(usage_mutex_);
+                actuators_[index].usage.reset(get_time_ms());
+            }
+            result["role"] = actuators_[index].config.role;
+            return persist_usage();
+        },
+        "Clear usage counters after maintenance: {role}");
+}
+
+nlohmann::json ActuatorModule::get_switching_diagnostics() const {
+    return SwitchingScheduler::instance().get_diagnostics(get_time_ms());
+}
+
 std::vector<std::string> ActuatorModule::get_available_drivers() const {
     return ActuatorDriverRegistry::instance().get_registered_types();
-}
\ No newline at end of file
+}
+
+uint64_t ActuatorModule::get_time_ms() const {
+    return esp_timer_get_time() / 1000;
+}
+
+void ActuatorModule::load_usage() {
+    orphan_usage_.clear();
+    
+    FILE* file = fopen(USAGE_PATH, "rb");
+    if (!file) {
+        ESP_LOGI(TAG, "No usage file, counters start at zero");
+        return;
+    }
+    
+    UsageFileHeader header = {};
+    if (fread(&header, sizeof(header), 1, file) != 1 ||
+        header.magic != USAGE_MAGIC || header.version != USAGE_VERSION) {
+        ESP_LOGW(TAG, "Usage file not recognized, ignoring");
+        fclose(file);
+        return;
+    }
+    
+    std::lock_guard<std::mutex> lock(usage_mutex_);
+    size_t restored = 0;
+    ActuatorUsageRecord record;
+    for (uint16_t i = 0; i < header.count && fread(&record, sizeof(record), 1, file) == 1; i++) {
+        record.role[ActuatorUsageRecord::ROLE_LEN - 1] = '\0';
+        int index = find_actuator(record.role);
+        if (index >= 0) {
+            actuators_[index].usage.restore(record);
+            restored++;
+        } else {
+            orphan_usage_.push_back(record);
+        }
+    }
+    fclose(file);
+    
+    ESP_LOGI(TAG, "Usage restored for %zu actuators (%zu unused records kept)", 
+             restored, orphan_usage_.size());
+}
+
+esp_err_t ActuatorModule::persist_usage() {
+    std::vector<ActuatorUsageRecord> records;
+    {
+        std::lock_guard<std::mutex> lock(usage_mutex_);
+        bool dirty = false;
+        for (const auto& actuator : actuators_) {
+            dirty |= actuator.usage.is_dirty();
+        }
+        if (!dirty) {
+            return ESP_OK;
+        }
+        
+        records.reserve(actuators_.size() + orphan_usage_.size());
+        for (auto& actuator : actuators_) {
+            ActuatorUsageRecord record;
+            actuator.usage.fill(record, actuator.config.role);
+            records.push_back(record);
+        }
+        records.insert(records.end(), orphan_usage_.begin(), orphan_usage_.end());
+    }
+    
+    // Whole table in one write to a temporary file, then rename: a power
+    // loss leaves either the old or the new table
+    std::string temp_path = std::string(USAGE_PATH) + ".tmp";
+    FILE* file = fopen(temp_path.c_str(), "wb");
+    if (!file) {
+        ESP_LOGW(TAG, "Cannot write %s", temp_path.c_str());
+        return ESP_FAIL;
+    }
+    
+    UsageFileHeader header = {USAGE_MAGIC, USAGE_VERSION, static_cast<uint16_t>(records.size())};
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+              fwrite(records.data(), sizeof(ActuatorUsageRecord), records.size(), file) == records.size();
+    ok = ok && fflush(file) == 0 && fsync(fileno(file)) == 0;
+    fclose(file);
+    
+    if (ok && rename(temp_path.c_str(), USAGE_PATH) != 0) {
+        // File systems without atomic replace
+        remove(USAGE_PATH);
+        ok = rename(temp_path.c_str(), USAGE_PATH) == 0;
+    }
+    if (!ok) {
+        ESP_LOGW(TAG, "Failed to persist actuator usage");
+        return ESP_FAIL;
+    }
+    
+    // Only now the table is on flash. Counters that changed during the
+    // write differ from their record and stay dirty for the next persist
+    {
+        std::lock_guard<std::mutex> lock(usage_mutex_);
+        for (auto& actuator : actuators_) {
+            ActuatorUsageRecord current;
+            actuator.usage.fill(current, actuator.config.role);
+            bool persisted = std::any_of(records.begin(), records.end(),
+                [&current](const ActuatorUsageRecord& record) {
+                    return memcmp(&record, &current, sizeof(current)) == 0;
+                });
+            if (persisted) {
+                actuator.usage.clear_dirty();
+            }
+        }
+    }
+    
+    ESP_LOGD(TAG, "Usage persisted (%zu records)", records.size());
+    return ESP_OK;
+}
+
+void ActuatorModule::publish_usage(uint64_t now_ms) {
+    last_usage_publish_ms_ = now_ms;
+    
+    nlohmann::json usage = nlohmann::json::object();
+    {
+        std::lock_guard<std::mutex> lock(usage_mutex_);
+        for (auto& actuator : actuators_) {
+            usage[actuator.config.role] = actuator.usage.to_json(now_ms);
+        }
+    }
+    SharedState::set(USAGE_KEY, usage);
+}
@@ -0,0 +1,145 @@
+/**
+ * @file actuator_usage.cpp
+ * @brief Implementation of actuator usage accounting
+ */
+
+#include "actuator_usage.h"
+#include <algorithm>
+#include <cstring>
+
+template <size_t SLOTS, uint32_t SLOT_MS>
+void ActuatorUsage::Window<SLOTS, SLOT_MS>::advance(uint64_t now_ms) {
+    uint64_t index = now_ms / SLOT_MS;
+    if (index <= slot_index) {
+        return;
+    }
+
+    // Clear the slots time has moved into, at most one full turn
+    uint64_t steps = std::min<uint64_t>(index - slot_index, SLOTS);
+    for (uint64_t i = 1; i <= steps; i++) {
+        size_t slot = (index - steps + i) % SLOTS;
+        on_ms[slot] = 0;
+        starts[slot] = 0;
+    }
+    slot_index = index;
+}
+
+template <size_t SLOTS, uint32_t SLOT_MS>
+void ActuatorUsage::Window<SLOTS, SLOT_MS>::add_on_time(uint64_t from_ms, uint64_t to_ms) {
+    // Split at slot boundaries; segments older than the window fall out
+    if (to_ms > SLOTS * static_cast<uint64_t>(SLOT_MS)) {
+        from_ms = std::max(from_ms, to_ms - SLOTS * static_cast<uint64_t>(SLOT_MS));
+    }
+    while (from_ms < to_ms) {
+        uint64_t slot_end = (from_ms / SLOT_MS + 1) * SLOT_MS;
+        uint64_t end = std::min(slot_end, to_ms);
+        advance(from_ms);
+        on_ms[(from_ms / SLOT_MS) % SLOTS] += static_cast<uint32_t>(end - from_ms);
+        from_ms = end;
+    }
+    advance(to_ms);
+}
+
+template <size_t SLOTS, uint32_t SLOT_MS>
+void ActuatorUsage::Window<SLOTS, SLOT_MS>::add_start(uint64_t now_ms) {
+    advance(now_ms);
+    size_t slot = (now_ms / SLOT_MS) % SLOTS;
+    if (starts[slot] < UINT16_MAX) {
+        starts[slot]++;
+    }
+}
+
+template <size_t SLOTS, uint32_t SLOT_MS>
+uint32_t ActuatorUsage::Window<SLOTS, SLOT_MS>::total_on_ms() const {
+    uint32_t total = 0;
+    for (size_t i = 0; i < SLOTS; i++) {
+        total += on_ms[i];
+    }
+    return total;
+}
+
+template <size_t SLOTS, uint32_t SLOT_MS>
+uint32_t ActuatorUsage::Window<SLOTS, SLOT_MS>::total_starts() const {
+    uint32_t total = 0;
+    for (size_t i = 0; i < SLOTS; i++) {
+        total += starts[i];
+    }
+    return total;
+}
+
+void ActuatorUsage::record(bool active, uint64_t now_ms) {
+    if (!tracking_) {
+        tracking_ = true;
+        tracking_since_ms_ = now_ms;
+        last_ms_ = now_ms;
+        active_ = active;
+        return;
+    }
+
+    if (active_ && now_ms > last_ms_) {
+        runtime_ms_ += now_ms - last_ms_;
+        hour_.add_on_time(last_ms_, now_ms);
+        day_.add_on_time(last_ms_, now_ms);
+        dirty_ = true;
+    } else {
+        hour_.advance(now_ms);
+        day_.advance(now_ms);
+    }
+
+    if (active && !active_) {
+        starts_++;
+        hour_.add_start(now_ms);
+        day_.add_start(now_ms);
+        max_starts_per_hour_ = std::max(max_starts_per_hour_, hour_.total_starts());
+        dirty_ = true;
+    }
+
+    active_ = active;
+    last_ms_ = now_ms;
+}
+
+void ActuatorUsage::restore(const ActuatorUsageRecord& record) {
+    starts_ = record.starts;
+    runtime_ms_ = static_cast<uint64_t>(record.runtime_s) * 1000;
+    max_starts_per_hour_ = record.max_starts_per_hour;
+}
+
+void ActuatorUsage::fill(ActuatorUsageRecord& record, const std::string& role) const {
+    memset(&record, 0, sizeof(record));
+    strncpy(record.role, role.c_str(), ActuatorUsageRecord::ROLE_LEN - 1);
+    record.starts = starts_;
+    record.runtime_s = static_cast<uint32_t>(runtime_ms_ / 1000);
+    record.max_starts_per_hour = max_starts_per_hour_;
+}
+
+void ActuatorUsage::reset(uint64_t now_ms) {
+    bool active = active_;
+    *this = ActuatorUsage();
+    record(active, now_ms);
+    dirty_ = true;
+}
+
+nlohmann::json ActuatorUsage::to_json(uint64_t now_ms) {
+    record(active_, now_ms);
+
+    uint32_t hour_covered = covered_ms(now_ms, hour_.span_ms(now_ms));
+    uint32_t day_covered = covered_ms(now_ms, day_.span_ms(now_ms));
+    return {
+        {"active", active_},
+        {"starts", starts_},
+        {"runtime_h", runtime_ms_ / 3600000.0f},
+        {"starts_last_hour", hour_.total_starts()},
+        {"starts_last_day", day_.total_starts()},
+        {"max_starts_per_hour", max_starts_per_hour_},
+        {"duty_last_hour", hour_covered ? hour_.total_on_ms() * 100.0f / hour_covered : 0.0f},
+        {"duty_last_day", day_covered ? day_.total_on_ms() * 100.0f / day_covered : 0.0f}
+    };
+}
+
+uint32_t ActuatorUsage::covered_ms(uint64_t now_ms, uint32_t span_ms) const {
+    // Shorter than the window right after boot
+    if (!tracking_) {
+        return 0;
+    }
+    return static_cast<uint32_t>(std::min<uint64_t>(now_ms - tracking_since_ms_, span_ms));
+}
@@ -0,0 +1,107 @@
+/**
+ * @file fault_detector.h
+ * @brief Per-sensor plausibility checks on raw samples
+ *
+ * Checks are parsed from the "faults" object of a sensor in sensors.json.
+ * A check with no parameter is disabled, except read errors and staleness
+ * which are always on. State is a few scalars; checking never allocates.
+ *
+ * Example:
+ *   "faults": {
+ *     "min": -40.0, "max": 60.0,
+ *     "max_rate": 0.5,
+ *     "stuck_ms": 1800000, "stuck_delta": 0.02,
+ *     "max_noise": 0.8,
+ *     "stale_ms": 30000
+ *   }
+ */
+
+#pragma once
+
+#include <esp_err.h>
+#include "sensor_driver_interface.h"
+#include "nlohmann/json.hpp"
+#include <cmath>
+#include <cstdint>
+
+/**
+ * @brief Detects implausible or missing sensor data
+ */
+class FaultDetector {
+public:
+    /**
+     * @brief Fault bits, several can be active at once
+     */
+    enum Fault : uint8_t {
+        FAULT_NONE  = 0,
+        FAULT_READ  = 1 << 0,   // Consecutive driver read errors
+        FAULT_RANGE = 1 << 1,   // Value outside [min, max]
+        FAULT_RATE  = 1 << 2,   // Change faster than max_rate per second
+        FAULT_STUCK = 1 << 3,   // Value frozen for stuck_ms
+        FAULT_NOISE = 1 << 4,   // Sample-to-sample deviation above max_noise
+        FAULT_STALE = 1 << 5    // No valid sample for stale_ms
+    };
+
+    /**
+     * @brief Parse checks from a JSON object
+     * @return ESP_OK or ESP_ERR_INVALID_ARG (detector keeps defaults)
+     */
+    esp_err_t configure(const nlohmann::json& config);
+
+    /**
+     * @brief Forget history and start the staleness timer
+     */
+    void start(uint32_t now_ms);
+
+    /**
+     * @brief Check a completed read
+     * @return Active faults after this sample
+     */
+    uint8_t check(const SensorSample& sample);
+
+    /**
+     * @brief Check the age of the last valid sample
+     * @param period_ms Poll period, default limit is 3 periods
+     * @return Active faults
+     */
+    uint8_t check_stale(uint32_t now_ms, uint32_t period_ms);
+
+    uint8_t active() const { return active_; }
+    uint32_t fault_count() const { return fault_count_; }
+
+    /**
+     * @brief Names of the faults in a bit mask
+     */
+    static nlohmann::json faults_to_json(uint8_t faults);
+
+    /**
+     * @brief Active faults, counters and noise estimate
+     */
+    nlohmann::json get_status() const;
+
+private:
+    void set(uint8_t fault, bool on);
+
+    // Configuration
+    float min_ = NAN;
+    float max_ = NAN;
+    float max_rate_ = 0.0f;         // Units per second
+    float max_noise_ = 0.0f;        // Standard deviation of differences
+    float noise_alpha_ = 0.2f;
+    float stuck_delta_ = 0.01f;
+    uint32_t stuck_ms_ = 0;
+    uint32_t stale_ms_ = 0;         // 0 = three poll periods
+    uint8_t read_errors_ = 3;
+
+    // State
+    uint8_t active_ = FAULT_NONE;
+    uint8_t consecutive_errors_ = 0;
+    bool has_sample_ = false;
+    float last_value_ = 0.0f;       // Last in-range value
+    uint32_t last_value_ms_ = 0;
+    uint32_t last_valid_ms_ = 0;    // Last valid read, for staleness
+    float noise_var_ = 0.0f;
+    float stuck_ref_ = 0.0f;
+    uint32_t stuck_since_ms_ = 0;
+    uint32_t fault_count_ = 0;      // Fault activations
+};
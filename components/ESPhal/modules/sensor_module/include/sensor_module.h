@@ -11,6 +11,10 @@
  * - Type-agnostic sensor management  
  * - Configuration-driven sensor creation
  * - Standardized data publishing
+ * - Per-sensor poll period and phase, spread over a timer wheel
+ * - Non-blocking reads: I/O of drivers and buses overlaps across updates
+ * - Event-driven drivers (interrupt inputs) are read as soon as they change
+ * - Fault detection per sensor and redundancy groups with failover or voting
  */
 
 #pragma once
@@ -19,7 +23,10 @@
 #include "esphal.h"
 #include "shared_state.h"
 #include "sensor_driver_interface.h"
+#include "signal_pipeline.h"
+#include "fault_detector.h"
 #include "nlohmann/json.hpp"
+#include <atomic>
 #include <vector>
 #include <memory>
 #include <string>
@@ -32,6 +39,10 @@ struct SensorConfig {
     std::string type;           // Driver type (e.g., "DS18B20", "NTC")
     std::string publish_key;    // SharedState key to publish data
     nlohmann::json config;      // Driver-specific configuration
+    nlohmann::json filters;     // Signal pipeline stages (empty = raw value)
+    nlohmann::json faults;      // Fault detection checks (empty = read errors and staleness only)
+    uint32_t poll_interval_ms = 0;  // Own poll period (0 = module default)
+    int32_t phase_ms = -1;          // Offset within the period (-1 = spread automatically)
     
     // Parsing helper
     static SensorType parse_type(const std::string& type_str);
@@ -94,7 +105,38 @@ public:
     std::optional<SensorConfig> get_sensor_config(const std::string& role) const;
     
     /**
-     * @brief Force immediate sensor poll (for testing)
+     * @brief Get filter pipeline statistics by role
+     * @param role Sensor role
+     * @return Per-stage calls and cycle costs, or nullopt if sensor not found
+     */
+    std::optional<nlohmann::json> get_filter_stats(const std::string& role) const;
+    
+    /**
+     * @brief Get poll scheduling and read latency statistics by role
+     * @param role Sensor role
+     * @return Period, read time and lateness, or nullopt if sensor not found
+     */
+    std::optional<nlohmann::json> get_poll_stats(const std::string& role) const;
+    
+    /**
+     * @brief Get fault detection status by role
+     * @param role Sensor role
+     * @return Active faults and counters, or nullopt if sensor not found
+     */
+    std::optional<nlohmann::json> get_fault_status(const std::string& role) const;
+    
+    /**
+     * @brief Get redundancy group status by group role
+     * @param role Group role (e.g., "chamber_temp")
+     * @return Mode, selected member and switchover count, or nullopt if group not found
+     */
+    std::optional<nlohmann::json> get_group_status(const std::string& role) const;
+    
+    /**
+     * @brief Start an immediate read of every idle sensor (for testing)
+     * 
+     * Results are delivered by the following update() calls.
+     * 
      * @return ESP_OK on success
      */
     esp_err_t poll_sensors_now();
@@ -110,15 +152,70 @@ private:
     struct SensorInstance {
         std::unique_ptr<ISensorDriver> driver;
         SensorConfig config;
-        ::SensorReading last_reading;
+        SensorModule* owner = nullptr;
+        ::SensorSample last_sample;
+        int value_slot = -1;            // SensorValueTable slot of the role
+        SignalPipeline filters;
+        FaultDetector faults;
+        uint8_t reported_faults = 0;    // Mask last published as sensor.fault
+        int8_t group = -1;              // Redundancy group index
         uint32_t poll_failures = 0;
+        uint32_t rejected_samples = 0;
+        
+        // Asynchronous read in progress
+        bool read_in_progress = false;
+        int64_t read_start_us = 0;
+        
+        // Scheduling
+        uint32_t period_ms = 0;
+        uint32_t next_due_ms = 0;
+        int16_t next_in_slot = -1;      // Timer wheel slot list link
+        
+        // Read latency
+        uint32_t reads = 0;
+        uint32_t last_read_us = 0;
+        uint32_t max_read_us = 0;           // start_read() to completion
+        uint64_t total_read_us = 0;
+        uint32_t max_lateness_ms = 0;   // Poll start after due time
+    };
+    
+    /**
+     * @brief Several probes backing one logical role
+     * 
+     * Members are resolved to sensor indices at configure time; selecting
+     * the output only walks this fixed array.
+     */
+    static constexpr size_t MAX_GROUP_MEMBERS = 4;
+    
+    enum class GroupMode : uint8_t {
+        FAILOVER,   // First healthy member in configured order
+        MEDIAN,     // Median of healthy members
+        AVERAGE     // Mean of healthy members
+    };
+    
+    struct SensorGroup {
+        std::string role;
+        std::string publish_key;
+        GroupMode mode = GroupMode::FAILOVER;
+        int16_t members[MAX_GROUP_MEMBERS];
+        uint8_t member_count = 0;
+        int16_t active = -1;            // Selected member (FAILOVER), -1 = none healthy
+        int16_t failover_from = -1;     // Switchover not yet published as sensor.failover
+        int value_slot = -1;
+        ::SensorSample output;
+        uint32_t switchovers = 0;
     };
     
+    // Timer wheel: sensors hashed by due time into 10 ms slots
+    static constexpr uint32_t WHEEL_TICK_MS = 10;
+    static constexpr size_t WHEEL_SLOTS = 128;
+    
     // Reference to HAL for hardware access
     ESPhal& hal_;
     
     // All active sensors
     std::vector<SensorInstance> sensors_;
+    std::vector<SensorGroup> groups_;
     
     // Module state
     bool initialized_ = false;
@@ -126,13 +223,33 @@ private:
     uint32_t total_errors_ = 0;
     
     // Configuration
-    uint32_t poll_interval_ms_ = 10000;  // Default 10 seconds
+    uint32_t poll_interval_ms_ = 10000;  // Default period, 10 seconds
     bool publish_on_error_ = true;       // Publish error states
-    uint32_t last_poll_time_ms_ = 0;     // Last time sensors were polled
+    uint32_t stats_interval_ms_ = 60000; // Poll stats publish period (0 = off)
+    uint32_t last_stats_time_ms_ = 0;
+    
+    // Scheduler state
+    int16_t wheel_[WHEEL_SLOTS];
+    uint32_t wheel_tick_ = 0;            // Last processed tick
+    size_t reads_in_progress_ = 0;
+    std::atomic<uint64_t> changed_sensors_{0};  // Bit per sensor index, set from driver tasks
+    bool transitions_pending_ = false;   // Fault or failover events to publish
     
     // Helper methods
     esp_err_t create_sensor_from_config(const nlohmann::json& sensor_config);
-    void publish_sensor_data(const SensorInstance& sensor, const ::SensorReading& reading);
+    void publish_sensor_data(const SensorInstance& sensor, const ::SensorSample& sample);
+    void start_sensor_read(SensorInstance& sensor);
+    void complete_sensor_read(SensorInstance& sensor, const ::SensorSample& sample);
+    static void on_read_complete(void* context, const ::SensorSample& sample);
+    static void on_sensor_changed(void* context);
+    esp_err_t create_group_from_config(const nlohmann::json& group_config);
+    void publish_transitions();
+    void update_group(SensorGroup& group, const SensorInstance* source);
+    void publish_group_data(const SensorGroup& group);
+    void build_schedule(uint32_t now_ms);
+    void schedule(int16_t index);
+    void publish_poll_stats();
+    nlohmann::json poll_stats_json(const SensorInstance& sensor) const;
     std::unique_ptr<ISensorDriver> create_driver(const std::string& type);
 };
 
@@ -0,0 +1,123 @@
+/**
+ * @file signal_pipeline.h
+ * @brief Per-sensor signal processing chain
+ *
+ * Filter stages are parsed from the "filters" array of a sensor in
+ * sensors.json and compiled at configure() time into a flat array of
+ * function pointers with pre-allocated state. Processing a sample never
+ * allocates and walks the array once.
+ *
+ * Example:
+ *   "filters": [
+ *     {"type": "spike", "threshold": 5.0, "max_rejects": 3},
+ *     {"type": "median", "window": 5},
+ *     {"type": "ema", "alpha": 0.3},
+ *     {"type": "deadband", "delta": 0.1}
+ *   ]
+ */
+
+#pragma once
+
+#include <esp_err.h>
+#include "nlohmann/json.hpp"
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Fixed-size chain of filter stages for one sensor
+ */
+class SignalPipeline {
+public:
+    static constexpr size_t MAX_STAGES = 6;
+    static constexpr size_t MAX_MEDIAN_WINDOW = 9;
+
+    /**
+     * @brief Outcome of a sample passed through the chain
+     */
+    enum class Verdict : uint8_t {
+        PUBLISH,    // Filtered value should be published
+        SUPPRESS,   // Value kept but change is below the publish deadband
+        DROP        // Sample rejected (spike) - keep the previous reading
+    };
+
+    enum class StageType : uint8_t {
+        MEDIAN,
+        EMA,
+        KALMAN,
+        RATE_LIMIT,
+        SPIKE,
+        DEADBAND
+    };
+
+    /**
+     * @brief Compile the chain from a JSON array of stage objects
+     * @return ESP_OK, ESP_ERR_INVALID_ARG for an unknown stage or bad parameter,
+     *         ESP_ERR_NO_MEM if more than MAX_STAGES are configured
+     *
+     * On error the pipeline is left empty (pass-through).
+     */
+    esp_err_t configure(const nlohmann::json& filters);
+
+    /**
+     * @brief Run a valid sample through every stage
+     * @param value Sample in, filtered value out
+     * @param now_ms Sample timestamp used by rate-dependent stages
+     */
+    Verdict process(float& value, uint32_t now_ms);
+
+    /**
+     * @brief Forget filter history (keeps the configuration)
+     */
+    void reset();
+
+    bool empty() const { return stage_count_ == 0; }
+    size_t stage_count() const { return stage_count_; }
+
+    /**
+     * @brief Per-stage call count and average CPU cycles
+     */
+    nlohmann::json get_stats() const;
+
+private:
+    struct Stage;
+    using StageFn = Verdict (*)(Stage& stage, float& value, uint32_t dt_ms);
+
+    struct Stage {
+        StageFn process;
+        StageType type;
+        bool primed;                    // Stage has seen its first sample
+        float param[2];                 // Stage parameters from configuration
+
+        union {
+            struct {
+                float window[MAX_MEDIAN_WINDOW];
+                uint8_t size;
+                uint8_t head;
+                uint8_t count;
+            } median;
+            struct {
+                float value;            // Last output / accepted / published value
+                float error;            // Kalman estimate covariance
+                uint32_t rejects;       // Consecutive spike rejections
+            } scalar;
+        } state;
+
+        uint32_t calls;
+        uint64_t cycles;
+    };
+
+    static Verdict run_median(Stage& stage, float& value, uint32_t dt_ms);
+    static Verdict run_ema(Stage& stage, float& value, uint32_t dt_ms);
+    static Verdict run_kalman(Stage& stage, float& value, uint32_t dt_ms);
+    static Verdict run_rate_limit(Stage& stage, float& value, uint32_t dt_ms);
+    static Verdict run_spike(Stage& stage, float& value, uint32_t dt_ms);
+    static Verdict run_deadband(Stage& stage, float& value, uint32_t dt_ms);
+
+    static const char* type_to_string(StageType type);
+    static esp_err_t compile_stage(const nlohmann::json& config, Stage& stage);
+
+    Stage stages_[MAX_STAGES] = {};
+    size_t stage_count_ = 0;
+    uint32_t last_sample_ms_ = 0;
+    bool has_sample_ = false;
+};
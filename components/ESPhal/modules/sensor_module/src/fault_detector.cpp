@@ -0,0 +1,149 @@
+/**
+ * @file fault_detector.cpp
+ * @brief Implementation of per-sensor fault checks
+ */
+
+#include "fault_detector.h"
+#include <esp_log.h>
+#include <algorithm>
+#include <cmath>
+
+static const char* TAG = "FaultDetector";
+
+esp_err_t FaultDetector::configure(const nlohmann::json& config) {
+    if (!config.is_object()) {
+        ESP_LOGE(TAG, "'faults' must be an object");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    float min = config.value("min", NAN);
+    float max = config.value("max", NAN);
+    float max_rate = config.value("max_rate", 0.0f);
+    float max_noise = config.value("max_noise", 0.0f);
+    float noise_alpha = config.value("noise_alpha", 0.2f);
+    float stuck_delta = config.value("stuck_delta", 0.01f);
+    uint32_t stuck_ms = config.value("stuck_ms", 0u);
+    uint32_t stale_ms = config.value("stale_ms", 0u);
+    uint32_t read_errors = config.value("read_errors", 3u);
+
+    if ((!std::isnan(min) && !std::isnan(max) && min >= max) ||
+        max_rate < 0.0f || max_noise < 0.0f || stuck_delta < 0.0f ||
+        noise_alpha <= 0.0f || noise_alpha > 1.0f ||
+        read_errors < 1 || read_errors > UINT8_MAX) {
+        ESP_LOGE(TAG, "Invalid fault detection parameters");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    min_ = min;
+    max_ = max;
+    max_rate_ = max_rate;
+    max_noise_ = max_noise;
+    noise_alpha_ = noise_alpha;
+    stuck_delta_ = stuck_delta;
+    stuck_ms_ = stuck_ms;
+    stale_ms_ = stale_ms;
+    read_errors_ = static_cast<uint8_t>(read_errors);
+    return ESP_OK;
+}
+
+void FaultDetector::start(uint32_t now_ms) {
+    active_ = FAULT_NONE;
+    consecutive_errors_ = 0;
+    has_sample_ = false;
+    noise_var_ = 0.0f;
+    last_valid_ms_ = now_ms;
+}
+
+void FaultDetector::set(uint8_t fault, bool on) {
+    if (on && !(active_ & fault)) {
+        fault_count_++;
+    }
+    active_ = on ? (active_ | fault) : (active_ & ~fault);
+}
+
+uint8_t FaultDetector::check(const SensorSample& sample) {
+    if (!sample.is_valid()) {
+        if (consecutive_errors_ < UINT8_MAX) {
+            consecutive_errors_++;
+        }
+        set(FAULT_READ, consecutive_errors_ >= read_errors_);
+        return active_;
+    }
+
+    float value = sample.value;
+    uint32_t now_ms = sample.timestamp_ms;
+    consecutive_errors_ = 0;
+    last_valid_ms_ = now_ms;
+    set(FAULT_READ, false);
+    set(FAULT_STALE, false);
+
+    // Out-of-range samples do not become the reference for the other checks
+    bool out_of_range = (!std::isnan(min_) && value < min_) || (!std::isnan(max_) && value > max_);
+    set(FAULT_RANGE, out_of_range);
+    if (out_of_range) {
+        return active_;
+    }
+
+    if (!has_sample_) {
+        has_sample_ = true;
+        stuck_ref_ = value;
+        stuck_since_ms_ = now_ms;
+    } else {
+        float delta = value - last_value_;
+        uint32_t dt_ms = now_ms - last_value_ms_;
+
+        // Step against the previous sample; a single violation faults one sample
+        if (max_rate_ > 0.0f && dt_ms > 0) {
+            set(FAULT_RATE, std::fabs(delta) * 1000.0f / dt_ms > max_rate_);
+        }
+
+        // Exponentially weighted variance of differences; each difference is
+        // clamped so one genuine step cannot raise the fault on its own
+        if (max_noise_ > 0.0f) {
+            float clamp = 2.0f * max_noise_;
+            noise_var_ += noise_alpha_ * (std::min(delta * delta, clamp * clamp) - noise_var_);
+            float limit = (active_ & FAULT_NOISE) ? 0.7f * max_noise_ : max_noise_;
+            set(FAULT_NOISE, noise_var_ > limit * limit);
+        }
+
+        if (stuck_ms_ > 0) {
+            if (std::fabs(value - stuck_ref_) > stuck_delta_) {
+                stuck_ref_ = value;
+                stuck_since_ms_ = now_ms;
+            }
+            set(FAULT_STUCK, now_ms - stuck_since_ms_ >= stuck_ms_);
+        }
+    }
+
+    last_value_ = value;
+    last_value_ms_ = now_ms;
+    return active_;
+}
+
+uint8_t FaultDetector::check_stale(uint32_t now_ms, uint32_t period_ms) {
+    uint32_t limit = stale_ms_ ? stale_ms_ : 3 * period_ms;
+    set(FAULT_STALE, now_ms - last_valid_ms_ > limit);
+    return active_;
+}
+
+nlohmann::json FaultDetector::faults_to_json(uint8_t faults) {
+    static const char* const names[] = {"read", "range", "rate", "stuck", "noise", "stale"};
+
+    nlohmann::json list = nlohmann::json::array();
+    for (size_t bit = 0; bit < sizeof(names) / sizeof(names[0]); bit++) {
+        if (faults & (1u << bit)) {
+            list.push_back(names[bit]);
+        }
+    }
+    return list;
+}
+
+nlohmann::json FaultDetector::get_status() const {
+    return {
+        {"active", faults_to_json(active_)},
+        {"fault_count", fault_count_},
+        {"consecutive_errors", consecutive_errors_},
+        {"noise", std::sqrt(noise_var_)},
+        {"last_valid_ms", last_valid_ms_}
+    };
+}
@@ -10,6 +10,7 @@
 #include "sensor_module.h"
 #include "sensor_driver_registry.h"
 #include "sensor_driver_init.h"
+#include "sensor_value_table.h"
 #include "shared_state.h"
 #include "event_bus.h"
 #include "error_handling.h"
@@ -28,6 +29,7 @@ static const char* TAG = "SensorModule";
 
 SensorModule::SensorModule(ESPhal& hal) 
     : hal_(hal) {
+    std::fill(std::begin(wheel_), std::end(wheel_), -1);
     ESP_LOGI(TAG, "SensorsModule created");
 }
 
@@ -61,6 +63,8 @@ void SensorModule::configure(const nlohmann::json& config) {
         
         // Clear existing sensors
         sensors_.clear();
+        groups_.clear();
+        reads_in_progress_ = 0;
         
         // Parse global settings (safe JSON access)
         if (config.contains("poll_interval_ms") && config["poll_interval_ms"].is_number_unsigned()) {
@@ -72,6 +76,10 @@ void SensorModule::configure(const nlohmann::json& config) {
             publish_on_error_ = config["publish_on_error"];
         }
         
+        if (config.contains("stats_interval_ms") && config["stats_interval_ms"].is_number_unsigned()) {
+            stats_interval_ms_ = config["stats_interval_ms"];
+        }
+        
         // Create sensors from configuration
         if (config.contains("sensors") && config["sensors"].is_array()) {
             const auto& sensors_array = config["sensors"];
@@ -85,7 +93,18 @@ void SensorModule::configure(const nlohmann::json& config) {
             }
         }
         
-        ESP_LOGI(TAG, "Configured %zu sensors", sensors_.size());
+        // Redundancy groups refer to sensors by role, so they come last
+        if (config.contains("groups") && config["groups"].is_array()) {
+            for (const auto& group_config : config["groups"]) {
+                if (create_group_from_config(group_config) != ESP_OK) {
+                    ESP_LOGE(TAG, "Failed to create sensor group");
+                }
+            }
+        }
+        
+        build_schedule(esp_timer_get_time() / 1000);
+        
+        ESP_LOGI(TAG, "Configured %zu sensors, %zu groups", sensors_.size(), groups_.size());
         return ESP_OK;
     });
 }
@@ -113,6 +132,15 @@ esp_err_t SensorModule::create_sensor_from_config(const nlohmann::json& sensor_c
         config.type = sensor_config["type"];
         config.publish_key = sensor_config["publish_key"];
         config.config = sensor_config.value("config", nlohmann::json::object());
+        config.filters = sensor_config.value("filters", nlohmann::json::array());
+        config.faults = sensor_config.value("faults", nlohmann::json::object());
+        
+        if (sensor_config.contains("poll_interval_ms") && sensor_config["poll_interval_ms"].is_number_unsigned()) {
+            config.poll_interval_ms = sensor_config["poll_interval_ms"];
+        }
+        if (sensor_config.contains("phase_ms") && sensor_config["phase_ms"].is_number_unsigned()) {
+            config.phase_ms = sensor_config["phase_ms"];
+        }
         
         ESP_LOGI(TAG, "Creating sensor: role='%s', type='%s'", 
                  config.role.c_str(), config.type.c_str());
@@ -136,8 +164,20 @@ esp_err_t SensorModule::create_sensor_from_config(const nlohmann::json& sensor_c
         SensorInstance instance;
         instance.driver = std::move(driver);
         instance.config = std::move(config);
-        instance.last_reading = {0.0f, "°C", 0, false, "Not read yet"};
+        instance.owner = this;
+        instance.last_sample = {0.0f, SensorUnit::NONE, ESP_ERR_NOT_FINISHED, 0};  // Not read yet
         instance.poll_failures = 0;
+        instance.value_slot = SensorValueTable::instance().resolve(instance.config.role);
+        
+        // Compile filter chain once; a bad chain leaves the raw value
+        if (instance.filters.configure(instance.config.filters) != ESP_OK) {
+            ESP_LOGW(TAG, "Invalid filters for '%s', publishing raw values",
+                     instance.config.role.c_str());
+        }
+        if (instance.faults.configure(instance.config.faults) != ESP_OK) {
+            ESP_LOGW(TAG, "Invalid fault checks for '%s', using defaults",
+                     instance.config.role.c_str());
+        }
         
         sensors_.push_back(std::move(instance));
         
@@ -145,6 +185,73 @@ esp_err_t SensorModule::create_sensor_from_config(const nlohmann::json& sensor_c
         return ESP_OK;
     });
 }
+
+esp_err_t SensorModule::create_group_from_config(const nlohmann::json& group_config) {
+    if (!group_config.contains("role") || !group_config["role"].is_string() ||
+        !group_config.contains("publish_key") || !group_config["publish_key"].is_string() ||
+        !group_config.contains("members") || !group_config["members"].is_array()) {
+        ESP_LOGE(TAG, "Group needs 'role', 'publish_key' and 'members'");
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    const auto& members = group_config["members"];
+    if (members.size() < 2 || members.size() > MAX_GROUP_MEMBERS) {
+        ESP_LOGE(TAG, "Group needs 2..%zu members", MAX_GROUP_MEMBERS);
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (groups_.size() >= INT8_MAX) {
+        ESP_LOGE(TAG, "Too many sensor groups");
+        return ESP_ERR_NO_MEM;
+    }
+    
+    SensorGroup group;
+    group.role = group_config["role"];
+    group.publish_key = group_config["publish_key"];
+    
+    std::string mode = group_config.value("mode", std::string("failover"));
+    if (mode == "failover") {
+        group.mode = GroupMode::FAILOVER;
+    } else if (mode == "median") {
+        group.mode = GroupMode::MEDIAN;
+    } else if (mode == "average") {
+        group.mode = GroupMode::AVERAGE;
+    } else {
+        ESP_LOGE(TAG, "Unknown group mode: %s", mode.c_str());
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    for (const auto& sensor : sensors_) {
+        if (sensor.config.role == group.role) {
+            ESP_LOGE(TAG, "Group role '%s' is already a sensor role", group.role.c_str());
+            return ESP_ERR_INVALID_ARG;
+        }
+    }
+    
+    for (const auto& member : members) {
+        auto it = std::find_if(sensors_.begin(), sensors_.end(),
+            [&member](const SensorInstance& sensor) {
+                return member.is_string() && sensor.config.role == member.get<std::string>();
+            });
+        if (it == sensors_.end() || it->group >= 0) {
+            ESP_LOGE(TAG, "Group '%s': member missing or already grouped", group.role.c_str());
+            return ESP_ERR_INVALID_ARG;
+        }
+        group.members[group.member_count++] = static_cast<int16_t>(it - sensors_.begin());
+    }
+    
+    group.value_slot = SensorValueTable::instance().resolve(group.role);
+    group.output = {0.0f, SensorUnit::NONE, ESP_ERR_NOT_FINISHED, 0};  // Not read yet
+    
+    for (size_t i = 0; i < group.member_count; i++) {
+        sensors_[group.members[i]].group = static_cast<int8_t>(groups_.size());
+    }
+    groups_.push_back(std::move(group));
+    
+    ESP_LOGI(TAG, "Sensor group created: %s (%s, %zu members)",
+             groups_.back().role.c_str(), mode.c_str(), members.size());
+    return ESP_OK;
+}
+
 void SensorModule::update() {
     if (!initialized_) {
         return;
@@ -152,47 +259,384 @@ void SensorModule::update() {
     
     update_count_++;
     
-    // Check if it's time to poll sensors
     uint32_t now_ms = esp_timer_get_time() / 1000;
-    if (now_ms - last_poll_time_ms_ < poll_interval_ms_) {
-        return; // Not time to poll yet
+    
+    // Drivers that reported a change are read now, off their schedule
+    uint64_t changed = changed_sensors_.exchange(0, std::memory_order_acquire);
+    while (changed) {
+        size_t index = __builtin_ctzll(changed);
+        changed &= changed - 1;
+        if (index < sensors_.size()) {
+            start_sensor_read(sensors_[index]);
+        }
     }
     
-    last_poll_time_ms_ = now_ms;
+    // Advance reads started earlier; drivers on different buses overlap
+    if (reads_in_progress_ > 0) {
+        for (auto& sensor : sensors_) {
+            if (sensor.read_in_progress) {
+                sensor.driver->poll(now_ms);
+            }
+        }
+    }
     
-    // Poll all sensors
-    for (auto& sensor : sensors_) {
-        // Read sensor value (without exception handling)
-        ::SensorReading reading = sensor.driver->read();
+    // Fault and failover events of the previous pass, built off the read path
+    if (transitions_pending_) {
+        publish_transitions();
+    }
+    
+    uint32_t now_tick = now_ms / WHEEL_TICK_MS;
+    uint32_t ticks = now_tick - wheel_tick_;
+    if (ticks == 0) {
+        return; // Still in the last processed tick
+    }
+    
+    // After a long stall one turn of the wheel visits every sensor
+    if (ticks > WHEEL_SLOTS) {
+        ticks = WHEEL_SLOTS;
+    }
+    
+    for (uint32_t tick = now_tick - ticks + 1; ticks > 0; tick++, ticks--) {
+        size_t slot = tick % WHEEL_SLOTS;
+        int16_t index = wheel_[slot];
+        wheel_[slot] = -1;
         
-        // Update last reading
-        sensor.last_reading = reading;
+        while (index >= 0) {
+            SensorInstance& sensor = sensors_[index];
+            int16_t next = sensor.next_in_slot;
+            
+            // Slot also holds sensors due in a later turn of the wheel
+            int32_t lateness = static_cast<int32_t>(now_ms - sensor.next_due_ms);
+            if (lateness >= 0) {
+                sensor.max_lateness_ms = std::max(sensor.max_lateness_ms, static_cast<uint32_t>(lateness));
+                start_sensor_read(sensor);
+                
+                // Advance by whole periods to keep the phase
+                sensor.next_due_ms += sensor.period_ms;
+                if (static_cast<int32_t>(now_ms - sensor.next_due_ms) >= 0) {
+                    uint32_t missed = (now_ms - sensor.next_due_ms) / sensor.period_ms + 1;
+                    sensor.next_due_ms += missed * sensor.period_ms;
+                }
+            }
+            
+            schedule(index);
+            index = next;
+        }
+    }
+    wheel_tick_ = now_tick;
+    
+    // Sensors whose reads stopped completing (bus hang, driver stuck)
+    for (auto& sensor : sensors_) {
+        uint8_t previous = sensor.faults.active();
+        if (sensor.faults.check_stale(now_ms, sensor.period_ms) != previous) {
+            transitions_pending_ = true;
+            if (sensor.group >= 0) {
+                update_group(groups_[sensor.group], nullptr);
+            }
+        }
+    }
+    
+    if (stats_interval_ms_ > 0 && now_ms - last_stats_time_ms_ >= stats_interval_ms_) {
+        last_stats_time_ms_ = now_ms;
+        publish_poll_stats();
+    }
+}
+
+void SensorModule::start_sensor_read(SensorInstance& sensor) {
+    // Previous read still waiting for hardware - skip this period
+    if (sensor.read_in_progress) {
+        ESP_LOGD(TAG, "Read still in progress: %s", sensor.config.role.c_str());
+        return;
+    }
+    
+    sensor.read_in_progress = true;
+    sensor.read_start_us = esp_timer_get_time();
+    reads_in_progress_++;
+    
+    // Driver may complete right away (callback runs inside start_read)
+    esp_err_t ret = sensor.driver->start_read(on_read_complete, &sensor);
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Failed to start read of %s: %s", sensor.config.role.c_str(), esp_err_to_name(ret));
+        if (sensor.read_in_progress) {
+            sensor.read_in_progress = false;
+            reads_in_progress_--;
+        }
+    }
+}
+
+void SensorModule::on_read_complete(void* context, const ::SensorSample& sample) {
+    auto* sensor = static_cast<SensorInstance*>(context);
+    sensor->owner->complete_sensor_read(*sensor, sample);
+}
+
+void SensorModule::on_sensor_changed(void* context) {
+    // Runs in the driver's task - only flag the sensor for the next update()
+    auto* sensor = static_cast<SensorInstance*>(context);
+    SensorModule* module = sensor->owner;
+    size_t index = sensor - module->sensors_.data();
+    if (index < 64) {
+        module->changed_sensors_.fetch_or(1ULL << index, std::memory_order_release);
+    }
+}
+
+void SensorModule::complete_sensor_read(SensorInstance& sensor, const ::SensorSample& result) {
+    if (sensor.read_in_progress) {
+        sensor.read_in_progress = false;
+        reads_in_progress_--;
+    }
+    
+    uint32_t read_us = esp_timer_get_time() - sensor.read_start_us;
+    sensor.reads++;
+    sensor.last_read_us = read_us;
+    sensor.max_read_us = std::max(sensor.max_read_us, read_us);
+    sensor.total_read_us += read_us;
+    
+    // Implausible samples are kept away from the filters and marked invalid
+    ::SensorSample sample = result;
+    uint8_t previous_faults = sensor.faults.active();
+    if (sensor.faults.check(sample) != FaultDetector::FAULT_NONE && sample.is_valid()) {
+        sample.status = ESP_ERR_INVALID_STATE;
+    }
+    
+    // Filter valid samples; errors go through unchanged
+    auto verdict = SignalPipeline::Verdict::PUBLISH;
+    if (sample.is_valid()) {
+        verdict = sensor.filters.process(sample.value, sample.timestamp_ms);
+    }
+    
+    if (verdict == SignalPipeline::Verdict::DROP) {
+        // The value is discarded, but the read itself succeeded
+        sensor.rejected_samples++;
+        sensor.poll_failures = 0;
+        ESP_LOGD(TAG, "Sample rejected by filters: %s", sensor.config.role.c_str());
+    } else {
+        // Update last reading; virtual sensors read it from the value table
+        sensor.last_sample = sample;
+        SensorValueTable::instance().update(sensor.value_slot, sample);
         
         // Publish to SharedState
-        if (reading.is_valid || publish_on_error_) {
-            publish_sensor_data(sensor, reading);
+        if (verdict == SignalPipeline::Verdict::PUBLISH && (sample.is_valid() || publish_on_error_)) {
+            publish_sensor_data(sensor, sample);
         }
         
         // Reset failure counter on successful read
-        if (reading.is_valid) {
+        if (sample.is_valid()) {
             sensor.poll_failures = 0;
         } else {
             sensor.poll_failures++;
             total_errors_++;
-            ESP_LOGW(TAG, "Sensor read failed: %s", sensor.config.role.c_str());
+            ESP_LOGW(TAG, "Sensor read failed: %s (%s)", sensor.config.role.c_str(), esp_err_to_name(sample.status));
         }
     }
+    
+    // Also after a dropped sample: faults.check() may have cleared a fault
+    if (sensor.faults.active() != previous_faults) {
+        transitions_pending_ = true;
+    }
+    
+    // Group output switches in the same poll that faulted the member
+    if (sensor.group >= 0) {
+        update_group(groups_[sensor.group], &sensor);
+    }
 }
+
+void SensorModule::publish_transitions() {
+    transitions_pending_ = false;
+    
+    for (auto& sensor : sensors_) {
+        uint8_t active = sensor.faults.active();
+        uint8_t previous = sensor.reported_faults;
+        if (active == previous) {
+            continue;
+        }
+        sensor.reported_faults = active;
+        uint8_t raised = active & ~previous;
+        
+        if (raised) {
+            ESP_LOGW(TAG, "Sensor fault: %s %s", sensor.config.role.c_str(),
+                     FaultDetector::faults_to_json(raised).dump().c_str());
+        } else if (active == FaultDetector::FAULT_NONE) {
+            ESP_LOGI(TAG, "Sensor faults cleared: %s", sensor.config.role.c_str());
+        }
+        
+        EventBus::publish("sensor.fault", {
+            {"role", sensor.config.role},
+            {"active", FaultDetector::faults_to_json(active)},
+            {"raised", FaultDetector::faults_to_json(raised)},
+            {"cleared", FaultDetector::faults_to_json(previous & ~active)}
+        });
+    }
+    
+    for (auto& group : groups_) {
+        int16_t from = group.failover_from;
+        group.failover_from = -1;
+        // Switched back, or no healthy member left (already published as the group state)
+        if (from < 0 || from == group.active || group.active < 0) {
+            continue;
+        }
+        EventBus::publish("sensor.failover", {
+            {"role", group.role},
+            {"from", sensors_[from].config.role},
+            {"to", sensors_[group.active].config.role}
+        });
+    }
+}
+
+void SensorModule::update_group(SensorGroup& group, const SensorInstance* source) {
+    // Healthy members: no active fault and a valid last sample
+    float values[MAX_GROUP_MEMBERS];
+    size_t healthy = 0;
+    int16_t first = -1;
+    uint32_t latest_ms = 0;
+    for (size_t i = 0; i < group.member_count; i++) {
+        const SensorInstance& member = sensors_[group.members[i]];
+        if (member.faults.active() != FaultDetector::FAULT_NONE || !member.last_sample.is_valid()) {
+            continue;
+        }
+        if (first < 0) {
+            first = group.members[i];
+        }
+        values[healthy++] = member.last_sample.value;
+        latest_ms = std::max(latest_ms, member.last_sample.timestamp_ms);
+    }
+    
+    if (healthy == 0) {
+        // Publish the loss once, not on every failed member read
+        if (group.active < 0 && !group.output.is_valid()) {
+            return;
+        }
+        ESP_LOGE(TAG, "Group '%s': no healthy member", group.role.c_str());
+        group.active = -1;
+        group.output.status = ESP_ERR_INVALID_STATE;
+        group.output.timestamp_ms = esp_timer_get_time() / 1000;
+    } else if (group.mode == GroupMode::FAILOVER) {
+        if (first != group.active) {
+            if (group.active >= 0) {
+                group.switchovers++;
+                ESP_LOGW(TAG, "Group '%s': failover %s -> %s", group.role.c_str(),
+                         sensors_[group.active].config.role.c_str(),
+                         sensors_[first].config.role.c_str());
+                // Event is built in publish_transitions(), the first switch
+                // of a burst keeps the original member
+                if (group.failover_from < 0) {
+                    group.failover_from = group.active;
+                }
+                transitions_pending_ = true;
+            }
+            group.active = first;
+        } else if (source && source != &sensors_[first]) {
+            return; // Standby member read, output unchanged
+        }
+        group.output = sensors_[first].last_sample;
+    } else {
+        float value = 0.0f;
+        if (group.mode == GroupMode::MEDIAN) {
+            std::sort(values, values + healthy);
+            value = (healthy % 2) ? values[healthy / 2]
+                                  : (values[healthy / 2 - 1] + values[healthy / 2]) * 0.5f;
+        } else {
+            for (size_t i = 0; i < healthy; i++) {
+                value += values[i];
+            }
+            value /= healthy;
+        }
+        group.active = first;
+        group.output = {value, sensors_[first].last_sample.unit, ESP_OK, latest_ms};
+    }
+    
+    SensorValueTable::instance().update(group.value_slot, group.output);
+    if (group.output.is_valid() || publish_on_error_) {
+        publish_group_data(group);
+    }
+}
+
+void SensorModule::publish_group_data(const SensorGroup& group) {
+    nlohmann::json reading = group.output.to_json();
+    if (group.active >= 0) {
+        reading["source"] = sensors_[group.active].config.role;
+    }
+    
+    SharedState::set(group.publish_key, reading);
+    
+    nlohmann::json event_data = {
+        {"role", group.role},
+        {"type", "GROUP"},
+        {"reading", reading}
+    };
+    
+    EventBus::publish("sensor.reading", event_data);
+}
+
+void SensorModule::build_schedule(uint32_t now_ms) {
+    std::fill(std::begin(wheel_), std::end(wheel_), -1);
+    wheel_tick_ = now_ms / WHEEL_TICK_MS - 1;
+    last_stats_time_ms_ = now_ms;
+    changed_sensors_.store(0, std::memory_order_relaxed);
+    
+    // Sensors without an explicit phase are spread evenly over their period,
+    // so reads (and bus traffic) do not all land in the same update
+    size_t count = sensors_.size();
+    for (size_t i = 0; i < count; i++) {
+        SensorInstance& sensor = sensors_[i];
+        uint32_t period = sensor.config.poll_interval_ms ? sensor.config.poll_interval_ms : poll_interval_ms_;
+        sensor.period_ms = std::max(period, WHEEL_TICK_MS);
+        
+        uint32_t phase = sensor.config.phase_ms >= 0
+            ? static_cast<uint32_t>(sensor.config.phase_ms) % sensor.period_ms
+            : static_cast<uint32_t>(static_cast<uint64_t>(sensor.period_ms) * i / count);
+        sensor.next_due_ms = now_ms + phase;
+        sensor.faults.start(now_ms);
+        
+        // Sensor addresses are final here, the vector no longer grows
+        sensor.driver->set_change_callback(on_sensor_changed, &sensor);
+        
+        schedule(static_cast<int16_t>(i));
+        ESP_LOGI(TAG, "Sensor '%s': period %" PRIu32 " ms, phase %" PRIu32 " ms",
+                 sensor.config.role.c_str(), sensor.period_ms, phase);
+    }
+}
+
+void SensorModule::schedule(int16_t index) {
+    SensorInstance& sensor = sensors_[index];
+    size_t slot = (sensor.next_due_ms / WHEEL_TICK_MS) % WHEEL_SLOTS;
+    sensor.next_in_slot = wheel_[slot];
+    wheel_[slot] = index;
+}
+
+nlohmann::json SensorModule::poll_stats_json(const SensorInstance& sensor) const {
+    return {
+        {"period_ms", sensor.period_ms},
+        {"reads", sensor.reads},
+        {"last_read_us", sensor.last_read_us},
+        {"max_read_us", sensor.max_read_us},
+        {"avg_read_us", sensor.reads ? static_cast<uint32_t>(sensor.total_read_us / sensor.reads) : 0},
+        {"max_lateness_ms", sensor.max_lateness_ms}
+    };
+}
+
+void SensorModule::publish_poll_stats() {
+    nlohmann::json stats = nlohmann::json::object();
+    for (const auto& sensor : sensors_) {
+        stats[sensor.config.role] = poll_stats_json(sensor);
+    }
+    SharedState::set("sensors.poll_stats", stats);
+}
+
 void SensorModule::publish_sensor_data(const SensorInstance& sensor, 
-                                      const ::SensorReading& reading) {
+                                      const ::SensorSample& sample) {
+    nlohmann::json reading = sample.to_json();
+    if (sensor.faults.active() != FaultDetector::FAULT_NONE) {
+        reading["faults"] = FaultDetector::faults_to_json(sensor.faults.active());
+    }
+    
     // Publish to SharedState
-    SharedState::set(sensor.config.publish_key, reading.to_json());
+    SharedState::set(sensor.config.publish_key, reading);
     
     // Publish event if significant change
     nlohmann::json event_data = {
         {"role", sensor.config.role},
         {"type", sensor.config.type},
-        {"reading", reading.to_json()}
+        {"reading", reading}
     };
     
     EventBus::publish("sensor.reading", event_data);
@@ -203,6 +647,9 @@ void SensorModule::stop() {
     
     // Clear all sensors
     sensors_.clear();
+    groups_.clear();
+    std::fill(std::begin(wheel_), std::end(wheel_), -1);
+    reads_in_progress_ = 0;
     
     initialized_ = false;
 }
@@ -219,6 +666,13 @@ bool SensorModule::is_healthy() const {
         }
     }
     
+    // A redundant role with every probe faulted
+    for (const auto& group : groups_) {
+        if (group.active < 0 && group.output.status != ESP_ERR_NOT_FINISHED) {
+            return false;
+        }
+    }
+    
     return true;
 }
 
@@ -230,7 +684,7 @@ uint8_t SensorModule::get_health_score() const {
     // Calculate health based on successful sensors
     size_t healthy_count = 0;
     for (const auto& sensor : sensors_) {
-        if (sensor.driver->is_available() && sensor.poll_failures < 3) {
+        if (sensor.driver->is_available() && sensor.faults.active() == FaultDetector::FAULT_NONE) {
             healthy_count++;
         }
     }
@@ -250,7 +704,13 @@ std::optional<::SensorReading> SensorModule::get_sensor_reading(const std::strin
         });
     
     if (it != sensors_.end()) {
-        return it->last_reading;
+        return it->last_sample.to_reading();
+    }
+    
+    for (const auto& group : groups_) {
+        if (group.role == role) {
+            return group.output.to_reading();
+        }
     }
     
     return std::nullopt;
@@ -269,9 +729,85 @@ std::optional<SensorConfig> SensorModule::get_sensor_config(const std::string& r
     return std::nullopt;
 }
 
+std::optional<nlohmann::json> SensorModule::get_filter_stats(const std::string& role) const {
+    auto it = std::find_if(sensors_.begin(), sensors_.end(),
+        [&role](const SensorInstance& sensor) {
+            return sensor.config.role == role;
+        });
+    
+    if (it != sensors_.end()) {
+        return nlohmann::json{
+            {"stages", it->filters.get_stats()},
+            {"rejected_samples", it->rejected_samples}
+        };
+    }
+    
+    return std::nullopt;
+}
+
+std::optional<nlohmann::json> SensorModule::get_poll_stats(const std::string& role) const {
+    auto it = std::find_if(sensors_.begin(), sensors_.end(),
+        [&role](const SensorInstance& sensor) {
+            return sensor.config.role == role;
+        });
+    
+    if (it != sensors_.end()) {
+        return poll_stats_json(*it);
+    }
+    
+    return std::nullopt;
+}
+
+std::optional<nlohmann::json> SensorModule::get_fault_status(const std::string& role) const {
+    auto it = std::find_if(sensors_.begin(), sensors_.end(),
+        [&role](const SensorInstance& sensor) {
+            return sensor.config.role == role;
+        });
+    
+    if (it != sensors_.end()) {
+        return it->faults.get_status();
+    }
+    
+    return std::nullopt;
+}
+
+std::optional<nlohmann::json> SensorModule::get_group_status(const std::string& role) const {
+    static const char* const modes[] = {"failover", "median", "average"};
+    
+    for (const auto& group : groups_) {
+        if (group.role != role) {
+            continue;
+        }
+        nlohmann::json members = nlohmann::json::array();
+        for (size_t i = 0; i < group.member_count; i++) {
+            const SensorInstance& member = sensors_[group.members[i]];
+            members.push_back({
+                {"role", member.config.role},
+                {"faults", FaultDetector::faults_to_json(member.faults.active())}
+            });
+        }
+        return nlohmann::json{
+            {"mode", modes[static_cast<size_t>(group.mode)]},
+            {"members", members},
+            {"active", group.active >= 0 ? sensors_[group.active].config.role : ""},
+            {"switchovers", group.switchovers},
+            {"reading", group.output.to_json()}
+        };
+    }
+    
+    return std::nullopt;
+}
+
 esp_err_t SensorModule::poll_sensors_now() {
     ESP_LOGI(TAG, "Forcing immediate sensor poll");
-    update();
+    if (!initialized_) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    // Out-of-schedule reads, the wheel keeps its due times
+    for (auto& sensor : sensors_) {
+        start_sensor_read(sensor);
+    }
     return ESP_OK;
 }
 
@@ -0,0 +1,273 @@
+/**
+ * @file signal_pipeline.cpp
+ * @brief Implementation of the per-sensor filter chain
+ */
+
+#include "signal_pipeline.h"
+#include <esp_log.h>
+#include <esp_cpu.h>
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+static const char* TAG = "SignalPipeline";
+
+esp_err_t SignalPipeline::configure(const nlohmann::json& filters) {
+    stage_count_ = 0;
+    reset();
+
+    if (!filters.is_array()) {
+        ESP_LOGE(TAG, "'filters' must be an array");
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (filters.size() > MAX_STAGES) {
+        ESP_LOGE(TAG, "Too many filter stages: %zu (max %zu)", filters.size(), MAX_STAGES);
+        return ESP_ERR_NO_MEM;
+    }
+
+    size_t count = 0;
+    for (const auto& config : filters) {
+        Stage stage = {};
+        esp_err_t ret = compile_stage(config, stage);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+        stages_[count++] = stage;
+    }
+
+    stage_count_ = count;
+    return ESP_OK;
+}
+
+esp_err_t SignalPipeline::compile_stage(const nlohmann::json& config, Stage& stage) {
+    if (!config.is_object() || !config.contains("type") || !config["type"].is_string()) {
+        ESP_LOGE(TAG, "Filter stage needs a 'type' string");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    std::string type = config["type"].get<std::string>();
+
+    if (type == "median") {
+        int window = config.value("window", 5);
+        if (window < 1 || window > static_cast<int>(MAX_MEDIAN_WINDOW)) {
+            ESP_LOGE(TAG, "Median window %d out of range 1..%zu", window, MAX_MEDIAN_WINDOW);
+            return ESP_ERR_INVALID_ARG;
+        }
+        stage.type = StageType::MEDIAN;
+        stage.process = run_median;
+        stage.state.median.size = static_cast<uint8_t>(window);
+    } else if (type == "ema") {
+        float alpha = config.value("alpha", 0.3f);
+        if (alpha <= 0.0f || alpha > 1.0f) {
+            ESP_LOGE(TAG, "EMA alpha %.3f out of range (0, 1]", alpha);
+            return ESP_ERR_INVALID_ARG;
+        }
+        stage.type = StageType::EMA;
+        stage.process = run_ema;
+        stage.param[0] = alpha;
+    } else if (type == "kalman") {
+        float process_noise = config.value("process_noise", 0.01f);
+        float measurement_noise = config.value("measurement_noise", 0.5f);
+        if (process_noise < 0.0f || measurement_noise <= 0.0f) {
+            ESP_LOGE(TAG, "Kalman noise must be positive");
+            return ESP_ERR_INVALID_ARG;
+        }
+        stage.type = StageType::KALMAN;
+        stage.process = run_kalman;
+        stage.param[0] = process_noise;
+        stage.param[1] = measurement_noise;
+    } else if (type == "rate_limit") {
+        float max_rate = config.value("max_rate", 1.0f);
+        if (max_rate <= 0.0f) {
+            ESP_LOGE(TAG, "rate_limit max_rate must be positive");
+            return ESP_ERR_INVALID_ARG;
+        }
+        stage.type = StageType::RATE_LIMIT;
+        stage.process = run_rate_limit;
+        stage.param[0] = max_rate;
+    } else if (type == "spike") {
+        float threshold = config.value("threshold", 5.0f);
+        int max_rejects = config.value("max_rejects", 3);
+        if (threshold <= 0.0f || max_rejects < 0) {
+            ESP_LOGE(TAG, "Invalid spike filter parameters");
+            return ESP_ERR_INVALID_ARG;
+        }
+        stage.type = StageType::SPIKE;
+        stage.process = run_spike;
+        stage.param[0] = threshold;
+        stage.param[1] = static_cast<float>(max_rejects);
+    } else if (type == "deadband") {
+        float delta = config.value("delta", 0.1f);
+        if (delta < 0.0f) {
+            ESP_LOGE(TAG, "deadband delta must not be negative");
+            return ESP_ERR_INVALID_ARG;
+        }
+        stage.type = StageType::DEADBAND;
+        stage.process = run_deadband;
+        stage.param[0] = delta;
+    } else {
+        ESP_LOGE(TAG, "Unknown filter stage: %s", type.c_str());
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    return ESP_OK;
+}
+
+SignalPipeline::Verdict SignalPipeline::process(float& value, uint32_t now_ms) {
+    // dt from the last accepted sample: a rejected spike must not
+    // shorten the interval rate_limit sees next
+    uint32_t dt_ms = has_sample_ ? now_ms - last_sample_ms_ : 0;
+
+    Verdict verdict = Verdict::PUBLISH;
+    for (size_t i = 0; i < stage_count_; i++) {
+        Stage& stage = stages_[i];
+
+        uint32_t start = esp_cpu_get_cycle_count();
+        Verdict result = stage.process(stage, value, dt_ms);
+        stage.cycles += esp_cpu_get_cycle_count() - start;
+        stage.calls++;
+
+        if (result == Verdict::DROP) {
+            return Verdict::DROP;
+        }
+        if (result == Verdict::SUPPRESS) {
+            verdict = Verdict::SUPPRESS;
+        }
+    }
+
+    last_sample_ms_ = now_ms;
+    has_sample_ = true;
+    return verdict;
+}
+
+void SignalPipeline::reset() {
+    for (size_t i = 0; i < stage_count_; i++) {
+        Stage& stage = stages_[i];
+        stage.primed = false;
+        if (stage.type == StageType::MEDIAN) {
+            stage.state.median.head = 0;
+            stage.state.median.count = 0;
+        } else {
+            stage.state.scalar = {};
+        }
+    }
+    has_sample_ = false;
+}
+
+nlohmann::json SignalPipeline::get_stats() const {
+    nlohmann::json stats = nlohmann::json::array();
+    for (size_t i = 0; i < stage_count_; i++) {
+        const Stage& stage = stages_[i];
+        stats.push_back({
+            {"type", type_to_string(stage.type)},
+            {"calls", stage.calls},
+            {"avg_cycles", stage.calls ? static_cast<uint32_t>(stage.cycles / stage.calls) : 0}
+        });
+    }
+    return stats;
+}
+
+const char* SignalPipeline::type_to_string(StageType type) {
+    switch (type) {
+        case StageType::MEDIAN: return "median";
+        case StageType::EMA: return "ema";
+        case StageType::KALMAN: return "kalman";
+        case StageType::RATE_LIMIT: return "rate_limit";
+        case StageType::SPIKE: return "spike";
+        case StageType::DEADBAND: return "deadband";
+    }
+    return "unknown";
+}
+
+// === Stages ===
+
+SignalPipeline::Verdict SignalPipeline::run_median(Stage& stage, float& value, uint32_t) {
+    auto& median = stage.state.median;
+    median.window[median.head] = value;
+    median.head = (median.head + 1) % median.size;
+    if (median.count < median.size) {
+        median.count++;
+    }
+
+    // Insertion sort of a copy - the window is at most 9 samples
+    float sorted[MAX_MEDIAN_WINDOW];
+    for (uint8_t i = 0; i < median.count; i++) {
+        float sample = median.window[i];
+        int j = i - 1;
+        while (j >= 0 && sorted[j] > sample) {
+            sorted[j + 1] = sorted[j];
+            j--;
+        }
+        sorted[j + 1] = sample;
+    }
+
+    value = (median.count & 1) ? sorted[median.count / 2]
+                               : (sorted[median.count / 2 - 1] + sorted[median.count / 2]) * 0.5f;
+    return Verdict::PUBLISH;
+}
+
+SignalPipeline::Verdict SignalPipeline::run_ema(Stage& stage, float& value, uint32_t) {
+    auto& state = stage.state.scalar;
+    if (!stage.primed) {
+        state.value = value;
+        stage.primed = true;
+    } else {
+        state.value += stage.param[0] * (value - state.value);
+    }
+    value = state.value;
+    return Verdict::PUBLISH;
+}
+
+SignalPipeline::Verdict SignalPipeline::run_kalman(Stage& stage, float& value, uint32_t) {
+    // Constant-level model: x = x, z = x + noise
+    auto& state = stage.state.scalar;
+    if (!stage.primed) {
+        state.value = value;
+        state.error = stage.param[1];
+        stage.primed = true;
+        return Verdict::PUBLISH;
+    }
+
+    state.error += stage.param[0];
+    float gain = state.error / (state.error + stage.param[1]);
+    state.value += gain * (value - state.value);
+    state.error *= (1.0f - gain);
+    value = state.value;
+    return Verdict::PUBLISH;
+}
+
+SignalPipeline::Verdict SignalPipeline::run_rate_limit(Stage& stage, float& value, uint32_t dt_ms) {
+    auto& state = stage.state.scalar;
+    if (stage.primed) {
+        float max_step = stage.param[0] * dt_ms / 1000.0f;
+        value = std::min(std::max(value, state.value - max_step), state.value + max_step);
+    }
+    state.value = value;
+    stage.primed = true;
+    return Verdict::PUBLISH;
+}
+
+SignalPipeline::Verdict SignalPipeline::run_spike(Stage& stage, float& value, uint32_t) {
+    auto& state = stage.state.scalar;
+    if (stage.primed && std::fabs(value - state.value) > stage.param[0]) {
+        // A real step persists - accept the new level after max_rejects samples
+        if (state.rejects < static_cast<uint32_t>(stage.param[1])) {
+            state.rejects++;
+            return Verdict::DROP;
+        }
+    }
+    state.rejects = 0;
+    state.value = value;
+    stage.primed = true;
+    return Verdict::PUBLISH;
+}
+
+SignalPipeline::Verdict SignalPipeline::run_deadband(Stage& stage, float& value, uint32_t) {
+    auto& state = stage.state.scalar;
+    if (stage.primed && std::fabs(value - state.value) < stage.param[0]) {
+        return Verdict::SUPPRESS;
+    }
+    state.value = value;
+    stage.primed = true;
+    return Verdict::PUBLISH;
+}
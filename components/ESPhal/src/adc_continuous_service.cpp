@@ -0,0 +1,221 @@
+/**
+ * @file adc_continuous_service.cpp
+ * @brief Implementation of continuous-mode ADC service
+ */
+
+#include "adc_continuous_service.h"
+#include <esp_log.h>
+#include <esp_attr.h>
+#include <cstring>
+
+static const char* TAG = "AdcContinuous";
+
+// Result format of the digital controller differs between targets
+#if CONFIG_IDF_TARGET_ESP32 || CONFIG_IDF_TARGET_ESP32S2
+#define ADC_OUTPUT_TYPE         ADC_DIGI_OUTPUT_FORMAT_TYPE1
+#define ADC_GET_CHANNEL(p)      ((p)->type1.channel)
+#define ADC_GET_DATA(p)         ((p)->type1.data)
+#else
+#define ADC_OUTPUT_TYPE         ADC_DIGI_OUTPUT_FORMAT_TYPE2
+#define ADC_GET_CHANNEL(p)      ((p)->type2.channel)
+#define ADC_GET_DATA(p)         ((p)->type2.data)
+#endif
+
+static constexpr uint32_t RESULTS_PER_FRAME = 64;
+static constexpr uint32_t FRAME_SIZE = RESULTS_PER_FRAME * SOC_ADC_DIGI_RESULT_BYTES;
+static constexpr uint32_t POOL_FRAMES = 4;
+static constexpr uint32_t TASK_STACK_SIZE = 3072;
+static constexpr UBaseType_t TASK_PRIORITY = 5;
+
+AdcContinuousService::AdcContinuousService(uint32_t sample_freq_hz, uint8_t oversample, uint8_t filter_shift)
+    : sample_freq_hz_(sample_freq_hz)
+    , oversample_(oversample ? oversample : 1)
+    , filter_shift_(filter_shift) {
+    memset(slot_by_channel_, -1, sizeof(slot_by_channel_));
+}
+
+AdcContinuousService::~AdcContinuousService() {
+    stop();
+}
+
+int AdcContinuousService::add_channel(adc_channel_t channel, adc_atten_t attenuation) {
+    if (is_running() || channel < 0 || channel >= MAX_CHANNELS) {
+        return -1;
+    }
+    if (slot_by_channel_[channel] >= 0) {
+        return slot_by_channel_[channel];
+    }
+
+    int index = channel_count_++;
+    Slot& slot = slots_[index];
+    slot.channel = channel;
+    slot.attenuation = attenuation;
+    slot.sum = 0;
+    slot.count = 0;
+    slot.filtered_q4 = -1;
+    slot.value_q4.store(-1, std::memory_order_relaxed);
+    slot.samples.store(0, std::memory_order_relaxed);
+    slot_by_channel_[channel] = index;
+    return index;
+}
+
+esp_err_t AdcContinuousService::start() {
+    if (is_running()) {
+        return ESP_OK;
+    }
+    if (channel_count_ == 0) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    adc_continuous_handle_cfg_t handle_config = {};
+    handle_config.max_store_buf_size = FRAME_SIZE * POOL_FRAMES;
+    handle_config.conv_frame_size = FRAME_SIZE;
+    esp_err_t ret = adc_continuous_new_handle(&handle_config, &handle_);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to create continuous ADC handle: %s", esp_err_to_name(ret));
+        handle_ = nullptr;
+        return ret;
+    }
+
+    // Round-robin pattern over all registered channels
+    adc_digi_pattern_config_t pattern[MAX_CHANNELS] = {};
+    for (size_t i = 0; i < channel_count_; i++) {
+        pattern[i].atten = slots_[i].attenuation;
+        pattern[i].channel = slots_[i].channel;
+        pattern[i].unit = ADC_UNIT_1;
+        pattern[i].bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+    }
+
+    adc_continuous_config_t dig_config = {};
+    dig_config.pattern_num = channel_count_;
+    dig_config.adc_pattern = pattern;
+    dig_config.sample_freq_hz = sample_freq_hz_;
+    dig_config.conv_mode = ADC_CONV_SINGLE_UNIT_1;
+    dig_config.format = ADC_OUTPUT_TYPE;
+    ret = adc_continuous_config(handle_, &dig_config);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to configure continuous ADC: %s", esp_err_to_name(ret));
+        stop();
+        return ret;
+    }
+
+    if (xTaskCreate(task_entry, "adc_cont", TASK_STACK_SIZE, this, TASK_PRIORITY, &task_) != pdPASS) {
+        task_ = nullptr;
+        stop();
+        return ESP_ERR_NO_MEM;
+    }
+
+    adc_continuous_evt_cbs_t callbacks = {};
+    callbacks.on_conv_done = on_conv_done;
+    callbacks.on_pool_ovf = on_pool_ovf;
+    ret = adc_continuous_register_event_callbacks(handle_, &callbacks, this);
+    if (ret == ESP_OK) {
+        ret = adc_continuous_start(handle_);
+    }
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to start continuous ADC: %s", esp_err_to_name(ret));
+        stop();
+        return ret;
+    }
+
+    ESP_LOGI(TAG, "Continuous ADC started: %zu channels, %lu Hz, oversample %u, filter 1/%u",
+             channel_count_, static_cast<unsigned long>(sample_freq_hz_), oversample_, 1u << filter_shift_);
+    return ESP_OK;
+}
+
+void AdcContinuousService::stop() {
+    if (handle_) {
+        adc_continuous_stop(handle_);
+    }
+    if (task_) {
+        vTaskDelete(task_);
+        task_ = nullptr;
+    }
+    if (handle_) {
+        adc_continuous_deinit(handle_);
+        handle_ = nullptr;
+    }
+}
+
+bool AdcContinuousService::latest(int index, int32_t& value_q4) const {
+    if (index < 0 || index >= static_cast<int>(channel_count_)) {
+        return false;
+    }
+    value_q4 = slots_[index].value_q4.load(std::memory_order_relaxed);
+    return value_q4 >= 0;
+}
+
+uint32_t AdcContinuousService::samples(int index) const {
+    if (index < 0 || index >= static_cast<int>(channel_count_)) {
+        return 0;
+    }
+    return slots_[index].samples.load(std::memory_order_relaxed);
+}
+
+void AdcContinuousService::task_entry(void* arg) {
+    static_cast<AdcContinuousService*>(arg)->task_loop();
+}
+
+void AdcContinuousService::task_loop() {
+    uint8_t frame[FRAME_SIZE];
+
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        // Drain everything DMA has completed since the last notification
+        uint32_t length = 0;
+        while (adc_continuous_read(handle_, frame, FRAME_SIZE, &length, 0) == ESP_OK) {
+            process(frame, length);
+            frames_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+void AdcContinuousService::process(const uint8_t* data, uint32_t length) {
+    for (uint32_t i = 0; i + SOC_ADC_DIGI_RESULT_BYTES <= length; i += SOC_ADC_DIGI_RESULT_BYTES) {
+        const adc_digi_output_data_t* result = reinterpret_cast<const adc_digi_output_data_t*>(&data[i]);
+        uint32_t channel = ADC_GET_CHANNEL(result);
+        if (channel >= MAX_CHANNELS || slot_by_channel_[channel] < 0) {
+            continue;
+        }
+        accumulate(slots_[slot_by_channel_[channel]], ADC_GET_DATA(result));
+    }
+}
+
+void AdcContinuousService::accumulate(Slot& slot, uint32_t raw) {
+    slot.sum += raw;
+    if (++slot.count < oversample_) {
+        return;
+    }
+
+    // Mean of the oversampled block in 12.4 fixed point
+    int32_t value = static_cast<int32_t>((slot.sum << FRACTION_BITS) / slot.count);
+    slot.sum = 0;
+    slot.count = 0;
+
+    if (slot.filtered_q4 < 0 || filter_shift_ == 0) {
+        slot.filtered_q4 = value;
+    } else {
+        slot.filtered_q4 += (value - slot.filtered_q4) >> filter_shift_;
+    }
+
+    slot.value_q4.store(slot.filtered_q4, std::memory_order_relaxed);
+    slot.samples.fetch_add(oversample_, std::memory_order_relaxed);
+}
+
+bool IRAM_ATTR AdcContinuousService::on_conv_done(adc_continuous_handle_t handle,
+                                                   const adc_continuous_evt_data_t* edata, void* user_data) {
+    auto* service = static_cast<AdcContinuousService*>(user_data);
+    BaseType_t task_woken = pdFALSE;
+    if (service->task_) {
+        vTaskNotifyGiveFromISR(service->task_, &task_woken);
+    }
+    return task_woken == pdTRUE;
+}
+
+bool IRAM_ATTR AdcContinuousService::on_pool_ovf(adc_continuous_handle_t handle,
+                                                  const adc_continuous_evt_data_t* edata, void* user_data) {
+    auto* service = static_cast<AdcContinuousService*>(user_data);
+    service->overflows_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
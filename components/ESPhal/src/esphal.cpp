@@ -6,6 +6,12 @@
 #include "esphal.h"
 #include "board_config.h"
 #include "onewire_impl.h"
+#include "onewire_rmt.h"
+#include "adc_continuous_service.h"
+#include "gpio_input_service.h"
+#include "pulse_counter_pcnt.h"
+#include "i2c_bus_manager.h"
+#include "sim_hal.h"
 #include <esp_log.h>
 #include <cstring>
 #include <stdexcept>
@@ -24,6 +30,10 @@ static_assert(sizeof(BoardConfig::ONEWIRE_BUSES) > 0,
     "BoardConfig::ONEWIRE_BUSES array must be defined in the board configuration file.");
 static_assert(sizeof(BoardConfig::ADC_CHANNELS) > 0, 
     "BoardConfig::ADC_CHANNELS array must be defined in the board configuration file.");
+static_assert(sizeof(BoardConfig::I2C_BUSES) > 0, 
+    "BoardConfig::I2C_BUSES array must be defined in the board configuration file.");
+static_assert(sizeof(BoardConfig::PULSE_INPUTS) > 0, 
+    "BoardConfig::PULSE_INPUTS array must be defined in the board configuration file.");
 
 static const char* TAG = "ESPhal";
 
@@ -37,6 +47,15 @@ esp_err_t ESPhal::init() {
     
     esp_err_t ret;
     
+#ifdef CONFIG_ESPHAL_SIMULATION
+    ESP_LOGW(TAG, "SIMULATION backend: cold room plant at x%d time scale", CONFIG_ESPHAL_SIM_TIME_SCALE);
+    SimHal::instance().set_time_scale(CONFIG_ESPHAL_SIM_TIME_SCALE);
+    SimHal::instance().with_plant([](ColdRoomPlant& plant) {
+        plant.params().ambient_c = CONFIG_ESPHAL_SIM_AMBIENT_C;
+        plant.reset();
+    });
+#endif
+    
     // Initialize all hardware resources eagerly
     ret = init_gpio_outputs();
     if (ret != ESP_OK) {
@@ -50,6 +69,12 @@ esp_err_t ESPhal::init() {
         return ret;
     }
     
+    ret = init_i2c_buses();
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to initialize I2C buses: %s", esp_err_to_name(ret));
+        return ret;
+    }
+    
     ret = init_onewire_buses();
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "Failed to initialize OneWire buses: %s", esp_err_to_name(ret));
@@ -62,13 +87,21 @@ esp_err_t ESPhal::init() {
         return ret;
     }
     
+    ret = init_pulse_counters();
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to initialize pulse counters: %s", esp_err_to_name(ret));
+        return ret;
+    }
+    
     initialized_ = true;
     
     ESP_LOGI(TAG, "ESPhal initialized successfully:");
     ESP_LOGI(TAG, "  - GPIO outputs: %zu", gpio_outputs_.size());
     ESP_LOGI(TAG, "  - GPIO inputs: %zu", gpio_inputs_.size());
+    ESP_LOGI(TAG, "  - I2C buses: %zu", i2c_buses_.size());
     ESP_LOGI(TAG, "  - OneWire buses: %zu", onewire_buses_.size());
     ESP_LOGI(TAG, "  - ADC channels: %zu", adc_channels_.size());
+    ESP_LOGI(TAG, "  - Pulse counters: %zu", pulse_counters_.size());
     
     // Log available ADC channels
     if (!adc_channels_.empty()) {
@@ -140,6 +173,31 @@ IAdcChannel* ESPhal::get_adc_channel_ptr(const std::string& hal_id) {
     return it->second.get();
 }
 
+IPulseCounter* ESPhal::get_pulse_counter_ptr(const std::string& hal_id) {
+    auto it = pulse_counters_.find(hal_id);
+    if (it == pulse_counters_.end()) {
+        return nullptr;
+    }
+    return it->second.get();
+}
+
+II2CBus* ESPhal::get_i2c_bus_ptr(const std::string& hal_id) {
+    auto it = i2c_buses_.find(hal_id);
+    if (it == i2c_buses_.end()) {
+        return nullptr;
+    }
+    return it->second.get();
+}
+
+II2CDevice* ESPhal::get_i2c_device(const std::string& hal_id, uint8_t address) {
+    II2CBus* bus = get_i2c_bus_ptr(hal_id);
+    if (!bus) {
+        ESP_LOGE(TAG, "I2C bus '%s' not found. Check board configuration.", hal_id.c_str());
+        return nullptr;
+    }
+    return bus->get_device(address);
+}
+
 // Resource existence checking methods
 bool ESPhal::has_gpio_output(const std::string& hal_id) const {
     return gpio_outputs_.find(hal_id) != gpio_outputs_.end();
@@ -157,6 +215,14 @@ bool ESPhal::has_adc_channel(const std::string& hal_id) const {
     return adc_channels_.find(hal_id) != adc_channels_.end();
 }
 
+bool ESPhal::has_pulse_counter(const std::string& hal_id) const {
+    return pulse_counters_.find(hal_id) != pulse_counters_.end();
+}
+
+bool ESPhal::has_i2c_bus(const std::string& hal_id) const {
+    return i2c_buses_.find(hal_id) != i2c_buses_.end();
+}
+
 std::string ESPhal::get_board_info() const {
     return std::string(BoardConfig::BOARD_NAME) + " v" + std::string(BoardConfig::BOARD_VERSION);
 }
@@ -165,6 +231,15 @@ std::string ESPhal::get_board_info() const {
 esp_err_t ESPhal::init_gpio_outputs() {
     ESP_LOGI(TAG, "Initializing GPIO outputs...");
     
+#ifdef CONFIG_ESPHAL_SIMULATION
+    for (size_t i = 0; i < BoardConfig::GPIO_OUTPUTS_COUNT; i++) {
+        const char* hal_id = BoardConfig::GPIO_OUTPUTS[i].hal_id;
+        gpio_outputs_[hal_id] = SimHal::instance().create_gpio_output(hal_id);
+    }
+    ESP_LOGI(TAG, "GPIO outputs simulated: %zu outputs", BoardConfig::GPIO_OUTPUTS_COUNT);
+    return ESP_OK;
+#endif
+    
     for (size_t i = 0; i < BoardConfig::GPIO_OUTPUTS_COUNT; i++) {
         const auto& config = BoardConfig::GPIO_OUTPUTS[i];
         
@@ -183,17 +258,94 @@ esp_err_t ESPhal::init_gpio_outputs() {
     return ESP_OK;
 }
 
+// Polled GPIO input - level read on every get_state()
+class GpioInputImpl : public IGpioInput {
+public:
+    GpioInputImpl(gpio_num_t pin, bool pull_up) : pin_(pin) {
+        gpio_config_t io_config = {};
+        io_config.pin_bit_mask = 1ULL << pin;
+        io_config.mode = GPIO_MODE_INPUT;
+        io_config.pull_up_en = pull_up ? GPIO_PULLUP_ENABLE : GPIO_PULLUP_DISABLE;
+        io_config.pull_down_en = GPIO_PULLDOWN_DISABLE;
+        io_config.intr_type = GPIO_INTR_DISABLE;
+        gpio_config(&io_config);
+    }
+    
+    bool get_state() override {
+        return gpio_get_level(pin_) != 0;
+    }
+    
+private:
+    gpio_num_t pin_;
+};
+
+#ifdef CONFIG_ESPHAL_GPIO_INPUT_INTERRUPTS
+// Shared edge interrupt service for all board inputs
+static std::unique_ptr<GpioInputService> gpio_input_service;
+
+// GPIO input backed by the interrupt service - reads return the debounced level
+class GpioInterruptInput : public IGpioInput {
+public:
+    GpioInterruptInput(GpioInputService& service, int index)
+        : service_(service), index_(index) {}
+    
+    bool get_state() override {
+        return service_.level(index_);
+    }
+    
+    esp_err_t subscribe(ChangeCallback callback, void* context, uint32_t debounce_ms) override {
+        return service_.subscribe(index_, callback, context, debounce_ms);
+    }
+    
+private:
+    GpioInputService& service_;
+    int index_;
+};
+#endif
+
 esp_err_t ESPhal::init_gpio_inputs() {
     ESP_LOGI(TAG, "Initializing GPIO inputs...");
     
+#ifdef CONFIG_ESPHAL_SIMULATION
+    for (size_t i = 0; i < BoardConfig::GPIO_INPUTS_COUNT; i++) {
+        const char* hal_id = BoardConfig::GPIO_INPUTS[i].hal_id;
+        gpio_inputs_[hal_id] = SimHal::instance().create_gpio_input(hal_id);
+    }
+    ESP_LOGI(TAG, "GPIO inputs simulated: %zu inputs", BoardConfig::GPIO_INPUTS_COUNT);
+    return ESP_OK;
+#endif
+    
+#ifdef CONFIG_ESPHAL_GPIO_INPUT_INTERRUPTS
+    // All inputs share one ISR ring and service task; polled if that fails
+    int service_index[BoardConfig::GPIO_INPUTS_COUNT];
+    gpio_input_service = std::make_unique<GpioInputService>(CONFIG_ESPHAL_GPIO_DEBOUNCE_MS);
+    for (size_t i = 0; i < BoardConfig::GPIO_INPUTS_COUNT; i++) {
+        const auto& config = BoardConfig::GPIO_INPUTS[i];
+        service_index[i] = gpio_input_service->add_input(config.pin, config.pull_up);
+    }
+    
+    esp_err_t ret = gpio_input_service->start();
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "GPIO input interrupts unavailable (%s), using polled inputs", esp_err_to_name(ret));
+        gpio_input_service.reset();
+    }
+#endif
+    
     for (size_t i = 0; i < BoardConfig::GPIO_INPUTS_COUNT; i++) {
         const auto& config = BoardConfig::GPIO_INPUTS[i];
         
         ESP_LOGD(TAG, "  Creating GPIO input: %s on pin %d", config.hal_id, config.pin);
         
-        // TODO: Create actual GpioInputImpl when we implement it
-        // auto gpio_input = std::make_unique<GpioInputImpl>(config.pin, config.pull_up);
-        // gpio_inputs_[config.hal_id] = std::move(gpio_input);
+        std::unique_ptr<IGpioInput> gpio_input;
+#ifdef CONFIG_ESPHAL_GPIO_INPUT_INTERRUPTS
+        if (gpio_input_service && service_index[i] >= 0) {
+            gpio_input = std::make_unique<GpioInterruptInput>(*gpio_input_service, service_index[i]);
+        }
+#endif
+        if (!gpio_input) {
+            gpio_input = std::make_unique<GpioInputImpl>(config.pin, config.pull_up);
+        }
+        gpio_inputs_[config.hal_id] = std::move(gpio_input);
         
         ESP_LOGD(TAG, "    %s - Pin: %d, Pull-up: %s", 
                 config.hal_id, config.pin, config.pull_up ? "YES" : "NO");
@@ -203,16 +355,68 @@ esp_err_t ESPhal::init_gpio_inputs() {
     return ESP_OK;
 }
 
+esp_err_t ESPhal::init_i2c_buses() {
+    ESP_LOGI(TAG, "Initializing I2C buses...");
+    
+#ifdef CONFIG_ESPHAL_SIMULATION
+    // The plant model has no I2C devices
+    ESP_LOGI(TAG, "I2C buses not simulated");
+    return ESP_OK;
+#endif
+    
+    for (size_t i = 0; i < BoardConfig::I2C_BUSES_COUNT; i++) {
+        const auto& config = BoardConfig::I2C_BUSES[i];
+        
+        ESP_LOGD(TAG, "  Creating I2C bus: %s on SCL %d, SDA %d", config.hal_id, config.scl_pin, config.sda_pin);
+        
+        auto bus = std::make_unique<I2CBusManager>(config.port, config.scl_pin, config.sda_pin, config.frequency,
+                                                   CONFIG_ESPHAL_I2C_TIMEOUT_MS, CONFIG_ESPHAL_I2C_QUEUE_DEPTH);
+        esp_err_t ret = bus->init();
+        if (ret != ESP_OK) {
+            ESP_LOGW(TAG, "I2C bus %s unavailable: %s", config.hal_id, esp_err_to_name(ret));
+            continue;
+        }
+        i2c_buses_[config.hal_id] = std::move(bus);
+    }
+    
+    ESP_LOGI(TAG, "I2C buses initialized: %zu buses", i2c_buses_.size());
+    return ESP_OK;
+}
+
 esp_err_t ESPhal::init_onewire_buses() {
     ESP_LOGI(TAG, "Initializing OneWire buses...");
     
+#ifdef CONFIG_ESPHAL_SIMULATION
+    for (size_t i = 0; i < BoardConfig::ONEWIRE_BUSES_COUNT; i++) {
+        const char* hal_id = BoardConfig::ONEWIRE_BUSES[i].hal_id;
+        onewire_buses_[hal_id] = SimHal::instance().create_onewire_bus(hal_id);
+    }
+    ESP_LOGI(TAG, "OneWire buses simulated: %zu buses", BoardConfig::ONEWIRE_BUSES_COUNT);
+    return ESP_OK;
+#endif
+    
     for (size_t i = 0; i < BoardConfig::ONEWIRE_BUSES_COUNT; i++) {
         const auto& config = BoardConfig::ONEWIRE_BUSES[i];
         
         ESP_LOGD(TAG, "  Creating OneWire bus: %s on pin %d", config.hal_id, config.data_pin);
         
         // Create actual OneWire bus implementation
-        auto onewire_bus = std::make_unique<OneWireBusImpl>(config.data_pin, config.power_pin);
+        std::unique_ptr<IOneWireBus> onewire_bus;
+#if SOC_RMT_SUPPORTED
+        if (config.driver == OneWireDriver::RMT) {
+            auto rmt_bus = std::make_unique<OneWireRmtBus>(config.data_pin, config.power_pin);
+            esp_err_t ret = rmt_bus->init();
+            if (ret == ESP_OK) {
+                onewire_bus = std::move(rmt_bus);
+            } else {
+                ESP_LOGW(TAG, "  RMT unavailable for %s (%s), using GPIO driver",
+                         config.hal_id, esp_err_to_name(ret));
+            }
+        }
+#endif
+        if (!onewire_bus) {
+            onewire_bus = std::make_unique<OneWireBusImpl>(config.data_pin, config.power_pin);
+        }
         onewire_buses_[config.hal_id] = std::move(onewire_bus);
         
         ESP_LOGD(TAG, "    %s - Data pin: %d, Power pin: %d", 
@@ -307,17 +511,99 @@ private:
     std::string id_;
 };
 
+#ifdef CONFIG_ESPHAL_ADC_CONTINUOUS
+// Shared continuous-mode sampler for all ADC1 channels
+static std::unique_ptr<AdcContinuousService> adc_service;
+
+// ADC channel backed by the continuous service - reads never touch the ADC
+class AdcContinuousChannel : public IAdcChannel {
+public:
+    AdcContinuousChannel(AdcContinuousService& service, int index)
+        : service_(service), index_(index) {}
+    
+    HalResult<int> read_raw() override {
+        int32_t value_q4;
+        if (!service_.latest(index_, value_q4)) {
+            return {0, ESP_ERR_INVALID_STATE};  // No samples yet
+        }
+        // Round to the nearest 12-bit value
+        int half = 1 << (AdcContinuousService::FRACTION_BITS - 1);
+        return {(value_q4 + half) >> AdcContinuousService::FRACTION_BITS, ESP_OK};
+    }
+    
+    HalResult<int> read_voltage_mv() override {
+        auto raw = read_raw();
+        if (raw.is_ok()) {
+            // Same linear conversion as the oneshot channel
+            return {(raw.value * 3300) / 4095, ESP_OK};
+        }
+        return {0, raw.error};
+    }
+    
+    HalResult<float> read_filtered() override {
+        int32_t value_q4;
+        if (!service_.latest(index_, value_q4)) {
+            return {0.0f, ESP_ERR_INVALID_STATE};
+        }
+        return {value_q4 / static_cast<float>(1 << AdcContinuousService::FRACTION_BITS), ESP_OK};
+    }
+    
+    bool is_continuous() const override { return true; }
+    
+private:
+    AdcContinuousService& service_;
+    int index_;
+};
+#endif
+
 esp_err_t ESPhal::init_adc_channels() {
     ESP_LOGI(TAG, "Initializing ADC channels...");
     
+#ifdef CONFIG_ESPHAL_SIMULATION
+    for (size_t i = 0; i < BoardConfig::ADC_CHANNELS_COUNT; i++) {
+        const char* hal_id = BoardConfig::ADC_CHANNELS[i].hal_id;
+        adc_channels_[hal_id] = SimHal::instance().create_adc_channel(hal_id);
+    }
+    ESP_LOGI(TAG, "ADC channels simulated: %zu channels", BoardConfig::ADC_CHANNELS_COUNT);
+    return ESP_OK;
+#endif
+    
+#ifdef CONFIG_ESPHAL_ADC_CONTINUOUS
+    // ADC1 channels go to one DMA round-robin; ADC2 and fallback stay oneshot
+    int continuous_index[BoardConfig::ADC_CHANNELS_COUNT];
+    adc_service = std::make_unique<AdcContinuousService>(CONFIG_ESPHAL_ADC_CONTINUOUS_SAMPLE_HZ,
+                                                         CONFIG_ESPHAL_ADC_SAMPLES,
+                                                         CONFIG_ESPHAL_ADC_FILTER_SHIFT);
+    for (size_t i = 0; i < BoardConfig::ADC_CHANNELS_COUNT; i++) {
+        const auto& config = BoardConfig::ADC_CHANNELS[i];
+        continuous_index[i] = (config.unit == ADC_UNIT_1)
+            ? adc_service->add_channel(config.channel, config.attenuation)
+            : -1;
+    }
+    
+    esp_err_t ret = adc_service->start();
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Continuous ADC unavailable (%s), using oneshot reads", esp_err_to_name(ret));
+        adc_service.reset();
+    }
+#endif
+    
     for (size_t i = 0; i < BoardConfig::ADC_CHANNELS_COUNT; i++) {
         const auto& config = BoardConfig::ADC_CHANNELS[i];
         
         ESP_LOGD(TAG, "  Creating ADC channel: %s on ADC%d_CH%d", 
                 config.hal_id, config.unit, config.channel);
         
-        // Create real ADC channel
-        auto adc_channel = std::make_unique<AdcChannelImpl>(config.unit, config.channel, config.attenuation, config.hal_id);
+        std::unique_ptr<IAdcChannel> adc_channel;
+#ifdef CONFIG_ESPHAL_ADC_CONTINUOUS
+        if (adc_service && continuous_index[i] >= 0) {
+            adc_channel = std::make_unique<AdcContinuousChannel>(*adc_service, continuous_index[i]);
+        }
+#endif
+        if (!adc_channel) {
+            // Create real ADC channel
+            adc_channel = std::make_unique<AdcChannelImpl>(config.unit, config.channel, config.attenuation, config.hal_id);
+        }
         adc_channels_[config.hal_id] = std::move(adc_channel);
         
         ESP_LOGD(TAG, "    %s - Unit: %d, Channel: %d, Atten: %d", 
@@ -327,3 +613,39 @@ esp_err_t ESPhal::init_adc_channels() {
     ESP_LOGI(TAG, "ADC channels initialized: %zu channels", BoardConfig::ADC_CHANNELS_COUNT);
     return ESP_OK;
 }
+
+esp_err_t ESPhal::init_pulse_counters() {
+    ESP_LOGI(TAG, "Initializing pulse counters...");
+    
+#ifdef CONFIG_ESPHAL_SIMULATION
+    for (size_t i = 0; i < BoardConfig::PULSE_INPUTS_COUNT; i++) {
+        const char* hal_id = BoardConfig::PULSE_INPUTS[i].hal_id;
+        pulse_counters_[hal_id] = SimHal::instance().create_pulse_counter(hal_id);
+    }
+    ESP_LOGI(TAG, "Pulse counters simulated: %zu inputs", BoardConfig::PULSE_INPUTS_COUNT);
+    return ESP_OK;
+#endif
+    
+#if SOC_PCNT_SUPPORTED
+    for (size_t i = 0; i < BoardConfig::PULSE_INPUTS_COUNT; i++) {
+        const auto& config = BoardConfig::PULSE_INPUTS[i];
+        
+        ESP_LOGD(TAG, "  Creating pulse counter: %s on pin %d", config.hal_id, config.pin);
+        
+        // Each input takes one PCNT unit; inputs beyond the unit count are skipped
+        auto counter = std::make_unique<PcntPulseCounter>(config.pin, config.glitch_ns, config.pull_up,
+                                                          CONFIG_ESPHAL_PULSE_GATE_MS);
+        esp_err_t ret = counter->init();
+        if (ret != ESP_OK) {
+            ESP_LOGW(TAG, "Pulse input %s unavailable: %s", config.hal_id, esp_err_to_name(ret));
+            continue;
+        }
+        pulse_counters_[config.hal_id] = std::move(counter);
+    }
+#else
+    ESP_LOGW(TAG, "PCNT not supported on this chip, pulse inputs disabled");
+#endif
+    
+    ESP_LOGI(TAG, "Pulse counters initialized: %zu inputs", pulse_counters_.size());
+    return ESP_OK;
+}
@@ -0,0 +1,255 @@
+/**
+ * @file gpio_input_service.cpp
+ * @brief Implementation of interrupt-driven GPIO input service
+ */
+
+#include "gpio_input_service.h"
+#include <esp_log.h>
+#include <esp_attr.h>
+#include <algorithm>
+
+static const char* TAG = "GpioInputs";
+
+static constexpr uint32_t TASK_STACK_SIZE = 2560;
+static constexpr UBaseType_t TASK_PRIORITY = 10;
+static constexpr uint32_t MIN_DEBOUNCE_US = 1000;
+
+GpioInputService::GpioInputService(uint32_t debounce_ms)
+    : debounce_us_(std::max(debounce_ms * 1000, MIN_DEBOUNCE_US)) {
+}
+
+GpioInputService::~GpioInputService() {
+    stop();
+}
+
+int GpioInputService::add_input(gpio_num_t pin, bool pull_up) {
+    if (is_running() || input_count_ >= MAX_INPUTS) {
+        return -1;
+    }
+
+    int index = input_count_++;
+    Input& input = inputs_[index];
+    input.owner = this;
+    input.pin = pin;
+    input.pull_up = pull_up;
+    input.index = static_cast<uint8_t>(index);
+    input.timer = nullptr;
+    input.debounce_us = debounce_us_;
+    input.last_edge_us.store(0, std::memory_order_relaxed);
+    input.level.store(false, std::memory_order_relaxed);
+    input.edges.store(0, std::memory_order_relaxed);
+    input.callback = nullptr;
+    input.context = nullptr;
+    return index;
+}
+
+esp_err_t GpioInputService::start() {
+    if (is_running()) {
+        return ESP_OK;
+    }
+    if (input_count_ == 0) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    callback_mutex_ = xSemaphoreCreateMutex();
+    if (!callback_mutex_) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    // Task must exist before the first edge can notify it
+    if (xTaskCreate(task_entry, "gpio_in", TASK_STACK_SIZE, this, TASK_PRIORITY, &task_) != pdPASS) {
+        task_ = nullptr;
+        stop();
+        return ESP_ERR_NO_MEM;
+    }
+
+    // The ISR service may already be installed by another component
+    esp_err_t ret = gpio_install_isr_service(0);
+    if (ret == ESP_OK) {
+        isr_service_installed_ = true;
+    } else if (ret != ESP_ERR_INVALID_STATE) {
+        ESP_LOGE(TAG, "Failed to install GPIO ISR service: %s", esp_err_to_name(ret));
+        stop();
+        return ret;
+    }
+
+    for (size_t i = 0; i < input_count_; i++) {
+        Input& input = inputs_[i];
+
+        gpio_config_t io_config = {};
+        io_config.pin_bit_mask = 1ULL << input.pin;
+        io_config.mode = GPIO_MODE_INPUT;
+        io_config.pull_up_en = input.pull_up ? GPIO_PULLUP_ENABLE : GPIO_PULLUP_DISABLE;
+        io_config.pull_down_en = GPIO_PULLDOWN_DISABLE;
+        io_config.intr_type = GPIO_INTR_ANYEDGE;
+        ret = gpio_config(&io_config);
+
+        if (ret == ESP_OK) {
+            esp_timer_create_args_t timer_args = {};
+            timer_args.callback = on_debounce;
+            timer_args.arg = &input;
+            timer_args.dispatch_method = ESP_TIMER_TASK;
+            timer_args.name = "gpio_debounce";
+            ret = esp_timer_create(&timer_args, &input.timer);
+        }
+
+        if (ret == ESP_OK) {
+            input.level.store(gpio_get_level(input.pin) != 0, std::memory_order_relaxed);
+            ret = gpio_isr_handler_add(input.pin, on_edge, &input);
+        }
+
+        if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to set up input on GPIO%d: %s", input.pin, esp_err_to_name(ret));
+            stop();
+            return ret;
+        }
+    }
+
+    ESP_LOGI(TAG, "GPIO input interrupts started: %zu inputs, debounce %lu ms",
+             input_count_, static_cast<unsigned long>(debounce_us_ / 1000));
+    return ESP_OK;
+}
+
+void GpioInputService::stop() {
+    for (size_t i = 0; i < input_count_; i++) {
+        Input& input = inputs_[i];
+        gpio_isr_handler_remove(input.pin);
+        gpio_set_intr_type(input.pin, GPIO_INTR_DISABLE);
+        if (input.timer) {
+            esp_timer_stop(input.timer);
+            esp_timer_delete(input.timer);
+            input.timer = nullptr;
+        }
+    }
+    if (isr_service_installed_) {
+        gpio_uninstall_isr_service();
+        isr_service_installed_ = false;
+    }
+    if (task_) {
+        vTaskDelete(task_);
+        task_ = nullptr;
+    }
+    if (callback_mutex_) {
+        vSemaphoreDelete(callback_mutex_);
+        callback_mutex_ = nullptr;
+    }
+}
+
+bool GpioInputService::level(int index) const {
+    if (index < 0 || index >= static_cast<int>(input_count_)) {
+        return false;
+    }
+    return inputs_[index].level.load(std::memory_order_relaxed);
+}
+
+uint32_t GpioInputService::edges(int index) const {
+    if (index < 0 || index >= static_cast<int>(input_count_)) {
+        return 0;
+    }
+    return inputs_[index].edges.load(std::memory_order_relaxed);
+}
+
+esp_err_t GpioInputService::subscribe(int index, Callback callback, void* context, uint32_t debounce_ms) {
+    if (index < 0 || index >= static_cast<int>(input_count_) || !callback_mutex_) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    // Taking the mutex also waits for a callback running in the timer task
+    Input& input = inputs_[index];
+    xSemaphoreTake(callback_mutex_, portMAX_DELAY);
+    input.callback = callback;
+    input.context = context;
+    if (debounce_ms > 0) {
+        input.debounce_us = std::max(debounce_ms * 1000, MIN_DEBOUNCE_US);
+    }
+    xSemaphoreGive(callback_mutex_);
+    return ESP_OK;
+}
+
+void IRAM_ATTR GpioInputService::on_edge(void* arg) {
+    auto* input = static_cast<Input*>(arg);
+    GpioInputService* service = input->owner;
+
+    uint32_t head = service->head_.load(std::memory_order_relaxed);
+    if (head - service->tail_.load(std::memory_order_acquire) < QUEUE_SIZE) {
+        Edge& edge = service->queue_[head & (QUEUE_SIZE - 1)];
+        edge.index = input->index;
+        edge.time_us = static_cast<uint32_t>(esp_timer_get_time());
+        service->head_.store(head + 1, std::memory_order_release);
+    } else {
+        service->overflows_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    BaseType_t task_woken = pdFALSE;
+    vTaskNotifyGiveFromISR(service->task_, &task_woken);
+    if (task_woken == pdTRUE) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+void GpioInputService::task_entry(void* arg) {
+    static_cast<GpioInputService*>(arg)->task_loop();
+}
+
+void GpioInputService::task_loop() {
+    uint32_t seen_overflows = 0;
+
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        // Drain the ring, re-arming each bouncing input's timer once
+        uint32_t touched = 0;
+        uint32_t tail = tail_.load(std::memory_order_relaxed);
+        uint32_t head = head_.load(std::memory_order_acquire);
+        for (; tail != head; tail++) {
+            const Edge& edge = queue_[tail & (QUEUE_SIZE - 1)];
+            Input& input = inputs_[edge.index];
+            input.last_edge_us.store(edge.time_us, std::memory_order_relaxed);
+            input.edges.fetch_add(1, std::memory_order_relaxed);
+            touched |= 1u << edge.index;
+        }
+        tail_.store(tail, std::memory_order_release);
+
+        // Lost edges: re-sample every input once it has settled
+        uint32_t overflows = overflows_.load(std::memory_order_relaxed);
+        if (overflows != seen_overflows) {
+            seen_overflows = overflows;
+            touched = (1u << input_count_) - 1;
+            ESP_LOGW(TAG, "Edge queue overflow, resynchronizing inputs");
+        }
+
+        for (size_t i = 0; touched; i++, touched >>= 1) {
+            if (touched & 1) {
+                arm(inputs_[i]);
+            }
+        }
+    }
+}
+
+void GpioInputService::arm(Input& input) {
+    esp_timer_stop(input.timer);    // Not running is fine
+    esp_timer_start_once(input.timer, input.debounce_us);
+}
+
+void GpioInputService::on_debounce(void* arg) {
+    auto* input = static_cast<Input*>(arg);
+    GpioInputService* service = input->owner;
+
+    // Level stable for the debounce time - compare with the reported one
+    bool level = gpio_get_level(input->pin) != 0;
+    if (level == input->level.load(std::memory_order_relaxed)) {
+        return;     // Bounced back
+    }
+    input->level.store(level, std::memory_order_relaxed);
+
+    // Report the change at the time of its last edge
+    int64_t now_us = esp_timer_get_time();
+    uint32_t age_us = static_cast<uint32_t>(now_us) - input->last_edge_us.load(std::memory_order_relaxed);
+    uint32_t timestamp_ms = static_cast<uint32_t>((now_us - age_us) / 1000);
+
+    xSemaphoreTake(service->callback_mutex_, portMAX_DELAY);
+    if (input->callback) {
+        input->callback(input->context, level, timestamp_ms);
+    }
+    xSemaphoreGive(service->callback_mutex_);
+}
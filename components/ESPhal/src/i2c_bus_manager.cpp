@@ -0,0 +1,289 @@
+/**
+ * @file i2c_bus_manager.cpp
+ * @brief Implementation of the queued I2C bus manager
+ */
+
+#include "i2c_bus_manager.h"
+#include <esp_log.h>
+#include <cstring>
+
+static const char* TAG = "I2CBus";
+
+static constexpr uint32_t TASK_STACK_SIZE = 3072;
+static constexpr UBaseType_t TASK_PRIORITY = 5;
+
+// 7-bit addresses outside the reserved ranges
+static constexpr uint8_t FIRST_ADDRESS = 0x08;
+static constexpr uint8_t LAST_ADDRESS = 0x77;
+
+/**
+ * @brief Device handle: new-driver device plus access to the bus queue
+ */
+class I2CBusManager::Device : public II2CDevice {
+public:
+    Device(I2CBusManager& bus, uint8_t address, i2c_master_dev_handle_t handle)
+        : bus_(bus), address_(address), handle_(handle) {}
+
+    ~Device() override {
+        i2c_master_bus_rm_device(handle_);
+    }
+
+    uint8_t address() const override { return address_; }
+
+    esp_err_t submit(const I2CTransfer* transfers, size_t count,
+                     I2CCompletion callback, void* context) override {
+        Request request = {};
+        esp_err_t ret = fill(request, transfers, count);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+        request.callback = callback;
+        request.context = context;
+        return bus_.enqueue(request, 0);
+    }
+
+    esp_err_t transfer(const I2CTransfer* transfers, size_t count) override {
+        Request request = {};
+        esp_err_t ret = fill(request, transfers, count);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+        return bus_.run_sync(request);
+    }
+
+    i2c_master_dev_handle_t handle() const { return handle_; }
+
+private:
+    esp_err_t fill(Request& request, const I2CTransfer* transfers, size_t count) {
+        if (!transfers || count == 0 || count > MAX_BATCH) {
+            return ESP_ERR_INVALID_ARG;
+        }
+        request.op = Op::TRANSFER;
+        request.device = this;
+        request.count = static_cast<uint8_t>(count);
+        memcpy(request.transfers, transfers, count * sizeof(I2CTransfer));
+        return ESP_OK;
+    }
+
+    I2CBusManager& bus_;
+    uint8_t address_;
+    i2c_master_dev_handle_t handle_;
+};
+
+I2CBusManager::I2CBusManager(int port, gpio_num_t scl_pin, gpio_num_t sda_pin, uint32_t frequency_hz,
+                             uint32_t timeout_ms, size_t queue_depth)
+    : port_(port), scl_pin_(scl_pin), sda_pin_(sda_pin), frequency_hz_(frequency_hz),
+      timeout_ms_(timeout_ms), queue_depth_(queue_depth) {
+}
+
+I2CBusManager::~I2CBusManager() {
+    if (task_) {
+        // Queued transactions complete before the task exits
+        Request request = {};
+        request.op = Op::STOP;
+        run_sync(request);
+    }
+    devices_.clear();
+    if (bus_) {
+        i2c_del_master_bus(bus_);
+    }
+    if (queue_) {
+        vQueueDelete(queue_);
+    }
+    if (devices_mutex_) {
+        vSemaphoreDelete(devices_mutex_);
+    }
+}
+
+esp_err_t I2CBusManager::init() {
+    i2c_master_bus_config_t bus_config = {};
+    bus_config.i2c_port = port_;
+    bus_config.scl_io_num = scl_pin_;
+    bus_config.sda_io_num = sda_pin_;
+    bus_config.clk_source = I2C_CLK_SRC_DEFAULT;
+    bus_config.glitch_ignore_cnt = 7;
+    bus_config.flags.enable_internal_pullup = true;
+    esp_err_t ret = i2c_new_master_bus(&bus_config, &bus_);
+    if (ret != ESP_OK) {
+        bus_ = nullptr;
+        ESP_LOGE(TAG, "Failed to create I2C%d master bus: %s", port_, esp_err_to_name(ret));
+        return ret;
+    }
+
+    devices_mutex_ = xSemaphoreCreateMutex();
+    queue_ = xQueueCreate(queue_depth_, sizeof(Request));
+    if (!devices_mutex_ || !queue_) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    if (xTaskCreate(task_entry, "i2c_bus", TASK_STACK_SIZE, this, TASK_PRIORITY, &task_) != pdPASS) {
+        task_ = nullptr;
+        return ESP_ERR_NO_MEM;
+    }
+
+    ESP_LOGI(TAG, "I2C%d started: SCL=%d SDA=%d, %lu Hz, queue %zu", port_, scl_pin_, sda_pin_,
+             static_cast<unsigned long>(frequency_hz_), queue_depth_);
+    return ESP_OK;
+}
+
+II2CDevice* I2CBusManager::get_device(uint8_t device_addr, uint32_t speed_hz) {
+    if (!bus_ || device_addr > 0x7F) {
+        return nullptr;
+    }
+
+    xSemaphoreTake(devices_mutex_, portMAX_DELAY);
+    II2CDevice* device = nullptr;
+    auto it = devices_.find(device_addr);
+    if (it != devices_.end()) {
+        device = it->second.get();
+    } else {
+        i2c_device_config_t device_config = {};
+        device_config.dev_addr_length = I2C_ADDR_BIT_LEN_7;
+        device_config.device_address = device_addr;
+        device_config.scl_speed_hz = speed_hz ? speed_hz : frequency_hz_;
+        i2c_master_dev_handle_t handle = nullptr;
+        esp_err_t ret = i2c_master_bus_add_device(bus_, &device_config, &handle);
+        if (ret == ESP_OK) {
+            auto created = std::make_unique<Device>(*this, device_addr, handle);
+            device = created.get();
+            devices_[device_addr] = std::move(created);
+        } else {
+            ESP_LOGE(TAG, "Failed to add device 0x%02x: %s", device_addr, esp_err_to_name(ret));
+        }
+    }
+    xSemaphoreGive(devices_mutex_);
+    return device;
+}
+
+esp_err_t I2CBusManager::write(uint8_t device_addr, const uint8_t* data, size_t len) {
+    II2CDevice* device = get_device(device_addr);
+    return device ? device->write(data, len) : ESP_ERR_INVALID_STATE;
+}
+
+esp_err_t I2CBusManager::read(uint8_t device_addr, uint8_t* data, size_t len) {
+    II2CDevice* device = get_device(device_addr);
+    return device ? device->read(data, len) : ESP_ERR_INVALID_STATE;
+}
+
+esp_err_t I2CBusManager::write_read(uint8_t device_addr, uint8_t reg_addr, uint8_t* data, size_t len) {
+    II2CDevice* device = get_device(device_addr);
+    return device ? device->read_registers(reg_addr, data, len) : ESP_ERR_INVALID_STATE;
+}
+
+std::vector<uint8_t> I2CBusManager::scan() {
+    std::vector<uint8_t> found;
+    for (uint8_t address = FIRST_ADDRESS; address <= LAST_ADDRESS; address++) {
+        Request request = {};
+        request.op = Op::PROBE;
+        request.address = address;
+        if (run_sync(request) == ESP_OK) {
+            found.push_back(address);
+        }
+    }
+    ESP_LOGI(TAG, "I2C%d scan: %zu devices", port_, found.size());
+    return found;
+}
+
+esp_err_t I2CBusManager::enqueue(const Request& request, TickType_t wait) {
+    if (!task_) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (xQueueSend(queue_, &request, wait) != pdTRUE) {
+        return wait ? ESP_ERR_TIMEOUT : ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+
+esp_err_t I2CBusManager::run_sync(Request& request) {
+    // A completion callback waiting for the bus task would never return
+    if (xTaskGetCurrentTaskHandle() == task_) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    struct Waiter {
+        StaticSemaphore_t storage;
+        SemaphoreHandle_t done;
+        esp_err_t status;
+    } waiter;
+    waiter.done = xSemaphoreCreateBinaryStatic(&waiter.storage);
+    waiter.status = ESP_FAIL;
+
+    request.callback = [](void* context, esp_err_t status) {
+        auto* w = static_cast<Waiter*>(context);
+        w->status = status;
+        xSemaphoreGive(w->done);
+    };
+    request.context = &waiter;
+
+    // Every queued transaction is bounded by the timeout and one retry
+    TickType_t wait = pdMS_TO_TICKS(timeout_ms_ * 2 * queue_depth_);
+    esp_err_t ret = enqueue(request, wait);
+    if (ret == ESP_OK) {
+        xSemaphoreTake(waiter.done, portMAX_DELAY);
+        ret = waiter.status;
+    }
+    vSemaphoreDelete(waiter.done);
+    return ret;
+}
+
+esp_err_t I2CBusManager::execute(const Request& request) {
+    if (request.op == Op::PROBE) {
+        return i2c_master_probe(bus_, request.address, timeout_ms_);
+    }
+
+    for (uint8_t i = 0; i < request.count; i++) {
+        esp_err_t ret = run_transfer(*request.device, request.transfers[i]);
+        if (ret == ESP_ERR_TIMEOUT && recover() == ESP_OK) {
+            ret = run_transfer(*request.device, request.transfers[i]);
+        }
+        if (ret != ESP_OK) {
+            errors_.fetch_add(1, std::memory_order_relaxed);
+            ESP_LOGW(TAG, "Transfer to 0x%02x failed: %s", request.device->address(), esp_err_to_name(ret));
+            return ret;
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t I2CBusManager::run_transfer(Device& device, const I2CTransfer& transfer) {
+    int timeout = static_cast<int>(timeout_ms_);
+    if (transfer.tx_len && transfer.rx_len) {
+        return i2c_master_transmit_receive(device.handle(), transfer.tx_data, transfer.tx_len,
+                                           transfer.rx_data, transfer.rx_len, timeout);
+    }
+    if (transfer.rx_len) {
+        return i2c_master_receive(device.handle(), transfer.rx_data, transfer.rx_len, timeout);
+    }
+    return i2c_master_transmit(device.handle(), transfer.tx_data, transfer.tx_len, timeout);
+}
+
+esp_err_t I2CBusManager::recover() {
+    recoveries_.fetch_add(1, std::memory_order_relaxed);
+    esp_err_t ret = i2c_master_bus_reset(bus_);
+    ESP_LOGW(TAG, "I2C%d bus cleared after timeout: %s", port_, esp_err_to_name(ret));
+    return ret;
+}
+
+void I2CBusManager::task_entry(void* arg) {
+    static_cast<I2CBusManager*>(arg)->task_loop();
+}
+
+void I2CBusManager::task_loop() {
+    Request request;
+    for (;;) {
+        xQueueReceive(queue_, &request, portMAX_DELAY);
+
+        if (request.op == Op::STOP) {
+            task_ = nullptr;
+            request.callback(request.context, ESP_OK);
+            vTaskDelete(nullptr);
+            return;
+        }
+
+        esp_err_t status = execute(request);
+        transactions_.fetch_add(1, std::memory_order_relaxed);
+        if (request.callback) {
+            request.callback(request.context, status);
+        }
+    }
+}
@@ -0,0 +1,116 @@
+/**
+ * @file ledc_allocator.cpp
+ * @brief Implementation of the LEDC channel and timer allocator
+ */
+
+#include "ledc_allocator.h"
+#include <esp_log.h>
+
+static const char* TAG = "LedcAllocator";
+
+esp_err_t LedcAllocator::acquire(uint32_t frequency_hz, uint8_t resolution_bits, Lease& lease) {
+    int channel = -1;
+    for (int i = 0; i < LEDC_CHANNEL_MAX; i++) {
+        if (!(used_channels_ & (1u << i))) {
+            channel = i;
+            break;
+        }
+    }
+    if (channel < 0) {
+        ESP_LOGE(TAG, "All %d LEDC channels in use", LEDC_CHANNEL_MAX);
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    if (!fade_installed_) {
+        // Already installed by other code is fine
+        esp_err_t ret = ledc_fade_func_install(0);
+        if (ret != ESP_OK && ret != ESP_ERR_INVALID_STATE) {
+            ESP_LOGE(TAG, "Failed to install fade service: %s", esp_err_to_name(ret));
+            return ret;
+        }
+        fade_installed_ = true;
+    }
+
+    ledc_timer_t timer;
+    esp_err_t ret = acquire_timer(frequency_hz, resolution_bits, timer);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    used_channels_ |= 1u << channel;
+    lease.channel = static_cast<ledc_channel_t>(channel);
+    lease.timer = timer;
+    ESP_LOGI(TAG, "Channel %d on timer %d (%lu Hz, %u bits), %u channels left", channel, timer,
+             static_cast<unsigned long>(frequency_hz), resolution_bits, free_channels());
+    return ESP_OK;
+}
+
+void LedcAllocator::release(const Lease& lease) {
+    if (lease.channel >= LEDC_CHANNEL_MAX || !(used_channels_ & (1u << lease.channel))) {
+        return;
+    }
+    used_channels_ &= ~(1u << lease.channel);
+
+    Timer& timer = timers_[lease.timer];
+    if (timer.users > 0 && --timer.users == 0) {
+        ledc_timer_config_t timer_conf = {};
+        timer_conf.speed_mode = SPEED_MODE;
+        timer_conf.timer_num = lease.timer;
+        timer_conf.deconfigure = true;
+        ledc_timer_pause(SPEED_MODE, lease.timer);
+        ledc_timer_config(&timer_conf);
+    }
+}
+
+uint8_t LedcAllocator::free_channels() const {
+    return LEDC_CHANNEL_MAX - __builtin_popcount(used_channels_);
+}
+
+uint8_t LedcAllocator::free_timers() const {
+    uint8_t count = 0;
+    for (const Timer& timer : timers_) {
+        if (timer.users == 0) {
+            count++;
+        }
+    }
+    return count;
+}
+
+esp_err_t LedcAllocator::acquire_timer(uint32_t frequency_hz, uint8_t resolution_bits, ledc_timer_t& timer) {
+    int free_timer = -1;
+    for (int i = 0; i < LEDC_TIMER_MAX; i++) {
+        Timer& candidate = timers_[i];
+        if (candidate.users > 0 && candidate.frequency_hz == frequency_hz &&
+            candidate.resolution_bits == resolution_bits) {
+            candidate.users++;
+            timer = static_cast<ledc_timer_t>(i);
+            return ESP_OK;
+        }
+        if (candidate.users == 0 && free_timer < 0) {
+            free_timer = i;
+        }
+    }
+
+    if (free_timer < 0) {
+        ESP_LOGE(TAG, "No LEDC timer left for %lu Hz / %u bits", static_cast<unsigned long>(frequency_hz),
+                 resolution_bits);
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    ledc_timer_config_t timer_conf = {};
+    timer_conf.speed_mode = SPEED_MODE;
+    timer_conf.duty_resolution = static_cast<ledc_timer_bit_t>(resolution_bits);
+    timer_conf.timer_num = static_cast<ledc_timer_t>(free_timer);
+    timer_conf.freq_hz = frequency_hz;
+    timer_conf.clk_cfg = LEDC_AUTO_CLK;
+    esp_err_t ret = ledc_timer_config(&timer_conf);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Timer %d rejected %lu Hz / %u bits: %s", free_timer,
+                 static_cast<unsigned long>(frequency_hz), resolution_bits, esp_err_to_name(ret));
+        return ret;
+    }
+
+    timers_[free_timer] = {frequency_hz, resolution_bits, 1};
+    timer = static_cast<ledc_timer_t>(free_timer);
+    return ESP_OK;
+}
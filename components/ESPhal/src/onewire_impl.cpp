@@ -72,109 +72,27 @@ OneWireBusImpl::~OneWireBusImpl() {
     }
 }
 std::vector<uint64_t> OneWireBusImpl::search_devices() {
-    ESP_LOGI(TAG, "Searching for devices on OneWire bus (pin %d)", data_pin_);
-    
-    // Add debugging information
-    ESP_LOGI(TAG, "Testing OneWire bus presence...");
-    if (!reset()) {
-        ESP_LOGW(TAG, "No presence pulse detected - check connections and pull-up resistor");
-        return {};
-    }
-    ESP_LOGI(TAG, "Presence pulse detected - bus is working");
+    ESP_LOGD(TAG, "Searching for devices on OneWire bus (pin %d)", data_pin_);
     
     std::vector<uint64_t> devices;
+    uint8_t address[8] = {};
     
-    // First try a simple communication test with SKIP ROM
-    ESP_LOGI(TAG, "Testing basic communication with SKIP ROM + READ SCRATCHPAD...");
-    if (reset()) {
-        write_byte(SKIPROM);  // Skip ROM command (0xCC)
-        write_byte(READSCRATCH);  // Read scratchpad (0xBE)
-        
-        ESP_LOGI(TAG, "Commands sent, reading 9 bytes of scratchpad data:");
-        uint8_t scratchpad[9];
-        for (int i = 0; i < 9; i++) {
-            scratchpad[i] = read_byte();
-            ESP_LOGI(TAG, "  Byte %d: 0x%02X", i, scratchpad[i]);
-        }
-        
-        // If we got meaningful data (not all 0xFF), there's probably a working device
-        bool has_data = false;
-        for (int i = 0; i < 9; i++) {
-            if (scratchpad[i] != 0xFF && scratchpad[i] != 0x00) {
-                has_data = true;
-                break;
-            }
-        }
-        
-        if (has_data) {
-            ESP_LOGI(TAG, "Scratchpad contains meaningful data - device present but unknown address");
-            ESP_LOGI(TAG, "Will proceed with device discovery methods...");
-        } else {
-            ESP_LOGI(TAG, "Scratchpad data is all 0xFF or 0x00 - communication may not be working");
-        }
-    }
-    
-    // First try READ ROM command (0x33) for single device detection
-    ESP_LOGI(TAG, "Trying READ ROM command for single device detection...");
-    if (reset()) {
-        write_byte(READROM);  // Read ROM command (0x33)
-        uint8_t single_address[8];
-        
-        // Read 8 bytes of ROM code
-        for (int i = 0; i < 8; i++) {
-            single_address[i] = read_byte();
-        }
-        
-        ESP_LOGI(TAG, "READ ROM result: %02X %02X %02X %02X %02X %02X %02X %02X",
-                single_address[0], single_address[1], single_address[2], single_address[3],
-                single_address[4], single_address[5], single_address[6], single_address[7]);
-        
-        // Check if we got a valid family code (first byte should be 0x28 for DS18B20)
-        if (single_address[0] == 0x28) {
-            uint64_t device_addr = 0;
-            for (int i = 7; i >= 0; i--) {
-                device_addr = (device_addr << 8) | single_address[i];
-            }
-            devices.push_back(device_addr);
-            ESP_LOGI(TAG, "Found single device via READ ROM: %02X%02X%02X%02X%02X%02X%02X%02X", 
-                     single_address[7], single_address[6], single_address[5], single_address[4], 
-                     single_address[3], single_address[2], single_address[1], single_address[0]);
-        } else {
-            ESP_LOGI(TAG, "READ ROM failed or multiple devices present (family code: 0x%02X)", single_address[0]);
-        }
-    }
+    // New search: state carries over between devices, not between searches
+    last_discrepancy_ = 0;
+    last_device_flag_ = false;
+    last_family_discrepancy_ = 0;
     
-    // If READ ROM didn't work, try SEARCH ROM algorithm
-    if (devices.empty()) {
-        ESP_LOGI(TAG, "Trying SEARCH ROM algorithm...");
-        uint8_t address[8];
-        last_discrepancy_ = 0;
-        last_device_flag_ = false;
-        last_family_discrepancy_ = 0;
-        
-        // Search for devices with detailed logging
-        int search_attempts = 0;
-        while (search_device(address) && search_attempts < 10) {
-            search_attempts++;
-            uint64_t device_addr = 0;
-            for (int i = 7; i >= 0; i--) {
-                device_addr = (device_addr << 8) | address[i];
-            }
-            devices.push_back(device_addr);
-            ESP_LOGI(TAG, "Found device #%d: %02X%02X%02X%02X%02X%02X%02X%02X", 
-                     search_attempts,
-                     address[7], address[6], address[5], address[4], 
-                     address[3], address[2], address[1], address[0]);
-        }
-        
-        if (search_attempts == 0) {
-            ESP_LOGI(TAG, "SEARCH ROM algorithm found no devices");
+    while (devices.size() < MAX_SEARCH_DEVICES && search_device(address)) {
+        uint64_t device_addr = 0;
+        for (int i = 7; i >= 0; i--) {
+            device_addr = (device_addr << 8) | address[i];
         }
+        devices.push_back(device_addr);
+        ESP_LOGD(TAG, "Found device #%zu: %016llX", devices.size(), device_addr);
     }
     
-    ESP_LOGI(TAG, "Found %zu device(s) on OneWire bus", devices.size());
+    ESP_LOGI(TAG, "Found %zu device(s) on OneWire bus (pin %d)", devices.size(), data_pin_);
     
-    // Add enhanced debugging
     if (devices.empty()) {
         ESP_LOGW(TAG, "No devices found. Troubleshooting tips:");
         ESP_LOGW(TAG, "1. Check DS18B20 wiring: VDD(red)->3.3V, GND(black)->GND, Data(yellow)->GPIO%d", data_pin_);
@@ -182,8 +100,10 @@ std::vector<uint64_t> OneWireBusImpl::search_devices() {
         ESP_LOGW(TAG, "3. Check sensor power - try parasitic vs. external power");
         ESP_LOGW(TAG, "4. Test with shorter cables (< 50cm for initial testing)");
         
-        // Perform additional diagnostics
+#ifdef CONFIG_ESPHAL_ENABLE_DEBUG_LOGGING
+        // Line diagnostics toggle the bus for a while - only on request
         debug_line_states();
+#endif
     }
     
     return devices;
@@ -383,151 +303,80 @@ uint8_t OneWireBusImpl::read_byte() {
     return byte;
 }
 bool OneWireBusImpl::search_device(uint8_t* address) {
-    uint8_t id_bit_number = 1;
-    uint8_t last_zero = 0;
-    uint8_t rom_byte_number = 0;
-    bool search_result = false;
-    uint8_t id_bit, cmp_id_bit;
-    uint8_t rom_byte_mask = 1;
-    uint8_t search_direction;
-    
-    ESP_LOGI(TAG, "Starting device search...");
-    
-    // Reset if this is the first search
-    if (!last_device_flag_) {
-        last_discrepancy_ = 0;
-        last_device_flag_ = false;
-        last_family_discrepancy_ = 0;
-    }
-    
-    // Check if all devices have been found
+    // Maxim search: one pass per device, at each discrepancy take the branch
+    // opposite to the last pass; last_discrepancy_ keeps the branch point
     if (last_device_flag_) {
-        ESP_LOGI(TAG, "All devices already found");
         return false;
     }
     
     if (!reset()) {
-        // Reset failed, no devices present
-        ESP_LOGI(TAG, "Reset failed during search - no devices present");
+        ESP_LOGD(TAG, "Reset failed during search - no devices present");
         last_discrepancy_ = 0;
-        last_device_flag_ = false;
         last_family_discrepancy_ = 0;
         return false;
     }
     
-    ESP_LOGI(TAG, "Reset OK, sending SEARCHROM command (0x%02X)", SEARCHROM);
-    write_byte(SEARCHROM);  // Issue search ROM command
+    write_byte(SEARCHROM);
     
-    // Clear address buffer
-    for (int i = 0; i < 8; i++) {
-        address[i] = 0;
-    }
+    uint8_t last_zero = 0;
     
-    // Loop through all ROM bytes 0-7
-    do {
-        // Read a bit and its complement
-        id_bit = read_bit();
-        cmp_id_bit = read_bit();
+    for (uint8_t id_bit_number = 1; id_bit_number <= 64; id_bit_number++) {
+        uint8_t rom_byte_number = (id_bit_number - 1) >> 3;
+        uint8_t rom_byte_mask = 1 << ((id_bit_number - 1) & 7);
         
-        if (id_bit_number <= 8) {  // Only log first few bits to avoid spam
-            ESP_LOGI(TAG, "Bit %d: id_bit=%d, cmp_id_bit=%d", id_bit_number, id_bit, cmp_id_bit);
+        // Bit and its complement from all devices still in the search
+        bool id_bit = read_bit();
+        bool cmp_id_bit = read_bit();
+        
+        if (id_bit && cmp_id_bit) {
+            // No device answered - bus changed during search
+            last_discrepancy_ = 0;
+            last_family_discrepancy_ = 0;
+            return false;
         }
         
-        // Check for no devices on 1-wire
-        if ((id_bit == 1) && (cmp_id_bit == 1)) {
-            ESP_LOGI(TAG, "No devices found (both bits = 1) at bit %d", id_bit_number);
-            break;
+        bool search_direction;
+        if (id_bit != cmp_id_bit) {
+            // All remaining devices agree
+            search_direction = id_bit;
+        } else if (id_bit_number < last_discrepancy_) {
+            // Before the last branch point - repeat the previous choice
+            search_direction = (address[rom_byte_number] & rom_byte_mask) != 0;
         } else {
-            // All devices coupled have 0 or 1
-            if (id_bit != cmp_id_bit) {
-                search_direction = id_bit;  // Bit write value for search
-                if (id_bit_number <= 8) {
-                    ESP_LOGI(TAG, "Clear bit choice: direction=%d", search_direction);
-                }
-            } else {
-                // If this discrepancy is before the Last Discrepancy
-                // on a previous next then pick the same as last time
-                if (id_bit_number < last_discrepancy_) {
-                    search_direction = ((address[rom_byte_number] & rom_byte_mask) > 0);
-                    if (id_bit_number <= 8) {
-                        ESP_LOGI(TAG, "Previous choice: direction=%d", search_direction);
-                    }
-                } else {
-                    // If equal to last pick 1, if not then pick 0
-                    search_direction = (id_bit_number == last_discrepancy_);
-                    if (id_bit_number <= 8) {
-                        ESP_LOGI(TAG, "New choice: direction=%d", search_direction);
-                    }
-                }
-                
-                // If 0 was picked then record its position in LastZero
-                if (search_direction == 0) {
-                    last_zero = id_bit_number;
-                    
-                    // Check for Last discrepancy in family
-                    if (last_zero < 9) {
-                        last_family_discrepancy_ = last_zero;
-                    }
-                }
-            }
-            
-            // Set or clear the bit in the ROM byte rom_byte_number
-            // with mask rom_byte_mask
-            if (search_direction == 1) {
-                address[rom_byte_number] |= rom_byte_mask;
-            } else {
-                address[rom_byte_number] &= ~rom_byte_mask;
-            }
-            
-            // Serial number search direction write bit
-            write_bit(search_direction);
-            
-            // Increment the byte counter id_bit_number
-            // and shift the mask rom_byte_mask
-            id_bit_number++;
-            rom_byte_mask <<= 1;
-            
-            // If the mask is 0 then go to new SerialNum byte rom_byte_number and reset mask
-            if (rom_byte_mask == 0) {
-                ESP_LOGI(TAG, "Completed byte %d: 0x%02X", rom_byte_number, address[rom_byte_number]);
-                rom_byte_number++;
-                rom_byte_mask = 1;
-            }
+            // At the branch point take 1, past it take 0
+            search_direction = (id_bit_number == last_discrepancy_);
         }
-    } while (rom_byte_number < 8);  // Loop until through all ROM bytes 0-7
-    
-    // If the search was successful then
-    if (!(id_bit_number < 65)) {
-        // Search successful so set LastDiscrepancy,LastDeviceFlag,search_result
-        last_discrepancy_ = last_zero;
         
-        // Check for last device
-        if (last_discrepancy_ == 0) {
-            last_device_flag_ = true;
+        if (id_bit == cmp_id_bit && !search_direction) {
+            last_zero = id_bit_number;
+            if (last_zero < 9) {
+                last_family_discrepancy_ = last_zero;
+            }
         }
         
-        search_result = true;
-        ESP_LOGI(TAG, "Search successful! Found device with %d bits processed", id_bit_number-1);
+        if (search_direction) {
+            address[rom_byte_number] |= rom_byte_mask;
+        } else {
+            address[rom_byte_number] &= ~rom_byte_mask;
+        }
         
-        // Print found address
-        ESP_LOGI(TAG, "Device address: %02X %02X %02X %02X %02X %02X %02X %02X",
-                address[0], address[1], address[2], address[3],
-                address[4], address[5], address[6], address[7]);
-    } else {
-        ESP_LOGI(TAG, "Search incomplete - only %d bits processed", id_bit_number-1);
+        write_bit(search_direction);
     }
     
-    // If no device found then reset counters so next 'search' will be like a first
-    if (!search_result || !address[0]) {
-        ESP_LOGI(TAG, "Search failed, resetting state (result=%d, addr[0]=%02X)", search_result, address[0]);
+    if (!check_crc(address, 7, address[7])) {
+        ESP_LOGW(TAG, "Search returned address with invalid CRC: %02X%02X%02X%02X%02X%02X%02X%02X",
+                 address[7], address[6], address[5], address[4],
+                 address[3], address[2], address[1], address[0]);
         last_discrepancy_ = 0;
-        last_device_flag_ = false;
         last_family_discrepancy_ = 0;
-        search_result = false;
+        return false;
     }
     
-    return search_result;
+    last_discrepancy_ = last_zero;
+    last_device_flag_ = (last_discrepancy_ == 0);
+    return true;
 }
+
 bool OneWireBusImpl::check_crc(const uint8_t* data, uint8_t len, uint8_t expected_crc) {
     uint8_t crc = 0;
     
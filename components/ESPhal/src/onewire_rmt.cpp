@@ -0,0 +1,503 @@
+/**
+ * @file onewire_rmt.cpp
+ * @brief Implementation of RMT based OneWire bus for DS18B20 sensors
+ */
+
+#include "onewire_rmt.h"
+
+#if SOC_RMT_SUPPORTED
+
+#include <esp_log.h>
+#include <esp_attr.h>
+#include <freertos/task.h>
+#include <algorithm>
+
+static const char* TAG = "OneWireRmt";
+
+// DS18B20 specific commands
+#define STARTCONVO      0x44
+#define READSCRATCH     0xBE
+#define SEARCHROM       0xF0
+#define MATCHROM        0x55
+#define SKIPROM         0xCC
+
+// Timing in RMT ticks (1 MHz resolution = 1 µs per tick)
+#define RMT_RESOLUTION_HZ       1000000
+#define RESET_PULSE_US          480
+#define RESET_RECOVERY_US       70
+#define PRESENCE_MIN_US         40
+#define PRESENCE_MAX_US         300
+#define SLOT_WRITE_0_LOW_US     60
+#define SLOT_WRITE_1_LOW_US     6
+#define SLOT_US                 70
+#define SLOT_SAMPLE_US          15      // Line still low at 15 µs = device sent 0
+
+// RX glitch filter and end-of-frame idle thresholds
+#define RX_MIN_NS               1000
+#define RX_RESET_IDLE_NS        (1000 * 1000)
+#define RX_SLOT_IDLE_NS         (100 * 1000)
+
+#define TRANSFER_TIMEOUT_MS     20
+#define MAX_SEARCH_DEVICES      16
+
+// Read bytes per receive - one RMT memory block, one word kept for the end marker
+static constexpr size_t RX_CHUNK_BYTES = (SOC_RMT_MEM_WORDS_PER_CHANNEL - 1) / 8;
+
+static rmt_symbol_word_t make_symbol(uint16_t low_us, uint16_t high_us) {
+    rmt_symbol_word_t symbol = {};
+    symbol.level0 = 0;
+    symbol.duration0 = low_us;
+    symbol.level1 = 1;
+    symbol.duration1 = high_us;
+    return symbol;
+}
+
+static const rmt_symbol_word_t SYMBOL_RESET = make_symbol(RESET_PULSE_US, RESET_RECOVERY_US);
+static const rmt_symbol_word_t SYMBOL_BIT_0 = make_symbol(SLOT_WRITE_0_LOW_US, SLOT_US - SLOT_WRITE_0_LOW_US);
+
+// Also used as read slot: master releases the line, device may hold it low
+static const rmt_symbol_word_t SYMBOL_BIT_1 = make_symbol(SLOT_WRITE_1_LOW_US, SLOT_US - SLOT_WRITE_1_LOW_US);
+
+static rmt_transmit_config_t make_tx_config() {
+    rmt_transmit_config_t config = {};
+    config.loop_count = 0;
+    config.flags.eot_level = 1;     // Release the line after the frame
+    return config;
+}
+
+static const rmt_transmit_config_t TX_CONFIG = make_tx_config();
+
+OneWireRmtBus::OneWireRmtBus(gpio_num_t data_pin, gpio_num_t power_pin)
+    : data_pin_(data_pin), power_pin_(power_pin) {
+}
+
+OneWireRmtBus::~OneWireRmtBus() {
+    if (rx_channel_) {
+        rmt_disable(rx_channel_);
+        rmt_del_channel(rx_channel_);
+    }
+    if (tx_channel_) {
+        rmt_disable(tx_channel_);
+        rmt_del_channel(tx_channel_);
+    }
+    if (bytes_encoder_) {
+        rmt_del_encoder(bytes_encoder_);
+    }
+    if (copy_encoder_) {
+        rmt_del_encoder(copy_encoder_);
+    }
+    if (rx_queue_) {
+        vQueueDelete(rx_queue_);
+    }
+    if (power_pin_ != GPIO_NUM_NC) {
+        gpio_set_level(power_pin_, 0);  // Turn off power
+    }
+}
+
+esp_err_t OneWireRmtBus::init() {
+    ESP_LOGI(TAG, "Creating RMT OneWire bus on pin %d", data_pin_);
+
+    // TX drives the line in open-drain mode and loops back into RX
+    rmt_tx_channel_config_t tx_config = {};
+    tx_config.gpio_num = data_pin_;
+    tx_config.clk_src = RMT_CLK_SRC_DEFAULT;
+    tx_config.resolution_hz = RMT_RESOLUTION_HZ;
+    tx_config.mem_block_symbols = SOC_RMT_MEM_WORDS_PER_CHANNEL;
+    tx_config.trans_queue_depth = 4;
+    tx_config.flags.io_loop_back = true;
+    tx_config.flags.io_od_mode = true;
+    esp_err_t ret = rmt_new_tx_channel(&tx_config, &tx_channel_);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to create RMT TX channel: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    rmt_rx_channel_config_t rx_config = {};
+    rx_config.gpio_num = data_pin_;
+    rx_config.clk_src = RMT_CLK_SRC_DEFAULT;
+    rx_config.resolution_hz = RMT_RESOLUTION_HZ;
+    rx_config.mem_block_symbols = SOC_RMT_MEM_WORDS_PER_CHANNEL;
+    ret = rmt_new_rx_channel(&rx_config, &rx_channel_);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to create RMT RX channel: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    // Internal pull-up in addition to the external 4.7kΩ
+    gpio_pullup_en(data_pin_);
+
+    rmt_bytes_encoder_config_t bytes_config = {};
+    bytes_config.bit0 = SYMBOL_BIT_0;
+    bytes_config.bit1 = SYMBOL_BIT_1;
+    bytes_config.flags.msb_first = 0;   // OneWire is LSB first
+    ret = rmt_new_bytes_encoder(&bytes_config, &bytes_encoder_);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    rmt_copy_encoder_config_t copy_config = {};
+    ret = rmt_new_copy_encoder(&copy_config, &copy_encoder_);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    rx_queue_ = xQueueCreate(1, sizeof(rmt_rx_done_event_data_t));
+    if (!rx_queue_) {
+        return ESP_ERR_NO_MEM;
+    }
+    rx_symbols_.resize(SOC_RMT_MEM_WORDS_PER_CHANNEL);
+
+    rmt_rx_event_callbacks_t callbacks = {};
+    callbacks.on_recv_done = rx_done_callback;
+    ret = rmt_rx_register_event_callbacks(rx_channel_, &callbacks, rx_queue_);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    // A failure here lets ESPhal fall back to the GPIO driver
+    ret = rmt_enable(tx_channel_);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    ret = rmt_enable(rx_channel_);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    // Configure power pin if specified
+    if (power_pin_ != GPIO_NUM_NC) {
+        gpio_config_t power_conf = {};
+        power_conf.intr_type = GPIO_INTR_DISABLE;
+        power_conf.mode = GPIO_MODE_OUTPUT;
+        power_conf.pin_bit_mask = (1ULL << power_pin_);
+        power_conf.pull_down_en = GPIO_PULLDOWN_DISABLE;
+        power_conf.pull_up_en = GPIO_PULLUP_DISABLE;
+        gpio_config(&power_conf);
+
+        // Turn on power
+        gpio_set_level(power_pin_, 1);
+        vTaskDelay(pdMS_TO_TICKS(10)); // Wait for power to stabilize
+    }
+
+    ESP_LOGI(TAG, "RMT OneWire bus initialized on pin %d (%zu bytes per receive)",
+             data_pin_, RX_CHUNK_BYTES);
+    return ESP_OK;
+}
+
+std::vector<uint64_t> OneWireRmtBus::search_devices() {
+    ESP_LOGD(TAG, "Searching for devices on OneWire bus (pin %d)", data_pin_);
+
+    std::vector<uint64_t> devices;
+    int last_discrepancy = 0;
+    // Previous ROM stays in the buffer: the next pass repeats its branches
+    uint8_t address[8] = {};
+
+    do {
+        if (!search_device(address, last_discrepancy)) {
+            break;
+        }
+
+        uint64_t device_addr = 0;
+        for (int i = 7; i >= 0; i--) {
+            device_addr = (device_addr << 8) | address[i];
+        }
+        devices.push_back(device_addr);
+        ESP_LOGD(TAG, "Found device #%zu: %016llX", devices.size(), device_addr);
+    } while (last_discrepancy != 0 && devices.size() < MAX_SEARCH_DEVICES);
+
+    ESP_LOGI(TAG, "Found %zu device(s) on OneWire bus (pin %d)", devices.size(), data_pin_);
+    return devices;
+}
+
+esp_err_t OneWireRmtBus::request_temperatures() {
+    ESP_LOGV(TAG, "Requesting temperature conversion");
+
+    if (!reset()) {
+        ESP_LOGW(TAG, "No devices found during reset");
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    const uint8_t command[] = {SKIPROM, STARTCONVO};
+    return write_bytes(command, sizeof(command));
+}
+
+esp_err_t OneWireRmtBus::start_temperature_conversion(uint64_t address) {
+    ESP_LOGV(TAG, "Starting temperature conversion for device: %016llX", address);
+
+    if (!reset()) {
+        ESP_LOGW(TAG, "No devices found during reset for conversion");
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    esp_err_t ret = select(address);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    const uint8_t command = STARTCONVO;
+    return write_bytes(&command, 1);
+}
+
+HalResult<float> OneWireRmtBus::read_temperature(uint64_t address) {
+    HalResult<float> result;
+    result.value = 0.0f;
+
+    if (!reset()) {
+        ESP_LOGW(TAG, "No devices found during reset for reading");
+        result.error = ESP_ERR_NOT_FOUND;
+        return result;
+    }
+
+    // MATCH ROM + address + READ SCRATCHPAD as one transmission
+    uint8_t command[10];
+    command[0] = MATCHROM;
+    for (int i = 0; i < 8; i++) {
+        command[i + 1] = (address >> (i * 8)) & 0xFF;
+    }
+    command[9] = READSCRATCH;
+
+    result.error = write_bytes(command, sizeof(command));
+    if (result.error != ESP_OK) {
+        return result;
+    }
+
+    uint8_t data[9];
+    result.error = read_bytes(data, sizeof(data));
+    if (result.error != ESP_OK) {
+        ESP_LOGW(TAG, "Scratchpad read failed for sensor %016llX: %s",
+                 address, esp_err_to_name(result.error));
+        return result;
+    }
+
+    if (crc8(data, 8) != data[8]) {
+        ESP_LOGW(TAG, "CRC check failed for sensor %016llX", address);
+        result.error = ESP_ERR_INVALID_CRC;
+        return result;
+    }
+
+    int16_t raw_temp = (data[1] << 8) | data[0];
+    result.value = (float)raw_temp / 16.0f;
+
+    ESP_LOGD(TAG, "OneWire read successful: Raw=0x%04X, Temperature=%.2f°C (sensor: %016llX)",
+             raw_temp, result.value, address);
+    return result;
+}
+
+// Private low-level OneWire protocol methods
+bool OneWireRmtBus::reset() {
+    size_t received = 0;
+    esp_err_t ret = receive_slots(&SYMBOL_RESET, sizeof(SYMBOL_RESET), copy_encoder_,
+                                  2, RX_RESET_IDLE_NS, received);
+    if (ret != ESP_OK || received < 2) {
+        return false;
+    }
+
+    // [0] = our reset pulse + recovery, [1] = presence pulse from devices
+    const rmt_symbol_word_t* symbols = rx_symbols_.data();
+    bool presence = symbols[0].level0 == 0 &&
+                    symbols[0].duration0 >= RESET_PULSE_US - 10 &&
+                    symbols[1].level0 == 0 &&
+                    symbols[1].duration0 >= PRESENCE_MIN_US &&
+                    symbols[1].duration0 <= PRESENCE_MAX_US;
+
+    ESP_LOGV(TAG, "Presence = %d", presence);
+    return presence;
+}
+
+esp_err_t OneWireRmtBus::write_bytes(const uint8_t* data, size_t len) {
+    esp_err_t ret = rmt_transmit(tx_channel_, bytes_encoder_, data, len, &TX_CONFIG);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    return rmt_tx_wait_all_done(tx_channel_, TRANSFER_TIMEOUT_MS);
+}
+
+esp_err_t OneWireRmtBus::read_bytes(uint8_t* data, size_t len) {
+    // Every bit of 0xFF is a read slot; buffer lives until receive_slots() waits TX done
+    uint8_t read_slots[RX_CHUNK_BYTES];
+    std::fill(read_slots, read_slots + RX_CHUNK_BYTES, 0xFF);
+
+    for (size_t offset = 0; offset < len; offset += RX_CHUNK_BYTES) {
+        size_t chunk = std::min(RX_CHUNK_BYTES, len - offset);
+        size_t received = 0;
+
+        esp_err_t ret = receive_slots(read_slots, chunk, bytes_encoder_,
+                                      chunk * 8, RX_SLOT_IDLE_NS, received);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+        if (received < chunk * 8) {
+            return ESP_ERR_INVALID_RESPONSE;
+        }
+
+        for (size_t i = 0; i < chunk; i++) {
+            uint8_t byte = 0;
+            for (int bit = 0; bit < 8; bit++) {
+                if (rx_symbols_[i * 8 + bit].duration0 < SLOT_SAMPLE_US) {
+                    byte |= (1 << bit);
+                }
+            }
+            data[offset + i] = byte;
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t OneWireRmtBus::write_bit(bool bit) {
+    const rmt_symbol_word_t& symbol = bit ? SYMBOL_BIT_1 : SYMBOL_BIT_0;
+    esp_err_t ret = rmt_transmit(tx_channel_, copy_encoder_, &symbol, sizeof(symbol), &TX_CONFIG);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    return rmt_tx_wait_all_done(tx_channel_, TRANSFER_TIMEOUT_MS);
+}
+
+esp_err_t OneWireRmtBus::read_bits(uint8_t* bits, size_t count) {
+    rmt_symbol_word_t slots[2] = {SYMBOL_BIT_1, SYMBOL_BIT_1};
+    count = std::min(count, sizeof(slots) / sizeof(slots[0]));
+
+    size_t received = 0;
+    esp_err_t ret = receive_slots(slots, count * sizeof(rmt_symbol_word_t), copy_encoder_,
+                                  count, RX_SLOT_IDLE_NS, received);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    if (received < count) {
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        bits[i] = rx_symbols_[i].duration0 < SLOT_SAMPLE_US ? 1 : 0;
+    }
+    return ESP_OK;
+}
+
+esp_err_t OneWireRmtBus::select(uint64_t address) {
+    uint8_t command[9];
+    command[0] = MATCHROM;
+    for (int i = 0; i < 8; i++) {
+        command[i + 1] = (address >> (i * 8)) & 0xFF;
+    }
+    return write_bytes(command, sizeof(command));
+}
+
+bool OneWireRmtBus::search_device(uint8_t* address, int& last_discrepancy) {
+    if (!reset()) {
+        ESP_LOGD(TAG, "Reset failed during search - no devices present");
+        last_discrepancy = 0;
+        return false;
+    }
+
+    const uint8_t command = SEARCHROM;
+    if (write_bytes(&command, 1) != ESP_OK) {
+        return false;
+    }
+
+    int last_zero = 0;
+
+    for (int id_bit_number = 1; id_bit_number <= 64; id_bit_number++) {
+        uint8_t bits[2];
+        if (read_bits(bits, 2) != ESP_OK) {
+            return false;
+        }
+
+        // Both 1 - no device answered
+        if (bits[0] && bits[1]) {
+            last_discrepancy = 0;
+            return false;
+        }
+
+        int byte_index = (id_bit_number - 1) / 8;
+        uint8_t mask = 1 << ((id_bit_number - 1) % 8);
+        bool direction;
+
+        if (bits[0] != bits[1]) {
+            direction = bits[0];
+        } else if (id_bit_number < last_discrepancy) {
+            // Repeat the choice made on the previous pass
+            direction = (address[byte_index] & mask) != 0;
+        } else {
+            direction = (id_bit_number == last_discrepancy);
+        }
+
+        if (bits[0] == bits[1] && !direction) {
+            last_zero = id_bit_number;
+        }
+
+        if (direction) {
+            address[byte_index] |= mask;
+        } else {
+            address[byte_index] &= ~mask;
+        }
+
+        if (write_bit(direction) != ESP_OK) {
+            return false;
+        }
+    }
+
+    if (crc8(address, 7) != address[7]) {
+        ESP_LOGW(TAG, "Search returned address with invalid CRC");
+        last_discrepancy = 0;
+        return false;
+    }
+
+    last_discrepancy = last_zero;
+    return true;
+}
+
+esp_err_t OneWireRmtBus::receive_slots(const void* tx_data, size_t tx_len, rmt_encoder_handle_t encoder,
+                                       size_t expected_symbols, uint32_t range_max_ns, size_t& received) {
+    received = 0;
+
+    rmt_receive_config_t rx_config = {};
+    rx_config.signal_range_min_ns = RX_MIN_NS;
+    rx_config.signal_range_max_ns = range_max_ns;
+
+    // Arm RX first so it sees the frame from its first edge
+    xQueueReset(rx_queue_);
+    esp_err_t ret = rmt_receive(rx_channel_, rx_symbols_.data(),
+                                rx_symbols_.size() * sizeof(rmt_symbol_word_t), &rx_config);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    ret = rmt_transmit(tx_channel_, encoder, tx_data, tx_len, &TX_CONFIG);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    // Task sleeps until the RX done interrupt
+    rmt_rx_done_event_data_t event;
+    if (xQueueReceive(rx_queue_, &event, pdMS_TO_TICKS(TRANSFER_TIMEOUT_MS) + 1) != pdTRUE) {
+        ESP_LOGW(TAG, "RMT receive timeout (expected %zu symbols)", expected_symbols);
+        return ESP_ERR_TIMEOUT;
+    }
+
+    received = event.num_symbols;
+    return rmt_tx_wait_all_done(tx_channel_, TRANSFER_TIMEOUT_MS);
+}
+
+bool IRAM_ATTR OneWireRmtBus::rx_done_callback(rmt_channel_handle_t channel,
+                                                const rmt_rx_done_event_data_t* edata, void* user_ctx) {
+    BaseType_t task_woken = pdFALSE;
+    xQueueSendFromISR(static_cast<QueueHandle_t>(user_ctx), edata, &task_woken);
+    return task_woken == pdTRUE;
+}
+
+uint8_t OneWireRmtBus::crc8(const uint8_t* data, size_t len) {
+    uint8_t crc = 0;
+    for (size_t i = 0; i < len; i++) {
+        uint8_t byte = data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            uint8_t mix = (crc ^ byte) & 0x01;
+            crc >>= 1;
+            if (mix) {
+                crc ^= 0x8C;
+            }
+            byte >>= 1;
+        }
+    }
+    return crc;
+}
+
+#endif // SOC_RMT_SUPPORTED
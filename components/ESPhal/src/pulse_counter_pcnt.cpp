@@ -0,0 +1,148 @@
+/**
+ * @file pulse_counter_pcnt.cpp
+ * @brief Implementation of the PCNT pulse counter
+ */
+
+#include "pulse_counter_pcnt.h"
+
+#if SOC_PCNT_SUPPORTED
+
+#include <esp_log.h>
+#include <esp_timer.h>
+
+static const char* TAG = "PcntCounter";
+
+// Hardware counter range; reaching a limit folds it into the accumulated count
+static constexpr int COUNT_LIMIT = 32767;
+
+PcntPulseCounter::PcntPulseCounter(gpio_num_t pin, uint32_t glitch_ns, bool pull_up, uint32_t gate_ms)
+    : pin_(pin), glitch_ns_(glitch_ns), pull_up_(pull_up), gate_us_(gate_ms * 1000) {
+}
+
+PcntPulseCounter::~PcntPulseCounter() {
+    if (unit_) {
+        pcnt_unit_stop(unit_);
+        pcnt_unit_disable(unit_);
+    }
+    if (channel_) {
+        pcnt_del_channel(channel_);
+    }
+    if (unit_) {
+        pcnt_del_unit(unit_);
+    }
+}
+
+esp_err_t PcntPulseCounter::init() {
+    pcnt_unit_config_t unit_config = {};
+    unit_config.low_limit = -COUNT_LIMIT;
+    unit_config.high_limit = COUNT_LIMIT;
+    unit_config.flags.accum_count = 1;
+    esp_err_t ret = pcnt_new_unit(&unit_config, &unit_);
+    if (ret != ESP_OK) {
+        unit_ = nullptr;
+        ESP_LOGE(TAG, "No PCNT unit for GPIO%d: %s", pin_, esp_err_to_name(ret));
+        return ret;
+    }
+
+    if (glitch_ns_ > 0) {
+        pcnt_glitch_filter_config_t filter_config = {};
+        filter_config.max_glitch_ns = glitch_ns_;
+        ret = pcnt_unit_set_glitch_filter(unit_, &filter_config);
+        if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "Glitch filter %lu ns rejected: %s",
+                     static_cast<unsigned long>(glitch_ns_), esp_err_to_name(ret));
+            return ret;
+        }
+    }
+
+    pcnt_chan_config_t channel_config = {};
+    channel_config.edge_gpio_num = pin_;
+    channel_config.level_gpio_num = -1;
+    ret = pcnt_new_channel(unit_, &channel_config, &channel_);
+    if (ret != ESP_OK) {
+        channel_ = nullptr;
+        return ret;
+    }
+
+    // Count rising edges only, level input unused
+    pcnt_channel_set_edge_action(channel_, PCNT_CHANNEL_EDGE_ACTION_INCREASE, PCNT_CHANNEL_EDGE_ACTION_HOLD);
+    if (pull_up_) {
+        gpio_pullup_en(pin_);
+    }
+
+    // Watch point at the limit makes the driver accumulate overflows
+    ret = pcnt_unit_add_watch_point(unit_, COUNT_LIMIT);
+    if (ret == ESP_OK) {
+        ret = pcnt_unit_enable(unit_);
+    }
+    if (ret == ESP_OK) {
+        ret = pcnt_unit_clear_count(unit_);
+    }
+    if (ret == ESP_OK) {
+        ret = pcnt_unit_start(unit_);
+    }
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to start PCNT on GPIO%d: %s", pin_, esp_err_to_name(ret));
+        return ret;
+    }
+
+    gate_start_us_ = esp_timer_get_time();
+    ESP_LOGI(TAG, "Pulse counter on GPIO%d, glitch filter %lu ns", pin_,
+             static_cast<unsigned long>(glitch_ns_));
+    return ESP_OK;
+}
+
+esp_err_t PcntPulseCounter::update_count() {
+    if (!unit_) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    int raw = 0;
+    esp_err_t ret = pcnt_unit_get_count(unit_, &raw);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    // Unsigned difference survives wrap of the 32-bit accumulated count
+    total_ += static_cast<uint32_t>(raw - last_raw_);
+    last_raw_ = raw;
+    return ESP_OK;
+}
+
+HalResult<uint64_t> PcntPulseCounter::get_count() {
+    esp_err_t ret = update_count();
+    return {total_, ret};
+}
+
+HalResult<float> PcntPulseCounter::get_frequency_hz() {
+    esp_err_t ret = update_count();
+    if (ret != ESP_OK) {
+        return {0.0f, ret};
+    }
+
+    int64_t now_us = esp_timer_get_time();
+    int64_t elapsed_us = now_us - gate_start_us_;
+    if (elapsed_us >= gate_us_) {
+        frequency_hz_ = (total_ - gate_count_) * 1e6f / elapsed_us;
+        has_frequency_ = true;
+        gate_count_ = total_;
+        gate_start_us_ = now_us;
+    }
+
+    return {frequency_hz_, has_frequency_ ? ESP_OK : ESP_ERR_NOT_FINISHED};
+}
+
+esp_err_t PcntPulseCounter::reset() {
+    esp_err_t ret = update_count();
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    // Restart the frequency gate on the new base
+    total_ = 0;
+    gate_count_ = 0;
+    gate_start_us_ = esp_timer_get_time();
+    has_frequency_ = false;
+    return ESP_OK;
+}
+
+#endif // SOC_PCNT_SUPPORTED
@@ -0,0 +1,314 @@
+/**
+ * @file sim_hal.cpp
+ * @brief Implementation of the simulated HAL backend
+ */
+
+#include "sim_hal.h"
+#include <esp_log.h>
+#include <esp_timer.h>
+#include <cmath>
+#include <cstring>
+
+static const char* TAG = "SimHal";
+
+namespace {
+
+using Probe = ColdRoomPlant::Probe;
+
+bool contains(const char* text, const char* part) {
+    return std::strstr(text, part) != nullptr;
+}
+
+Probe probe_for(const char* hal_id) {
+    if (contains(hal_id, "EVAP")) return Probe::EVAPORATOR;
+    if (contains(hal_id, "PRODUCT")) return Probe::PRODUCT;
+    if (contains(hal_id, "AMBIENT")) return Probe::AMBIENT;
+    return Probe::AIR;
+}
+
+int64_t default_clock() {
+    return esp_timer_get_time();
+}
+
+/**
+ * @brief Relay output bound to a plant input
+ */
+class SimGpioOutput : public IGpioOutput {
+public:
+    using Binding = bool ColdRoomPlant::Inputs::*;
+
+    SimGpioOutput(SimHal& sim, Binding binding) : sim_(sim), binding_(binding) {}
+
+    esp_err_t set_state(bool is_on) override {
+        sim_.sync();
+        state_ = is_on;
+        if (binding_) {
+            sim_.with_plant([&](ColdRoomPlant& plant) { plant.inputs().*binding_ = is_on; });
+        }
+        return ESP_OK;
+    }
+
+    bool get_state() const override { return state_; }
+
+    esp_err_t toggle() override { return set_state(!state_); }
+
+private:
+    SimHal& sim_;
+    Binding binding_;
+    bool state_ = false;
+};
+
+/**
+ * @brief Digital input reading a plant input (door switch)
+ */
+class SimGpioInput : public IGpioInput {
+public:
+    using Binding = bool ColdRoomPlant::Inputs::*;
+
+    SimGpioInput(SimHal& sim, Binding binding) : sim_(sim), binding_(binding) {}
+
+    bool get_state() override {
+        bool state = false;
+        if (binding_) {
+            sim_.with_plant([&](ColdRoomPlant& plant) { state = plant.inputs().*binding_; });
+        }
+        return state;
+    }
+
+private:
+    SimHal& sim_;
+    Binding binding_;
+};
+
+/**
+ * @brief OneWire bus with one DS18B20 on a plant probe
+ *
+ * Conversion latches the probe temperature, reads return it with 12-bit
+ * (1/16 °C) resolution. Before the first conversion the sensor reports
+ * its power-on value of 85 °C, like real hardware.
+ */
+class SimOneWireBus : public IOneWireBus {
+public:
+    SimOneWireBus(SimHal& sim, const char* hal_id)
+        : sim_(sim), probe_(probe_for(hal_id)), address_(SimHal::make_rom_address(hal_id)) {}
+
+    std::vector<uint64_t> search_devices() override {
+        return {address_};
+    }
+
+    esp_err_t request_temperatures() override {
+        latched_ = sim_.temperature(probe_);
+        return ESP_OK;
+    }
+
+    esp_err_t start_temperature_conversion(uint64_t address) override {
+        if (address != address_) {
+            return ESP_ERR_NOT_FOUND;
+        }
+        return request_temperatures();
+    }
+
+    HalResult<float> read_temperature(uint64_t address) override {
+        if (address != address_) {
+            return {0.0f, ESP_ERR_NOT_FOUND};
+        }
+        return {std::round(latched_ * 16.0f) / 16.0f, ESP_OK};
+    }
+
+private:
+    SimHal& sim_;
+    Probe probe_;
+    uint64_t address_;
+    float latched_ = 85.0f;
+};
+
+/**
+ * @brief ADC channel with a 10K/3950 NTC on a plant probe
+ *
+ * NTC on the low side of a 10K divider from 3.3 V, as the NTC driver
+ * assumes by default.
+ */
+class SimAdcChannel : public IAdcChannel {
+public:
+    SimAdcChannel(SimHal& sim, const char* hal_id) : sim_(sim), probe_(probe_for(hal_id)) {}
+
+    HalResult<int> read_raw() override {
+        return {static_cast<int>(code() + 0.5f), ESP_OK};
+    }
+
+    HalResult<int> read_voltage_mv() override {
+        return {static_cast<int>(code() * 3300.0f / 4095.0f + 0.5f), ESP_OK};
+    }
+
+    HalResult<float> read_filtered() override {
+        return {code(), ESP_OK};
+    }
+
+private:
+    float code() {
+        constexpr float KELVIN = 273.15f;
+        float celsius = sim_.temperature(probe_);
+        float resistance = 10000.0f * std::exp(3950.0f * (1.0f / (celsius + KELVIN) - 1.0f / (25.0f + KELVIN)));
+        return 4095.0f * resistance / (resistance + 10000.0f);
+    }
+
+    SimHal& sim_;
+    Probe probe_;
+};
+
+/**
+ * @brief Fan tachometer following a plant input
+ *
+ * Pulses accumulate in real (unscaled) time at the nominal rate while the
+ * bound input is on; the state is held between reads.
+ */
+class SimPulseCounter : public IPulseCounter {
+public:
+    using Binding = bool ColdRoomPlant::Inputs::*;
+
+    static constexpr float FAN_PULSE_HZ = 1400.0f / 60.0f * 2.0f;
+
+    SimPulseCounter(SimHal& sim, Binding binding)
+        : sim_(sim), binding_(binding), last_us_(sim.clock_us()) {}
+
+    HalResult<uint64_t> get_count() override {
+        update();
+        return {static_cast<uint64_t>(count_), ESP_OK};
+    }
+
+    HalResult<float> get_frequency_hz() override {
+        update();
+        return {running_ ? FAN_PULSE_HZ : 0.0f, ESP_OK};
+    }
+
+    esp_err_t reset() override {
+        update();
+        count_ = 0.0;
+        return ESP_OK;
+    }
+
+private:
+    void update() {
+        int64_t now_us = sim_.clock_us();
+        if (running_ && now_us > last_us_) {
+            count_ += (now_us - last_us_) * 1e-6 * FAN_PULSE_HZ;
+        }
+        last_us_ = now_us;
+        running_ = false;
+        if (binding_) {
+            sim_.with_plant([&](ColdRoomPlant& plant) { running_ = plant.inputs().*binding_; });
+        }
+    }
+
+    SimHal& sim_;
+    Binding binding_;
+    int64_t last_us_;
+    double count_ = 0.0;
+    bool running_ = false;
+};
+
+uint8_t crc8(const uint8_t* data, size_t len) {
+    uint8_t crc = 0;
+    for (size_t i = 0; i < len; i++) {
+        uint8_t byte = data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            uint8_t mix = (crc ^ byte) & 0x01;
+            crc >>= 1;
+            if (mix) {
+                crc ^= 0x8C;
+            }
+            byte >>= 1;
+        }
+    }
+    return crc;
+}
+
+} // namespace
+
+SimHal& SimHal::instance() {
+    static SimHal sim;
+    return sim;
+}
+
+SimHal::SimHal() : clock_(default_clock) {}
+
+void SimHal::set_clock(ClockFn clock) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    clock_ = clock ? clock : default_clock;
+    last_clock_us_ = -1;
+}
+
+void SimHal::sync() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    int64_t now_us = clock_();
+    if (last_clock_us_ >= 0 && now_us > last_clock_us_) {
+        plant_.step((now_us - last_clock_us_) * 1e-6f * time_scale_);
+    }
+    last_clock_us_ = now_us;
+}
+
+float SimHal::temperature(ColdRoomPlant::Probe probe) {
+    sync();
+    std::lock_guard<std::mutex> lock(mutex_);
+    return plant_.temperature(probe);
+}
+
+std::unique_ptr<IGpioOutput> SimHal::create_gpio_output(const char* hal_id) {
+    SimGpioOutput::Binding binding = nullptr;
+    if (contains(hal_id, "COMPRESSOR")) {
+        binding = &ColdRoomPlant::Inputs::compressor;
+    } else if (contains(hal_id, "EVAP") && contains(hal_id, "FAN")) {
+        binding = &ColdRoomPlant::Inputs::evaporator_fan;
+    } else if (contains(hal_id, "DEFROST") || contains(hal_id, "HEATER")) {
+        binding = &ColdRoomPlant::Inputs::defrost_heater;
+    }
+    ESP_LOGI(TAG, "Output %s %s", hal_id, binding ? "bound to plant" : "unbound");
+    return std::make_unique<SimGpioOutput>(*this, binding);
+}
+
+std::unique_ptr<IGpioInput> SimHal::create_gpio_input(const char* hal_id) {
+    SimGpioInput::Binding binding = contains(hal_id, "DOOR") ? &ColdRoomPlant::Inputs::door_open : nullptr;
+    ESP_LOGI(TAG, "Input %s %s", hal_id, binding ? "bound to door" : "unbound");
+    return std::make_unique<SimGpioInput>(*this, binding);
+}
+
+std::unique_ptr<IOneWireBus> SimHal::create_onewire_bus(const char* hal_id) {
+    ESP_LOGI(TAG, "OneWire %s: DS18B20 %016llx", hal_id, make_rom_address(hal_id));
+    return std::make_unique<SimOneWireBus>(*this, hal_id);
+}
+
+std::unique_ptr<IAdcChannel> SimHal::create_adc_channel(const char* hal_id) {
+    return std::make_unique<SimAdcChannel>(*this, hal_id);
+}
+
+std::unique_ptr<IPulseCounter> SimHal::create_pulse_counter(const char* hal_id) {
+    SimPulseCounter::Binding binding = nullptr;
+    if (contains(hal_id, "COND") && contains(hal_id, "FAN")) {
+        binding = &ColdRoomPlant::Inputs::compressor;
+    } else if (contains(hal_id, "FAN")) {
+        binding = &ColdRoomPlant::Inputs::evaporator_fan;
+    }
+    ESP_LOGI(TAG, "Pulse input %s %s", hal_id, binding ? "bound to plant" : "unbound");
+    return std::make_unique<SimPulseCounter>(*this, binding);
+}
+
+uint64_t SimHal::make_rom_address(const char* seed) {
+    // FNV-1a of the hal_id as serial number
+    uint64_t hash = 1469598103934665603ULL;
+    for (const char* c = seed; *c; c++) {
+        hash = (hash ^ static_cast<uint8_t>(*c)) * 1099511628211ULL;
+    }
+
+    uint8_t rom[8];
+    rom[0] = 0x28;
+    for (int i = 1; i < 7; i++) {
+        rom[i] = static_cast<uint8_t>(hash >> (i * 8));
+    }
+    rom[7] = crc8(rom, 7);
+
+    uint64_t address = 0;
+    for (int i = 0; i < 8; i++) {
+        address |= static_cast<uint64_t>(rom[i]) << (i * 8);
+    }
+    return address;
+}
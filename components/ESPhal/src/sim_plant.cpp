@@ -0,0 +1,84 @@
+/**
+ * @file sim_plant.cpp
+ * @brief Implementation of the cold room thermal model
+ */
+
+#include "sim_plant.h"
+#include <algorithm>
+
+static constexpr float MAX_STEP_S = 1.0f;
+
+ColdRoomPlant::ColdRoomPlant() : ColdRoomPlant(Params{}) {}
+
+ColdRoomPlant::ColdRoomPlant(const Params& params) : params_(params) {
+    reset();
+}
+
+void ColdRoomPlant::reset() {
+    air_c_ = params_.ambient_c;
+    evaporator_c_ = params_.ambient_c;
+    product_c_ = params_.ambient_c;
+    frost_kg_ = 0.0f;
+    time_s_ = 0.0;
+    compressor_runtime_s_ = 0.0;
+}
+
+void ColdRoomPlant::step(float dt_s) {
+    // Sub-steps keep the explicit integration stable for large time jumps
+    while (dt_s > 0.0f) {
+        float dt = std::min(dt_s, MAX_STEP_S);
+        integrate(dt);
+        dt_s -= dt;
+    }
+}
+
+void ColdRoomPlant::integrate(float dt) {
+    const Params& p = params_;
+
+    // Frost insulates the coil: half the exchange at 1 kg
+    float coil_ua = inputs_.evaporator_fan ? p.coil_ua_fan_w_k : p.coil_ua_still_w_k;
+    coil_ua /= (1.0f + frost_kg_);
+
+    float compressor_w = 0.0f;
+    if (inputs_.compressor) {
+        compressor_w = std::max(0.0f, p.compressor_w * (1.0f + p.compressor_slope * (evaporator_c_ + 10.0f)));
+        compressor_runtime_s_ += dt;
+    }
+
+    float wall_ua = p.wall_ua_w_k + (inputs_.door_open ? p.door_ua_w_k : 0.0f);
+    float coil_to_air_w = coil_ua * (evaporator_c_ - air_c_);
+    float product_to_air_w = p.product_ua_w_k * (product_c_ - air_c_);
+
+    // Evaporator: compressor pulls heat, heater adds it, frost melting absorbs it
+    float heater_w = inputs_.defrost_heater ? p.heater_w : 0.0f;
+    float melt_w = 0.0f;
+    if (frost_kg_ > 0.0f && evaporator_c_ >= 0.0f && heater_w > 0.0f) {
+        melt_w = std::min(heater_w, frost_kg_ * p.frost_latent_j_kg / dt);
+        frost_kg_ -= melt_w * dt / p.frost_latent_j_kg;
+    }
+    float evaporator_w = heater_w - melt_w - compressor_w - coil_to_air_w;
+
+    // Moisture freezes on a coil below zero
+    if (evaporator_c_ < 0.0f && inputs_.compressor) {
+        float rate = p.frost_rate_kg_s * (inputs_.door_open ? p.frost_door_factor : 1.0f);
+        frost_kg_ += rate * dt;
+    }
+
+    float air_w = wall_ua * (p.ambient_c - air_c_) + coil_to_air_w + product_to_air_w
+                + (inputs_.evaporator_fan ? p.fan_w : 0.0f);
+
+    evaporator_c_ += evaporator_w * dt / p.evaporator_capacity_j_k;
+    air_c_ += air_w * dt / p.air_capacity_j_k;
+    product_c_ -= product_to_air_w * dt / p.product_capacity_j_k;
+    time_s_ += dt;
+}
+
+float ColdRoomPlant::temperature(Probe probe) const {
+    switch (probe) {
+        case Probe::AIR: return air_c_;
+        case Probe::EVAPORATOR: return evaporator_c_;
+        case Probe::PRODUCT: return product_c_;
+        case Probe::AMBIENT: return params_.ambient_c;
+    }
+    return air_c_;
+}
@@ -27,8 +27,9 @@ public:
     
     // IActuatorDriver interface implementation
     esp_err_t init(ESPhal& hal, const nlohmann::json& config) override;
-    esp_err_t execute_command(const nlohmann::json& command) override;
+    esp_err_t execute(const ActuatorCommand& command) override;
     ActuatorStatus get_status() const override;
+    uint32_t get_status_version() const override { return status_version_; }
     std::string get_type() const override { return "GPIO_OUTPUT"; }
     std::string get_description() const override { return "GPIO Output Driver"; }
     bool is_available() const override { return gpio_output_ != nullptr; }
@@ -53,9 +54,11 @@ private:
     IGpioOutput* gpio_output_ = nullptr;
     bool current_state_ = false;
     bool commanded_state_ = false;
+    uint64_t last_change_time_ms_ = 0;
     bool blinking_ = false;
     uint64_t last_blink_time_ = 0;
     bool blink_phase_ = false;
+    uint32_t status_version_ = 0;
     
     // Statistics
     uint32_t state_changes_ = 0;
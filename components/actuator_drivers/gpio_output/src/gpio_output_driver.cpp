@@ -4,16 +4,12 @@
  */
 
 #include "gpio_output_driver.h"
-#include "actuator_driver_registry.h"
 #include "esphal.h"
 #include <esp_log.h>
 #include <esp_timer.h>
 
 static const char* TAG = "GpioOutputDriver";
 
-// Auto-register this driver
-static ActuatorDriverRegistrar<GpioOutputDriver> registrar("GPIO_OUTPUT");
-
 esp_err_t GpioOutputDriver::init(ESPhal& hal, const nlohmann::json& config) {
     ESP_LOGI(TAG, "Initializing GPIO output driver");
     
@@ -47,48 +43,44 @@ esp_err_t GpioOutputDriver::init(ESPhal& hal, const nlohmann::json& config) {
     return ESP_OK;
 }
 
-esp_err_t GpioOutputDriver::execute_command(const nlohmann::json& command) {
-    try {
-        if (command.is_boolean()) {
-            commanded_state_ = command.get<bool>();
+esp_err_t GpioOutputDriver::execute(const ActuatorCommand& command) {
+    bool was_blinking = blinking_;
+    bool was_commanded = commanded_state_;
+    
+    switch (command.type) {
+        case ActuatorCommandType::SET_STATE:
+            commanded_state_ = command.state;
+            blinking_ = false;
+            break;
+        case ActuatorCommandType::SET_DUTY:
+        case ActuatorCommandType::SET_POSITION:
+            commanded_state_ = command.value != 0.0f;
+            blinking_ = false;
+            break;
+        case ActuatorCommandType::TOGGLE:
+            commanded_state_ = !current_state_;
             blinking_ = false;
-        } else if (command.is_string()) {
-            std::string cmd = command.get<std::string>();
-            if (cmd == "on") {
-                commanded_state_ = true;
-                blinking_ = false;
-            } else if (cmd == "off") {
-                commanded_state_ = false;
-                blinking_ = false;
-            } else if (cmd == "toggle") {
-                commanded_state_ = !current_state_;
-                blinking_ = false;
-            } else if (cmd == "blink") {
-                blinking_ = true;
+            break;
+        case ActuatorCommandType::BLINK:
+            blinking_ = command.state;
+            if (blinking_) {
                 last_blink_time_ = get_time_ms();
             }
-        } else if (command.is_object()) {
-            if (command.contains("state")) {
-                commanded_state_ = command["state"].get<bool>();
-                blinking_ = false;
-            }
-            if (command.contains("blink")) {
-                blinking_ = command["blink"].get<bool>();
-                if (blinking_) {
-                    last_blink_time_ = get_time_ms();
-                }
-            }
-        }
-        
-        if (!blinking_) {
-            set_state(commanded_state_);
-        }
-        
-        return ESP_OK;
-    } catch (const nlohmann::json::exception& e) {
-        ESP_LOGE(TAG, "Command parsing error: %s", e.what());
-        return ESP_ERR_INVALID_ARG;
+            break;
+        case ActuatorCommandType::STOP:
+            return emergency_stop();
+        default:
+            return ESP_ERR_NOT_SUPPORTED;
     }
+    
+    if (blinking_ != was_blinking || commanded_state_ != was_commanded) {
+        status_version_++;
+    }
+    if (!blinking_) {
+        set_state(commanded_state_);
+    }
+    
+    return ESP_OK;
 }
 
 void GpioOutputDriver::update() {
@@ -121,6 +113,7 @@ ActuatorStatus GpioOutputDriver::get_status() const {
     ActuatorStatus status;
     status.is_active = current_state_;
     status.current_value = current_state_ ? 1.0f : 0.0f;
+    status.target_value = commanded_state_ ? 1.0f : 0.0f;
     
     if (blinking_) {
         status.state_description = "BLINKING";
@@ -128,7 +121,7 @@ ActuatorStatus GpioOutputDriver::get_status() const {
         status.state_description = current_state_ ? "ON" : "OFF";
     }
     
-    status.last_change_ms = last_on_time_;
+    status.last_change_ms = last_change_time_ms_;
     status.is_healthy = gpio_output_ != nullptr;
     
     return status;
@@ -140,6 +133,7 @@ esp_err_t GpioOutputDriver::emergency_stop() {
     blinking_ = false;
     set_state(false);
     commanded_state_ = false;
+    status_version_++;
     
     return ESP_OK;
 }
@@ -222,13 +216,15 @@ void GpioOutputDriver::set_state(bool state) {
     
     if (ret == ESP_OK && state != current_state_) {
         current_state_ = state;
+        last_change_time_ms_ = get_time_ms();
         state_changes_++;
+        status_version_++;
         
         // Track on time
         if (state) {
-            last_on_time_ = get_time_ms();
+            last_on_time_ = last_change_time_ms_;
         } else if (last_on_time_ > 0) {
-            total_on_time_ms_ += get_time_ms() - last_on_time_;
+            total_on_time_ms_ += last_change_time_ms_ - last_on_time_;
             last_on_time_ = 0;
         }
     }
@@ -0,0 +1,128 @@
+/**
+ * @file actuator_command_mailbox.h
+ * @brief Lock-free command mailbox of one actuator
+ */
+
+#pragma once
+
+#include "actuator_driver_interface.h"
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Bounded multi-producer, single-consumer command queue
+ *
+ * Any task may post; only the actuator owner takes. Each cell carries a
+ * sequence number telling whose turn it is (Vyukov bounded queue), so
+ * neither side takes a lock or disables interrupts. The owner drains the
+ * pending commands per cycle through take_next(): a run of consecutive
+ * setpoints (SET_STATE, SET_DUTY, SET_POSITION) collapses to its last one,
+ * intermediate setpoints are not worth a relay click. STOP, TOGGLE and
+ * BLINK depend on what came before them and are returned one by one in
+ * arrival order.
+ */
+class ActuatorCommandMailbox {
+public:
+    static constexpr uint32_t CAPACITY = 8;     // Power of two
+
+    ActuatorCommandMailbox() {
+        for (uint32_t i = 0; i < CAPACITY; i++) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ActuatorCommandMailbox(const ActuatorCommandMailbox&) = delete;
+    ActuatorCommandMailbox& operator=(const ActuatorCommandMailbox&) = delete;
+
+    /**
+     * @brief Post a command (any task)
+     * @return false if the mailbox is full
+     */
+    bool post(const ActuatorCommand& command) {
+        uint32_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &cells_[pos & (CAPACITY - 1)];
+            uint32_t sequence = cell->sequence.load(std::memory_order_acquire);
+            int32_t diff = static_cast<int32_t>(sequence - pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                overflows_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+        cell->command = command;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Take the oldest pending command (owner only)
+     * @return false if the mailbox is empty
+     */
+    bool take(ActuatorCommand& command) {
+        Cell& cell = cells_[dequeue_pos_ & (CAPACITY - 1)];
+        uint32_t sequence = cell.sequence.load(std::memory_order_acquire);
+        if (sequence != dequeue_pos_ + 1) {
+            return false;
+        }
+        command = cell.command;
+        cell.sequence.store(dequeue_pos_ + CAPACITY, std::memory_order_release);
+        dequeue_pos_++;
+        return true;
+    }
+
+    /**
+     * @brief Take the next command to execute, collapsing setpoint runs (owner only)
+     * @return false if nothing is pending
+     */
+    bool take_next(ActuatorCommand& command) {
+        if (has_held_) {
+            command = held_;
+            has_held_ = false;
+        } else if (!take(command)) {
+            return false;
+        }
+        if (!is_setpoint(command.type)) {
+            return true;
+        }
+
+        // Look ahead; the first non-setpoint ends the run and waits its turn
+        ActuatorCommand next;
+        while (take(next)) {
+            if (!is_setpoint(next.type)) {
+                held_ = next;
+                has_held_ = true;
+                break;
+            }
+            command = next;
+        }
+        return true;
+    }
+
+    uint32_t overflows() const { return overflows_.load(std::memory_order_relaxed); }
+
+private:
+    static bool is_setpoint(ActuatorCommandType type) {
+        return type == ActuatorCommandType::SET_STATE ||
+               type == ActuatorCommandType::SET_DUTY ||
+               type == ActuatorCommandType::SET_POSITION;
+    }
+
+    struct Cell {
+        std::atomic<uint32_t> sequence;
+        ActuatorCommand command;
+    };
+
+    Cell cells_[CAPACITY];
+    std::atomic<uint32_t> enqueue_pos_{0};
+    uint32_t dequeue_pos_ = 0;                  // Owner only
+    ActuatorCommand held_ = {};                 // Owner only, taken during look-ahead
+    bool has_held_ = false;
+    std::atomic<uint32_t> overflows_{0};
+};
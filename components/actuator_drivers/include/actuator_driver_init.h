@@ -0,0 +1,14 @@
+/**
+ * @file actuator_driver_init.h
+ * @brief Initialization of built-in actuator drivers
+ */
+
+#pragma once
+
+/**
+ * @brief Initialize all built-in actuator drivers
+ * 
+ * This function registers all built-in actuator drivers with the registry.
+ * Call this function during system initialization.
+ */
+void initialize_builtin_actuator_drivers();
@@ -15,6 +15,8 @@
 
 #include <string>
 #include <memory>
+#include <optional>
+#include <type_traits>
 #include <nlohmann/json.hpp>
 #include "esp_err.h"
 
@@ -23,14 +25,20 @@ class ESPhal;
 
 /**
  * @brief Actuator status information
+ * 
+ * Plain values only: the module caches one per actuator and compares
+ * versions instead of rebuilding JSON every cycle. String fields point to
+ * literals or driver-owned labels that live as long as the driver.
  */
 struct ActuatorStatus {
-    bool is_active;                  // Current active state
-    float current_value;             // Current value (for PWM, position, etc.)
-    std::string state_description;   // Human-readable state
-    uint32_t last_change_ms;        // Time of last state change
-    bool is_healthy;                // Health status
-    std::optional<std::string> error_message;  // Error if any
+    bool is_active = false;              // Current active state
+    float current_value = 0.0f;          // Current value (for PWM, position, etc.)
+    float target_value = 0.0f;           // Commanded value (differs while ramping)
+    const char* state_description = "";  // Human-readable state
+    uint32_t last_change_ms = 0;         // Time of last state change
+    uint32_t blocked_until_ms = 0;       // End of protection hold, 0 if none
+    bool is_healthy = false;             // Health status
+    const char* error_message = nullptr; // Error if any
     
     /**
      * @brief Convert status to JSON for SharedState
@@ -39,16 +47,128 @@ struct ActuatorStatus {
         nlohmann::json j;
         j["is_active"] = is_active;
         j["current_value"] = current_value;
+        j["target_value"] = target_value;
         j["state"] = state_description;
         j["last_change_ms"] = last_change_ms;
         j["is_healthy"] = is_healthy;
-        if (error_message.has_value()) {
-            j["error"] = error_message.value();
+        if (blocked_until_ms) {
+            j["blocked_until_ms"] = blocked_until_ms;
+        }
+        if (error_message) {
+            j["error"] = error_message;
         }
         return j;
     }
 };
 
+/**
+ * @brief Kind of actuator command
+ */
+enum class ActuatorCommandType : uint8_t {
+    SET_STATE,      // On/off (state)
+    SET_DUTY,       // Duty cycle in percent (value)
+    SET_POSITION,   // Position in percent of travel (value)
+    TOGGLE,         // Invert the commanded state
+    BLINK,          // Start (state = true) or stop blinking
+    STOP            // Safe state, same as emergency_stop()
+};
+
+/**
+ * @brief Typed actuator command
+ *
+ * Trivially copyable, no strings or heap: control loops build it directly
+ * and it travels through the lock-free command mailbox by value. Binary
+ * drivers treat a non-zero duty or position as on.
+ */
+struct ActuatorCommand {
+    ActuatorCommandType type;
+    bool state;
+    float value;
+    uint32_t ramp_ms;       // Transition time, 0 = driver default
+    uint32_t issued_us;     // esp_timer time when issued, for latency accounting
+
+    static ActuatorCommand set_state(bool on) {
+        return {ActuatorCommandType::SET_STATE, on, on ? 100.0f : 0.0f, 0, 0};
+    }
+
+    static ActuatorCommand set_duty(float percent, uint32_t ramp_ms = 0) {
+        return {ActuatorCommandType::SET_DUTY, percent > 0.0f, percent, ramp_ms, 0};
+    }
+
+    static ActuatorCommand set_position(float percent, uint32_t ramp_ms = 0) {
+        return {ActuatorCommandType::SET_POSITION, percent > 0.0f, percent, ramp_ms, 0};
+    }
+
+    static ActuatorCommand stop() {
+        return {ActuatorCommandType::STOP, false, 0.0f, 0, 0};
+    }
+};
+
+static_assert(std::is_trivially_copyable<ActuatorCommand>::value,
+              "ActuatorCommand is passed by value through the mailbox");
+
+/**
+ * @brief Parse a JSON command from external APIs (web, MQTT, SharedState)
+ *
+ * Accepted forms: true/false; a number (duty, non-zero = on for binary
+ * drivers); "on", "off", "toggle", "blink", "stop"; or an object with one
+ * of "position", "duty", "blink", "state" and an optional "ramp_ms".
+ *
+ * @return ESP_OK, or ESP_ERR_INVALID_ARG for an unknown format
+ */
+inline esp_err_t actuator_command_from_json(const nlohmann::json& json, ActuatorCommand& command) {
+    if (json.is_boolean()) {
+        command = ActuatorCommand::set_state(json.get<bool>());
+        return ESP_OK;
+    }
+    if (json.is_number()) {
+        command = ActuatorCommand::set_duty(json.get<float>());
+        return ESP_OK;
+    }
+    if (json.is_string()) {
+        const std::string& name = json.get_ref<const std::string&>();
+        if (name == "on" || name == "off") {
+            command = ActuatorCommand::set_state(name == "on");
+        } else if (name == "toggle") {
+            command = {ActuatorCommandType::TOGGLE, false, 0.0f, 0, 0};
+        } else if (name == "blink") {
+            command = {ActuatorCommandType::BLINK, true, 0.0f, 0, 0};
+        } else if (name == "stop") {
+            command = ActuatorCommand::stop();
+        } else {
+            return ESP_ERR_INVALID_ARG;
+        }
+        return ESP_OK;
+    }
+    if (!json.is_object()) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    uint32_t ramp_ms = 0;
+    auto ramp = json.find("ramp_ms");
+    if (ramp != json.end() && ramp->is_number_unsigned()) {
+        ramp_ms = ramp->get<uint32_t>();
+    }
+    
+    auto position = json.find("position");
+    auto duty = json.find("duty");
+    auto blink = json.find("blink");
+    auto state = json.find("state");
+    if (position != json.end() && position->is_number()) {
+        command = ActuatorCommand::set_position(position->get<float>(), ramp_ms);
+    } else if (duty != json.end() && duty->is_number()) {
+        command = ActuatorCommand::set_duty(duty->get<float>(), ramp_ms);
+    } else if (blink != json.end() && blink->is_boolean()) {
+        command = {ActuatorCommandType::BLINK, blink->get<bool>(), 0.0f, 0, 0};
+    } else if (state != json.end() && state->is_boolean()) {
+        command = ActuatorCommand::set_state(state->get<bool>());
+        command.ramp_ms = ramp_ms;
+    } else {
+        return ESP_ERR_INVALID_ARG;
+    }
+    return ESP_OK;
+}
+
 /**
  * @brief Base interface for all actuator drivers
  * 
@@ -73,17 +193,25 @@ public:
     virtual esp_err_t init(ESPhal& hal, const nlohmann::json& config) = 0;
     
     /**
-     * @brief Execute a command
+     * @brief Execute a typed command
      * 
-     * Commands can be:
-     * - Boolean: true/false for on/off
-     * - Number: 0-100 for PWM duty, position, etc.
-     * - Object: Complex commands with multiple parameters
+     * @param command Command to apply
+     * @return ESP_OK on success, ESP_ERR_NOT_SUPPORTED for a command type
+     *         the actuator cannot perform, other error if it cannot be executed now
+     */
+    virtual esp_err_t execute(const ActuatorCommand& command) = 0;
+    
+    /**
+     * @brief Execute a JSON command (adapter for external APIs)
      * 
-     * @param command Command data from SharedState
-     * @return ESP_OK on success, error code if command cannot be executed
+     * @param command Command in one of the forms of actuator_command_from_json()
+     * @return ESP_ERR_INVALID_ARG for an unknown format, otherwise as execute()
      */
-    virtual esp_err_t execute_command(const nlohmann::json& command) = 0;
+    esp_err_t execute_command(const nlohmann::json& command) {
+        ActuatorCommand typed;
+        esp_err_t ret = actuator_command_from_json(command, typed);
+        return ret == ESP_OK ? execute(typed) : ret;
+    }
     
     /**
      * @brief Get current actuator status
@@ -91,6 +219,16 @@ public:
      */
     virtual ActuatorStatus get_status() const = 0;
     
+    /**
+     * @brief Get status version
+     * 
+     * Incremented by the driver whenever a get_status() field changes, so
+     * the module publishes only on change. Must not advance while the
+     * actuator is idle.
+     * @return Monotonic change counter
+     */
+    virtual uint32_t get_status_version() const = 0;
+    
     /**
      * @brief Get driver type identifier
      * @return String identifier like "RELAY", "PWM", "STEPPER"
@@ -95,7 +95,7 @@ template<typename T>
 class ActuatorDriverRegistrar {
 public:
     explicit ActuatorDriverRegistrar(const std::string& type) {
-        ActuatorDriverRegistry::instance().register_driver(type, []() {
+        ActuatorDriverRegistry::instance().register_driver(type, []() -> std::unique_ptr<IActuatorDriver> {
             return std::make_unique<T>();
         });
     }
@@ -0,0 +1,133 @@
+/**
+ * @file switching_scheduler.h
+ * @brief Board-wide scheduler that staggers relay energizing
+ *
+ * Relay protection timers act per relay; this scheduler coordinates them.
+ * After a power restore the compressor, fans and heaters would otherwise
+ * all close in the same tick and sum their inrush currents.
+ */
+
+#pragma once
+
+#include <nlohmann/json.hpp>
+#include <cstdint>
+#include <string>
+#include "esp_err.h"
+#include "sdkconfig.h"
+
+/**
+ * @brief Inrush behaviour of a switched load
+ */
+enum class LoadClass : uint8_t {
+    CRITICAL,   // Safety loads: jump the queue, bounded wait
+    INDUCTIVE,  // Compressors, fan motors: high, long inrush
+    RESISTIVE,  // Heaters: high but short inrush
+    LIGHT       // Lamps, valves, buzzers: not scheduled
+};
+
+/**
+ * @brief Switching scheduler (singleton)
+ *
+ * Only OFF->ON transitions are scheduled; switching off never waits.
+ * Each energize blocks the next one for the gap of its load class (or the
+ * relay's own inrush delay). Waiting loads are served FIFO, except that
+ * CRITICAL loads go first and wait at most critical_max_wait_ms.
+ *
+ * Not thread-safe: all calls come from the ActuatorModule update task.
+ */
+class SwitchingScheduler {
+public:
+    static constexpr size_t MAX_LOADS = CONFIG_ACTUATOR_DRIVER_MAX_INSTANCES;
+
+    /**
+     * @brief Get scheduler instance
+     */
+    static SwitchingScheduler& instance() {
+        static SwitchingScheduler scheduler;
+        return scheduler;
+    }
+
+    /**
+     * @brief Apply board-wide settings and start the startup hold
+     *
+     * Example:
+     * {"startup_delay_ms": 5000, "critical_max_wait_ms": 200,
+     *  "gap_ms": {"inductive": 3000, "resistive": 1000, "critical": 500}}
+     *
+     * @param config Settings, missing keys keep their defaults
+     * @param now_ms Current time
+     * @return ESP_ERR_INVALID_ARG for malformed values
+     */
+    esp_err_t configure(const nlohmann::json& config, uint64_t now_ms);
+
+    /**
+     * @brief Register a load
+     * @param name Label for diagnostics (must outlive the registration)
+     * @param load_class Inrush class
+     * @param gap_ms Gap after this load energizes, 0 for the class default
+     * @return Load id, or -1 if all slots are taken
+     */
+    int register_load(const char* name, LoadClass load_class, uint32_t gap_ms);
+
+    /**
+     * @brief Release a load id, dropping its pending request
+     */
+    void unregister_load(int id);
+
+    /**
+     * @brief Ask to energize now
+     *
+     * The first call queues the request; keep calling every update until
+     * it is granted. A granted load must switch on in the same cycle.
+     *
+     * @return true if the load may switch on now
+     */
+    bool request_energize(int id, uint64_t now_ms);
+
+    /**
+     * @brief Drop a pending request (command changed to off)
+     */
+    void cancel(int id);
+
+    bool is_pending(int id) const;
+
+    /**
+     * @brief Pending queue in service order and timing statistics
+     */
+    nlohmann::json get_diagnostics(uint64_t now_ms) const;
+
+    /**
+     * @brief Parse "critical", "inductive", "resistive" or "light"
+     */
+    static bool parse_load_class(const std::string& name, LoadClass& load_class);
+    static const char* load_class_name(LoadClass load_class);
+
+private:
+    SwitchingScheduler() = default;
+
+    struct Load {
+        const char* name = nullptr;     // nullptr = free slot
+        LoadClass load_class = LoadClass::INDUCTIVE;
+        uint32_t gap_ms = 0;
+        bool pending = false;
+        uint32_t sequence = 0;          // Arrival order of the pending request
+        uint64_t requested_ms = 0;
+    };
+
+    bool is_next(int id) const;
+    uint32_t gap_for(const Load& load) const;
+
+    Load loads_[MAX_LOADS];
+    uint32_t next_sequence_ = 0;
+    uint64_t next_free_ms_ = 0;         // Earliest time for the next energize
+    uint64_t startup_until_ms_ = 0;
+
+    // Settings
+    uint32_t class_gap_ms_[4] = {500, 3000, 1000, 0};
+    uint32_t critical_max_wait_ms_ = 200;
+
+    // Statistics
+    uint32_t grants_ = 0;
+    uint32_t max_wait_ms_ = 0;
+    uint32_t max_critical_wait_ms_ = 0;
+};
@@ -4,13 +4,17 @@
  * 
  * Self-contained driver for PWM control with features like
  * soft start/stop, duty cycle limits, and frequency configuration.
+ * Ramps run on the LEDC hardware fade engine, channels come from the
+ * ESPhal LEDC allocator.
  */
 
 #pragma once
 
 #include "actuator_driver_interface.h"
+#include "ledc_allocator.h"
 #include "driver/ledc.h"
 #include <esp_timer.h>
+#include <atomic>
 
 /**
  * @brief PWM output actuator driver
@@ -18,7 +22,7 @@
  * Features:
  * - Variable duty cycle control (0-100%)
  * - Configurable frequency
- * - Soft start/stop with ramping
+ * - Soft start/stop with hardware-timed ramps (LEDC fade)
  * - Min/max duty limits
  * - Gamma correction for LED dimming
  */
@@ -29,8 +33,9 @@ public:
     
     // IActuatorDriver interface implementation
     esp_err_t init(ESPhal& hal, const nlohmann::json& config) override;
-    esp_err_t execute_command(const nlohmann::json& command) override;
+    esp_err_t execute(const ActuatorCommand& command) override;
     ActuatorStatus get_status() const override;
+    uint32_t get_status_version() const override { return status_version_; }
     std::string get_type() const override { return "PWM"; }
     std::string get_description() const override { return "PWM Output Driver"; }
     bool is_available() const override { return initialized_; }
@@ -56,13 +61,16 @@ private:
     
     // Runtime state
     bool initialized_ = false;
-    ledc_channel_t channel_;
-    ledc_timer_t timer_;
+    LedcAllocator* ledc_ = nullptr;
+    ledc_channel_t channel_ = LEDC_CHANNEL_MAX;
+    ledc_timer_t timer_ = LEDC_TIMER_MAX;
     float current_duty_ = 0.0f;
     float target_duty_ = 0.0f;
-    uint64_t ramp_start_time_ = 0;
-    float ramp_start_duty_ = 0.0f;
-    bool ramping_ = false;
+    bool ramping_ = false;               // Hardware fade in progress
+    uint32_t fade_target_raw_ = 0;       // Raw duty the fade ends at
+    std::atomic<bool> fade_done_{false}; // Set by the fade-end callback
+    uint64_t last_change_time_ms_ = 0;
+    uint32_t status_version_ = 0;
     
     // Statistics
     uint32_t command_count_ = 0;
@@ -70,11 +78,15 @@ private:
     uint64_t last_on_time_ = 0;
     
     // Helper methods
-    esp_err_t init_pwm();
+    esp_err_t init_pwm(ESPhal& hal);
     void set_duty_immediate(float duty_percent);
-    void start_ramp(float target_duty);
+    void start_ramp(float target_duty, uint32_t ramp_time_ms);
+    void stop_ramp();
     void update_ramp();
+    void track_duty(float duty_percent);
     uint32_t percent_to_duty(float percent) const;
+    float duty_to_percent(uint32_t duty) const;
     float apply_gamma(float linear_value) const;
+    static bool on_fade_end(const ledc_cb_param_t* param, void* arg);
     uint64_t get_time_ms() const;
 };
\ No newline at end of file
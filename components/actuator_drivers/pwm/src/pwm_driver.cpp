@@ -4,23 +4,24 @@
  */
 
 #include "pwm_driver.h"
-#include "actuator_driver_registry.h"
+#include "esphal.h"
+#include <esp_attr.h>
 #include <esp_log.h>
 #include <cmath>
 #include <algorithm>
 
 static const char* TAG = "PwmDriver";
 
-// Auto-register this driver
-static ActuatorDriverRegistrar<PwmDriver> registrar("PWM");
-
-// Static channel allocation (simple approach)
-static uint8_t allocated_channels = 0;
-
 PwmDriver::~PwmDriver() {
     if (initialized_) {
+        stop_ramp();
+        ledc_cbs_t callbacks = {};
+        ledc_cb_register(LEDC_LOW_SPEED_MODE, channel_, &callbacks, nullptr);
         ledc_stop(LEDC_LOW_SPEED_MODE, channel_, 0);
     }
+    if (ledc_) {
+        ledc_->release({channel_, timer_});
+    }
 }
 
 esp_err_t PwmDriver::init(ESPhal& hal, const nlohmann::json& config) {
@@ -48,7 +49,7 @@ esp_err_t PwmDriver::init(ESPhal& hal, const nlohmann::json& config) {
     }
     
     // Initialize PWM
-    esp_err_t ret = init_pwm();
+    esp_err_t ret = init_pwm(hal);
     if (ret != ESP_OK) {
         return ret;
     }
@@ -63,25 +64,17 @@ esp_err_t PwmDriver::init(ESPhal& hal, const nlohmann::json& config) {
     return ESP_OK;
 }
 
-esp_err_t PwmDriver::init_pwm() {
-    // Allocate channel and timer
-    channel_ = (ledc_channel_t)(allocated_channels % LEDC_CHANNEL_MAX);
-    timer_ = (ledc_timer_t)((allocated_channels / LEDC_CHANNEL_MAX) % LEDC_TIMER_MAX);
-    allocated_channels++;
-    
-    // Configure timer
-    ledc_timer_config_t timer_conf = {
-        .speed_mode = LEDC_LOW_SPEED_MODE,
-        .duty_resolution = (ledc_timer_bit_t)config_.resolution_bits,
-        .timer_num = timer_,
-        .freq_hz = config_.frequency,
-        .clk_cfg = LEDC_AUTO_CLK
-    };    
-    esp_err_t ret = ledc_timer_config(&timer_conf);
+esp_err_t PwmDriver::init_pwm(ESPhal& hal) {
+    // Channel and a timer shared with equal frequencies (configured by the allocator)
+    LedcAllocator::Lease lease;
+    esp_err_t ret = hal.get_ledc_allocator().acquire(config_.frequency, config_.resolution_bits, lease);
     if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "Failed to configure timer: %s", esp_err_to_name(ret));
+        ESP_LOGE(TAG, "No LEDC channel for GPIO %d: %s", config_.gpio_num, esp_err_to_name(ret));
         return ret;
     }
+    ledc_ = &hal.get_ledc_allocator();
+    channel_ = lease.channel;
+    timer_ = lease.timer;
     
     // Configure channel
     ledc_channel_config_t channel_conf = {
@@ -103,37 +96,50 @@ esp_err_t PwmDriver::init_pwm() {
         return ret;
     }
     
+    // Fade-end notification from the LEDC interrupt
+    ledc_cbs_t callbacks = {};
+    callbacks.fade_cb = on_fade_end;
+    ret = ledc_cb_register(LEDC_LOW_SPEED_MODE, channel_, &callbacks, this);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to register fade callback: %s", esp_err_to_name(ret));
+        return ret;
+    }
+    
     return ESP_OK;
 }
 
-esp_err_t PwmDriver::execute_command(const nlohmann::json& command) {
+esp_err_t PwmDriver::execute(const ActuatorCommand& command) {
     float new_duty = 0.0f;
     
-    // Parse command
-    try {
-        if (command.is_number()) {
-            new_duty = command.get<float>();
-        } else if (command.is_object() && command.contains("duty")) {
-            new_duty = command["duty"].get<float>();
-        } else {
-            ESP_LOGE(TAG, "Invalid command format");
-            return ESP_ERR_INVALID_ARG;
-        }
-    } catch (const nlohmann::json::exception& e) {
-        ESP_LOGE(TAG, "Command parsing error: %s", e.what());
-        return ESP_ERR_INVALID_ARG;
-    }    
+    switch (command.type) {
+        case ActuatorCommandType::SET_DUTY:
+        case ActuatorCommandType::SET_POSITION:
+            new_duty = command.value;
+            break;
+        case ActuatorCommandType::SET_STATE:
+            new_duty = command.state ? config_.max_duty_percent : 0.0f;
+            break;
+        case ActuatorCommandType::STOP:
+            return emergency_stop();
+        default:
+            return ESP_ERR_NOT_SUPPORTED;
+    }
+    
     // Clamp to configured limits
     new_duty = std::max(config_.min_duty_percent, 
                        std::min(config_.max_duty_percent, new_duty));
     
     target_duty_ = new_duty;
     command_count_++;
+    last_change_time_ms_ = get_time_ms();
+    status_version_++;
     
-    // Apply duty cycle
-    if (config_.ramp_time_ms > 0 && std::abs(new_duty - current_duty_) > 0.1f) {
-        start_ramp(new_duty);
+    // Apply duty cycle, the command may override the configured ramp time
+    uint32_t ramp_time_ms = command.ramp_ms ? command.ramp_ms : config_.ramp_time_ms;
+    if (ramp_time_ms > 0 && std::abs(new_duty - current_duty_) > 0.1f) {
+        start_ramp(new_duty, ramp_time_ms);
     } else {
+        stop_ramp();
         set_duty_immediate(new_duty);
     }
     
@@ -157,14 +163,14 @@ ActuatorStatus PwmDriver::get_status() const {
     ActuatorStatus status;
     status.is_active = current_duty_ > 0.0f;
     status.current_value = current_duty_;
-    status.state_description = std::to_string((int)current_duty_) + "%";
-    status.last_change_ms = ramp_start_time_;
-    status.is_healthy = initialized_;
-    
+    status.target_value = target_duty_;
     if (ramping_) {
-        status.state_description += " (ramping to " + 
-                                   std::to_string((int)target_duty_) + "%)";
+        status.state_description = "RAMPING";
+    } else {
+        status.state_description = current_duty_ > 0.0f ? "ON" : "OFF";
     }
+    status.last_change_ms = last_change_time_ms_;
+    status.is_healthy = initialized_;
     
     return status;
 }
@@ -172,9 +178,11 @@ esp_err_t PwmDriver::emergency_stop() {
     ESP_LOGW(TAG, "Emergency stop activated");
     
     // Stop immediately
-    ramping_ = false;
+    stop_ramp();
     set_duty_immediate(0.0f);
     target_duty_ = 0.0f;
+    last_change_time_ms_ = get_time_ms();
+    status_version_++;
     
     return ESP_OK;
 }
@@ -267,6 +275,7 @@ nlohmann::json PwmDriver::get_diagnostics() const {
         {"current_duty", current_duty_},
         {"target_duty", target_duty_},
         {"ramping", ramping_},
+        {"fade_target_raw", fade_target_raw_},
         {"command_count", command_count_},
         {"total_on_time_ms", total_on_time_ms_},
         {"gpio_num", config_.gpio_num},
@@ -289,37 +298,81 @@ void PwmDriver::set_duty_immediate(float duty_percent) {
     esp_err_t ret = ledc_set_duty(LEDC_LOW_SPEED_MODE, channel_, duty);
     if (ret == ESP_OK) {
         ledc_update_duty(LEDC_LOW_SPEED_MODE, channel_);
-        current_duty_ = duty_percent;
-        
-        // Update on-time tracking
-        if (duty_percent > 0.0f && last_on_time_ == 0) {
-            last_on_time_ = get_time_ms();
-        } else if (duty_percent == 0.0f && last_on_time_ > 0) {
-            total_on_time_ms_ += get_time_ms() - last_on_time_;
-            last_on_time_ = 0;
-        }
+        track_duty(duty_percent);
     }
 }
-void PwmDriver::start_ramp(float target_duty) {
-    ramp_start_time_ = get_time_ms();
-    ramp_start_duty_ = current_duty_;
+
+void PwmDriver::start_ramp(float target_duty, uint32_t ramp_time_ms) {
+    stop_ramp();
+    
+    // The fade is linear in raw duty: with gamma only the end points are corrected
+    uint32_t target_raw = percent_to_duty(apply_gamma(target_duty / 100.0f) * 100.0f);
+    if (target_raw == ledc_get_duty(LEDC_LOW_SPEED_MODE, channel_)) {
+        set_duty_immediate(target_duty);
+        return;
+    }
+    
+    fade_target_raw_ = target_raw;
+    fade_done_.store(false, std::memory_order_relaxed);
+    esp_err_t ret = ledc_set_fade_with_time(LEDC_LOW_SPEED_MODE, channel_, target_raw, ramp_time_ms);
+    if (ret == ESP_OK) {
+        ret = ledc_fade_start(LEDC_LOW_SPEED_MODE, channel_, LEDC_FADE_NO_WAIT);
+    }
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Fade rejected, setting duty directly: %s", esp_err_to_name(ret));
+        set_duty_immediate(target_duty);
+        return;
+    }
+    
     ramping_ = true;
 }
 
+void PwmDriver::stop_ramp() {
+    if (!ramping_) {
+        return;
+    }
+    ledc_fade_stop(LEDC_LOW_SPEED_MODE, channel_);
+    ramping_ = false;
+    track_duty(duty_to_percent(ledc_get_duty(LEDC_LOW_SPEED_MODE, channel_)));
+    status_version_++;
+}
+
 void PwmDriver::update_ramp() {
-    uint64_t now = get_time_ms();
-    uint64_t elapsed = now - ramp_start_time_;
+    // Hardware steps the duty; only follow it for status
+    uint32_t duty = ledc_get_duty(LEDC_LOW_SPEED_MODE, channel_);
     
-    if (elapsed >= config_.ramp_time_ms) {
-        // Ramp complete
-        set_duty_immediate(target_duty_);
-        ramping_ = false;
-    } else {
-        // Calculate intermediate duty
-        float progress = (float)elapsed / config_.ramp_time_ms;
-        float duty = ramp_start_duty_ + (target_duty_ - ramp_start_duty_) * progress;
-        set_duty_immediate(duty);
+    // An end event left over from a stopped fade does not reach the target
+    if (!fade_done_.exchange(false, std::memory_order_relaxed) || duty != fade_target_raw_) {
+        track_duty(duty_to_percent(duty));
+        return;
     }
+    
+    ramping_ = false;
+    track_duty(target_duty_);
+    status_version_++;
+}
+
+void PwmDriver::track_duty(float duty_percent) {
+    // Ramp steps below 1% do not count as a status change
+    if (std::lround(duty_percent) != std::lround(current_duty_)) {
+        status_version_++;
+    }
+    current_duty_ = duty_percent;
+    
+    // Update on-time tracking
+    if (duty_percent > 0.0f && last_on_time_ == 0) {
+        last_on_time_ = get_time_ms();
+    } else if (duty_percent == 0.0f && last_on_time_ > 0) {
+        total_on_time_ms_ += get_time_ms() - last_on_time_;
+        last_on_time_ = 0;
+    }
+}
+
+bool IRAM_ATTR PwmDriver::on_fade_end(const ledc_cb_param_t* param, void* arg) {
+    if (param->event == LEDC_FADE_END_EVT) {
+        static_cast<PwmDriver*>(arg)->fade_done_.store(true, std::memory_order_relaxed);
+    }
+    return false;
 }
 
 uint32_t PwmDriver::percent_to_duty(float percent) const {
@@ -327,6 +380,15 @@ uint32_t PwmDriver::percent_to_duty(float percent) const {
     return (uint32_t)((percent / 100.0f) * max_duty);
 }
 
+float PwmDriver::duty_to_percent(uint32_t duty) const {
+    uint32_t max_duty = (1 << config_.resolution_bits) - 1;
+    float linear_value = (float)duty / max_duty;
+    if (config_.gamma != 1.0f) {
+        linear_value = std::pow(linear_value, 1.0f / config_.gamma);
+    }
+    return linear_value * 100.0f;
+}
+
 float PwmDriver::apply_gamma(float linear_value) const {
     if (config_.gamma == 1.0f) {
         return linear_value;
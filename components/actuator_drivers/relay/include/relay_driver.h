@@ -9,6 +9,7 @@
 #pragma once
 
 #include "actuator_driver_interface.h"
+#include "switching_scheduler.h"
 #include "hal_interfaces.h"
 #include <esp_timer.h>
 
@@ -18,19 +19,21 @@
  * Features:
  * - Binary on/off control
  * - Minimum on/off time protection
+ * - Minimum start-to-start interval (compressor anti-short-cycle)
  * - State change counting
- * - Inrush current delay support
+ * - Switch-on staggered with other loads by the SwitchingScheduler
  * - Active high/low configuration
  */
 class RelayDriver : public IActuatorDriver {
 public:
     RelayDriver() = default;
-    ~RelayDriver() override = default;
+    ~RelayDriver() override;
     
     // IActuatorDriver interface implementation
     esp_err_t init(ESPhal& hal, const nlohmann::json& config) override;
-    esp_err_t execute_command(const nlohmann::json& command) override;
+    esp_err_t execute(const ActuatorCommand& command) override;
     ActuatorStatus get_status() const override;
+    uint32_t get_status_version() const override { return status_version_; }
     std::string get_type() const override { return "RELAY"; }
     std::string get_description() const override { return "Relay Output Driver"; }
     bool is_available() const override { return gpio_output_ != nullptr; }
@@ -47,7 +50,9 @@ private:
         std::string hal_id;              // GPIO output HAL identifier
         uint32_t min_off_time_s = 0;     // Minimum off time in seconds
         uint32_t min_on_time_s = 0;      // Minimum on time in seconds  
-        uint32_t inrush_delay_ms = 0;    // Delay after turn on (for inrush current)
+        uint32_t min_restart_interval_s = 0;  // Minimum time between two starts
+        uint32_t inrush_delay_ms = 0;    // Switching gap after turn on, 0 = load class default
+        LoadClass load_class = LoadClass::INDUCTIVE;
         bool active_low = false;         // Invert relay logic
         bool default_state = false;      // Default state on init
         std::string on_label = "ON";     // Label for ON state
@@ -60,6 +65,10 @@ private:
     uint64_t last_change_time_ms_ = 0;
     uint64_t protection_end_time_ms_ = 0;
     bool protection_active_ = false;
+    uint64_t last_start_time_ms_ = 0;   // 0 = not started since boot
+    int switch_slot_ = -1;              // SwitchingScheduler load id
+    bool switch_pending_ = false;       // Waiting for a switching slot
+    uint32_t status_version_ = 0;
     
     // Statistics
     uint32_t state_changes_ = 0;
@@ -69,6 +78,8 @@ private:
     
     // Helper methods
     bool can_change_state(bool new_state) const;
+    void switch_to_commanded();
+    void set_pending(bool pending);
     void apply_state(bool state);
     uint64_t get_time_ms() const;
     uint32_t get_time_in_state_ms() const;
@@ -4,16 +4,14 @@
  */
 
 #include "relay_driver.h"
-#include "actuator_driver_registry.h"
 #include "esphal.h"
 #include <esp_log.h>
-#include <freertos/FreeRTOS.h>
-#include <freertos/task.h>
 
 static const char* TAG = "RelayDriver";
 
-// Auto-register this driver
-static ActuatorDriverRegistrar<RelayDriver> registrar("RELAY");
+RelayDriver::~RelayDriver() {
+    SwitchingScheduler::instance().unregister_load(switch_slot_);
+}
 
 esp_err_t RelayDriver::init(ESPhal& hal, const nlohmann::json& config) {
     ESP_LOGI(TAG, "Initializing relay driver");
@@ -23,11 +21,18 @@ esp_err_t RelayDriver::init(ESPhal& hal, const nlohmann::json& config) {
         config_.hal_id = config["hal_id"].get<std::string>();
         config_.min_off_time_s = config.value("min_off_time_s", 0);
         config_.min_on_time_s = config.value("min_on_time_s", 0);
+        config_.min_restart_interval_s = config.value("min_restart_interval_s", 0);
         config_.inrush_delay_ms = config.value("inrush_delay_ms", 0);
         config_.active_low = config.value("active_low", false);
         config_.default_state = config.value("default_state", false);
         config_.on_label = config.value("on_label", "ON");
         config_.off_label = config.value("off_label", "OFF");
+        
+        std::string load_class = config.value("load_class", "inductive");
+        if (!SwitchingScheduler::parse_load_class(load_class, config_.load_class)) {
+            ESP_LOGE(TAG, "Unknown load_class '%s'", load_class.c_str());
+            return ESP_ERR_INVALID_ARG;
+        }
     } catch (const nlohmann::json::exception& e) {
         ESP_LOGE(TAG, "Configuration error: %s", e.what());
         return ESP_ERR_INVALID_ARG;
@@ -41,8 +46,12 @@ esp_err_t RelayDriver::init(ESPhal& hal, const nlohmann::json& config) {
         return ESP_FAIL;
     }
     
-    // Set initial state
-    apply_state(config_.default_state);
+    switch_slot_ = SwitchingScheduler::instance().register_load(
+        config_.hal_id.c_str(), config_.load_class, config_.inrush_delay_ms);
+    
+    // Start released; a default ON goes through the scheduler and the
+    // minimum off time, both counted from boot (power restore)
+    apply_state(false);
     commanded_state_ = config_.default_state;
     last_change_time_ms_ = get_time_ms();
     
@@ -53,45 +62,46 @@ esp_err_t RelayDriver::init(ESPhal& hal, const nlohmann::json& config) {
     return ESP_OK;
 }
 
-esp_err_t RelayDriver::execute_command(const nlohmann::json& command) {
+esp_err_t RelayDriver::execute(const ActuatorCommand& command) {
     bool new_state = false;
     
-    // Parse command
-    try {
-        if (command.is_boolean()) {
-            new_state = command.get<bool>();
-        } else if (command.is_number()) {
-            // Accept 0/1 as off/on
-            new_state = command.get<int>() != 0;
-        } else if (command.is_object() && command.contains("state")) {
-            new_state = command["state"].get<bool>();
-        } else {
-            ESP_LOGE(TAG, "Invalid command format");
-            return ESP_ERR_INVALID_ARG;
-        }
-    } catch (const nlohmann::json::exception& e) {
-        ESP_LOGE(TAG, "Command parsing error: %s", e.what());
-        return ESP_ERR_INVALID_ARG;
-    }    
-    commanded_state_ = new_state;
+    switch (command.type) {
+        case ActuatorCommandType::SET_STATE:
+            new_state = command.state;
+            break;
+        case ActuatorCommandType::SET_DUTY:
+        case ActuatorCommandType::SET_POSITION:
+            // Accept 0/1 (or any duty) as off/on
+            new_state = command.value != 0.0f;
+            break;
+        case ActuatorCommandType::TOGGLE:
+            new_state = !commanded_state_;
+            break;
+        case ActuatorCommandType::STOP:
+            return emergency_stop();
+        default:
+            return ESP_ERR_NOT_SUPPORTED;
+    }
+    
+    if (new_state != commanded_state_) {
+        commanded_state_ = new_state;
+        status_version_++;
+    }
+    
+    if (new_state == current_state_) {
+        set_pending(false);
+        return ESP_OK;
+    }
     
-    // Check if we can change state (protection timers)
+    // Check if we can change state (protection timers); update() retries
     if (!can_change_state(new_state)) {
         protection_blocks_++;
         ESP_LOGW(TAG, "State change blocked by protection timer");
         return ESP_ERR_INVALID_STATE;
     }
     
-    // Apply new state
-    if (new_state != current_state_) {
-        apply_state(new_state);
-        
-        // Handle inrush delay if turning on
-        if (new_state && config_.inrush_delay_ms > 0) {
-            vTaskDelay(pdMS_TO_TICKS(config_.inrush_delay_ms));
-        }
-    }
-    
+    // Switching on may wait for a slot; update() keeps asking
+    switch_to_commanded();
     return ESP_OK;
 }
 
@@ -99,18 +109,19 @@ ActuatorStatus RelayDriver::get_status() const {
     ActuatorStatus status;
     status.is_active = current_state_;
     status.current_value = current_state_ ? 1.0f : 0.0f;
-    status.state_description = current_state_ ? config_.on_label : config_.off_label;
+    status.target_value = commanded_state_ ? 1.0f : 0.0f;
+    if (switch_pending_) {
+        status.state_description = "PENDING";
+    } else {
+        status.state_description = current_state_ ? config_.on_label.c_str() : config_.off_label.c_str();
+    }
     status.last_change_ms = last_change_time_ms_;
     status.is_healthy = gpio_output_ != nullptr;
     
+    // End time rather than remaining time, so the status stays constant while held
     if (protection_active_) {
-        uint64_t remaining_ms = 0;
-        uint64_t now = get_time_ms();
-        if (protection_end_time_ms_ > now) {
-            remaining_ms = protection_end_time_ms_ - now;
-        }
-        status.error_message = "Protection timer active (" + 
-                              std::to_string(remaining_ms / 1000) + "s remaining)";
+        status.blocked_until_ms = protection_end_time_ms_;
+        status.error_message = "Protection timer active";
     }
     
     return status;
@@ -121,15 +132,16 @@ void RelayDriver::update() {
         uint64_t now = get_time_ms();
         if (now >= protection_end_time_ms_) {
             protection_active_ = false;
+            status_version_++;
             ESP_LOGI(TAG, "Protection timer expired");
-            
-            // Try to apply commanded state
-            if (commanded_state_ != current_state_ && can_change_state(commanded_state_)) {
-                apply_state(commanded_state_);
-            }
         }
     }
     
+    // Apply a commanded state held back by protection or a switching slot
+    if (commanded_state_ != current_state_ && can_change_state(commanded_state_)) {
+        switch_to_commanded();
+    }
+    
     // Update total on time
     if (current_state_ && last_on_time_ms_ > 0) {
         uint64_t now = get_time_ms();
@@ -143,8 +155,10 @@ esp_err_t RelayDriver::emergency_stop() {
     
     // Force relay to safe state (off) immediately
     protection_active_ = false;  // Override protection
+    set_pending(false);
     apply_state(false);
     commanded_state_ = false;
+    status_version_++;
     
     return ESP_OK;
 }
@@ -154,7 +168,9 @@ nlohmann::json RelayDriver::get_config() const {
         {"hal_id", config_.hal_id},
         {"min_off_time_s", config_.min_off_time_s},
         {"min_on_time_s", config_.min_on_time_s},
+        {"min_restart_interval_s", config_.min_restart_interval_s},
         {"inrush_delay_ms", config_.inrush_delay_ms},
+        {"load_class", SwitchingScheduler::load_class_name(config_.load_class)},
         {"active_low", config_.active_low},
         {"default_state", config_.default_state},
         {"on_label", config_.on_label},
@@ -171,6 +187,10 @@ esp_err_t RelayDriver::set_config(const nlohmann::json& config) {
             config_.min_on_time_s = config["min_on_time_s"].get<uint32_t>();
         }
         
+        if (config.contains("min_restart_interval_s")) {
+            config_.min_restart_interval_s = config["min_restart_interval_s"].get<uint32_t>();
+        }
+        
         if (config.contains("inrush_delay_ms")) {
             config_.inrush_delay_ms = config["inrush_delay_ms"].get<uint32_t>();
         }
@@ -203,10 +223,18 @@ nlohmann::json RelayDriver::get_ui_schema() const {
                 {"maximum", 3600},
                 {"default", 0}
             }},
+            {"min_restart_interval_s", {
+                {"type", "integer"},
+                {"title", "Minimum Restart Interval (seconds)"},
+                {"description", "Minimum time between two starts (anti-short-cycle)"},
+                {"minimum", 0},
+                {"maximum", 3600},
+                {"default", 0}
+            }},
             {"inrush_delay_ms", {
                 {"type", "integer"},
                 {"title", "Inrush Delay (ms)"},
-                {"description", "Delay after turning ON for inrush current"},
+                {"description", "Gap before the next load may switch ON, 0 = load class default"},
                 {"minimum", 0},
                 {"maximum", 5000},
                 {"default", 0}
@@ -225,6 +253,8 @@ nlohmann::json RelayDriver::get_diagnostics() const {
         {"state_changes", state_changes_},
         {"protection_blocks", protection_blocks_},
         {"protection_active", protection_active_},
+        {"switch_pending", switch_pending_},
+        {"load_class", SwitchingScheduler::load_class_name(config_.load_class)},
         {"total_on_time_s", total_on_time_s_},
         {"hal_id", config_.hal_id}
     };
@@ -242,12 +272,37 @@ bool RelayDriver::can_change_state(bool new_state) const {
         // Turning OFF - check minimum ON time
         return time_in_state_s >= config_.min_on_time_s;
     } else if (!current_state_ && new_state) {
-        // Turning ON - check minimum OFF time
+        // Turning ON - check minimum OFF time and start-to-start interval
+        if (last_start_time_ms_ > 0 &&
+            get_time_ms() - last_start_time_ms_ < config_.min_restart_interval_s * 1000ULL) {
+            return false;
+        }
         return time_in_state_s >= config_.min_off_time_s;
     }
     
     return true;
 }
+
+void RelayDriver::switch_to_commanded() {
+    if (commanded_state_ &&
+        !SwitchingScheduler::instance().request_energize(switch_slot_, get_time_ms())) {
+        set_pending(true);
+        return;
+    }
+    set_pending(false);
+    apply_state(commanded_state_);
+}
+
+void RelayDriver::set_pending(bool pending) {
+    if (pending == switch_pending_) {
+        return;
+    }
+    switch_pending_ = pending;
+    if (!pending) {
+        SwitchingScheduler::instance().cancel(switch_slot_);
+    }
+    status_version_++;
+}
 void RelayDriver::apply_state(bool state) {
     if (!gpio_output_) {
         return;
@@ -263,6 +318,7 @@ void RelayDriver::apply_state(bool state) {
             current_state_ = state;
             last_change_time_ms_ = get_time_ms();
             state_changes_++;
+            status_version_++;
             
             // Start protection timer
             if (state && config_.min_on_time_s > 0) {
@@ -275,6 +331,7 @@ void RelayDriver::apply_state(bool state) {
             
             // Track on time
             if (state) {
+                last_start_time_ms_ = last_change_time_ms_;
                 last_on_time_ms_ = last_change_time_ms_;
             } else if (last_on_time_ms_ > 0) {
                 total_on_time_s_ += (last_change_time_ms_ - last_on_time_ms_) / 1000;
@@ -0,0 +1,53 @@
+/**
+ * @file actuator_driver_init.cpp
+ * @brief Implementation of built-in actuator driver initialization
+ * 
+ * Drivers are conditionally compiled based on Kconfig settings
+ * to save flash space when drivers are not needed.
+ */
+
+#include "actuator_driver_init.h"
+#include "actuator_driver_registry.h"
+#include <esp_log.h>
+
+// Conditionally include driver headers
+#ifdef CONFIG_ENABLE_RELAY_DRIVER
+#include "relay_driver.h"
+#endif
+
+#ifdef CONFIG_ENABLE_PWM_DRIVER
+#include "pwm_driver.h"
+#endif
+
+#ifdef CONFIG_ENABLE_GPIO_OUTPUT_DRIVER
+#include "gpio_output_driver.h"
+#endif
+
+static const char* TAG = "ActuatorDriverInit";
+
+void initialize_builtin_actuator_drivers() {
+    ESP_LOGI(TAG, "Initializing built-in actuator drivers...");
+    
+    auto& registry = ActuatorDriverRegistry::instance();
+    
+#ifdef CONFIG_ENABLE_RELAY_DRIVER
+    registry.register_driver("RELAY", []() -> std::unique_ptr<IActuatorDriver> {
+        return std::make_unique<RelayDriver>();
+    });
+#endif
+
+#ifdef CONFIG_ENABLE_PWM_DRIVER
+    registry.register_driver("PWM", []() -> std::unique_ptr<IActuatorDriver> {
+        return std::make_unique<PwmDriver>();
+    });
+#endif
+
+#ifdef CONFIG_ENABLE_GPIO_OUTPUT_DRIVER
+    registry.register_driver("GPIO_OUTPUT", []() -> std::unique_ptr<IActuatorDriver> {
+        return std::make_unique<GpioOutputDriver>();
+    });
+#endif
+    
+    ESP_LOGI(TAG, "Built-in actuator driver registration complete. Total drivers: %zu", 
+             registry.get_registered_types().size());
+}
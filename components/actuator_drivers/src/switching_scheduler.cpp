@@ -0,0 +1,191 @@
+/**
+ * @file switching_scheduler.cpp
+ * @brief Implementation of the relay switching scheduler
+ */
+
+#include "switching_scheduler.h"
+#include <esp_log.h>
+#include <algorithm>
+
+static const char* TAG = "SwitchScheduler";
+
+static const char* const CLASS_NAMES[] = {"critical", "inductive", "resistive", "light"};
+
+esp_err_t SwitchingScheduler::configure(const nlohmann::json& config, uint64_t now_ms) {
+    uint32_t startup_delay_ms = config.value("startup_delay_ms", 0u);
+    critical_max_wait_ms_ = config.value("critical_max_wait_ms", critical_max_wait_ms_);
+
+    if (config.contains("gap_ms")) {
+        const auto& gaps = config["gap_ms"];
+        if (!gaps.is_object()) {
+            ESP_LOGE(TAG, "gap_ms must be an object");
+            return ESP_ERR_INVALID_ARG;
+        }
+        for (auto it = gaps.begin(); it != gaps.end(); ++it) {
+            LoadClass load_class;
+            if (!parse_load_class(it.key(), load_class) || !it.value().is_number_unsigned()) {
+                ESP_LOGE(TAG, "Bad gap_ms entry '%s'", it.key().c_str());
+                return ESP_ERR_INVALID_ARG;
+            }
+            class_gap_ms_[static_cast<size_t>(load_class)] = it.value().get<uint32_t>();
+        }
+    }
+
+    startup_until_ms_ = now_ms + startup_delay_ms;
+    ESP_LOGI(TAG, "Startup hold %lu ms, gaps: inductive %lu, resistive %lu, critical %lu ms (max wait %lu)",
+             static_cast<unsigned long>(startup_delay_ms),
+             static_cast<unsigned long>(class_gap_ms_[static_cast<size_t>(LoadClass::INDUCTIVE)]),
+             static_cast<unsigned long>(class_gap_ms_[static_cast<size_t>(LoadClass::RESISTIVE)]),
+             static_cast<unsigned long>(class_gap_ms_[static_cast<size_t>(LoadClass::CRITICAL)]),
+             static_cast<unsigned long>(critical_max_wait_ms_));
+    return ESP_OK;
+}
+
+int SwitchingScheduler::register_load(const char* name, LoadClass load_class, uint32_t gap_ms) {
+    for (size_t i = 0; i < MAX_LOADS; i++) {
+        if (!loads_[i].name) {
+            loads_[i] = Load();
+            loads_[i].name = name;
+            loads_[i].load_class = load_class;
+            loads_[i].gap_ms = gap_ms;
+            return static_cast<int>(i);
+        }
+    }
+    ESP_LOGE(TAG, "No free slot for load '%s'", name);
+    return -1;
+}
+
+void SwitchingScheduler::unregister_load(int id) {
+    if (id >= 0 && id < static_cast<int>(MAX_LOADS)) {
+        loads_[id] = Load();
+    }
+}
+
+bool SwitchingScheduler::request_energize(int id, uint64_t now_ms) {
+    if (id < 0 || id >= static_cast<int>(MAX_LOADS) || !loads_[id].name) {
+        return true;
+    }
+
+    Load& load = loads_[id];
+    if (load.load_class == LoadClass::LIGHT) {
+        return true;
+    }
+
+    if (!load.pending) {
+        load.pending = true;
+        load.sequence = next_sequence_++;
+        load.requested_ms = now_ms;
+    }
+
+    if (!is_next(id)) {
+        return false;
+    }
+
+    uint64_t ready_ms = std::max(next_free_ms_, startup_until_ms_);
+    if (load.load_class == LoadClass::CRITICAL) {
+        ready_ms = std::min(ready_ms, load.requested_ms + critical_max_wait_ms_);
+    }
+    if (now_ms < ready_ms) {
+        return false;
+    }
+
+    uint32_t wait_ms = static_cast<uint32_t>(now_ms - load.requested_ms);
+    max_wait_ms_ = std::max(max_wait_ms_, wait_ms);
+    if (load.load_class == LoadClass::CRITICAL) {
+        max_critical_wait_ms_ = std::max(max_critical_wait_ms_, wait_ms);
+    }
+
+    load.pending = false;
+    next_free_ms_ = now_ms + gap_for(load);
+    grants_++;
+    ESP_LOGD(TAG, "Energize '%s' after %lu ms", load.name, static_cast<unsigned long>(wait_ms));
+    return true;
+}
+
+void SwitchingScheduler::cancel(int id) {
+    if (id >= 0 && id < static_cast<int>(MAX_LOADS)) {
+        loads_[id].pending = false;
+    }
+}
+
+bool SwitchingScheduler::is_pending(int id) const {
+    return id >= 0 && id < static_cast<int>(MAX_LOADS) && loads_[id].pending;
+}
+
+nlohmann::json SwitchingScheduler::get_diagnostics(uint64_t now_ms) const {
+    // Service order: CRITICAL first, then arrival
+    int order[MAX_LOADS];
+    size_t count = 0;
+    for (size_t i = 0; i < MAX_LOADS; i++) {
+        if (loads_[i].pending) {
+            order[count++] = static_cast<int>(i);
+        }
+    }
+    std::sort(order, order + count, [this](int a, int b) {
+        bool critical_a = loads_[a].load_class == LoadClass::CRITICAL;
+        bool critical_b = loads_[b].load_class == LoadClass::CRITICAL;
+        if (critical_a != critical_b) {
+            return critical_a;
+        }
+        return static_cast<int32_t>(loads_[a].sequence - loads_[b].sequence) < 0;
+    });
+
+    nlohmann::json pending = nlohmann::json::array();
+    for (size_t i = 0; i < count; i++) {
+        const Load& load = loads_[order[i]];
+        pending.push_back({
+            {"name", load.name},
+            {"class", load_class_name(load.load_class)},
+            {"waiting_ms", now_ms - load.requested_ms}
+        });
+    }
+
+    uint64_t ready_ms = std::max(next_free_ms_, startup_until_ms_);
+    return {
+        {"pending", pending},
+        {"next_slot_in_ms", ready_ms > now_ms ? ready_ms - now_ms : 0},
+        {"grants", grants_},
+        {"max_wait_ms", max_wait_ms_},
+        {"max_critical_wait_ms", max_critical_wait_ms_},
+        {"critical_max_wait_ms", critical_max_wait_ms_}
+    };
+}
+
+bool SwitchingScheduler::parse_load_class(const std::string& name, LoadClass& load_class) {
+    for (size_t i = 0; i < sizeof(CLASS_NAMES) / sizeof(CLASS_NAMES[0]); i++) {
+        if (name == CLASS_NAMES[i]) {
+            load_class = static_cast<LoadClass>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* SwitchingScheduler::load_class_name(LoadClass load_class) {
+    return CLASS_NAMES[static_cast<size_t>(load_class)];
+}
+
+bool SwitchingScheduler::is_next(int id) const {
+    const Load& load = loads_[id];
+    bool critical = load.load_class == LoadClass::CRITICAL;
+
+    for (size_t i = 0; i < MAX_LOADS; i++) {
+        const Load& other = loads_[i];
+        if (static_cast<int>(i) == id || !other.pending) {
+            continue;
+        }
+        bool other_critical = other.load_class == LoadClass::CRITICAL;
+        if (other_critical && !critical) {
+            return false;
+        }
+        if (other_critical == critical &&
+            static_cast<int32_t>(other.sequence - load.sequence) < 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint32_t SwitchingScheduler::gap_for(const Load& load) const {
+    return load.gap_ms ? load.gap_ms : class_gap_ms_[static_cast<size_t>(load.load_class)];
+}
@@ -10,8 +10,10 @@
 #include "ui_filter.h"
 #include "lazy_component_loader.h"
 #include "esp_http_server.h"
+#include <functional>
 #include <map>
 #include <memory>
+#include <vector>
 
 namespace ModESP::UI {
 
@@ -30,6 +32,9 @@ class ApiHandler;
  */
 class WebUIAdapter {
 public:
+    // Registers extra URI handlers of other components on the server
+    using RouteProvider = std::function<esp_err_t(httpd_handle_t server)>;
+    
     WebUIAdapter(UIFilter* filter, LazyComponentLoader* loader);
     ~WebUIAdapter();
     
@@ -38,6 +43,14 @@ public:
     void stop();
     bool is_running() const { return server_ != nullptr; }
     
+    /**
+     * @brief Add handlers of another component (e.g. log export)
+     * 
+     * Providers run whenever the server starts; if it is already running
+     * the provider runs immediately.
+     */
+    static void add_route_provider(RouteProvider provider);
+    
     // Component rendering
     std::string renderComponents();
     nlohmann::json getComponentsJson();
@@ -63,6 +76,7 @@ private:
     
     // Static instance for handler callbacks
     static WebUIAdapter* instance_;
+    static std::vector<RouteProvider> route_providers_;
 };
 
 } // namespace ModESP::UI
@@ -14,6 +14,7 @@ namespace ModESP::UI {
 
 // Static instance for callbacks
 WebUIAdapter* WebUIAdapter::instance_ = nullptr;
+std::vector<WebUIAdapter::RouteProvider> WebUIAdapter::route_providers_;
 
 // Constructor
 WebUIAdapter::WebUIAdapter(UIFilter* filter, LazyComponentLoader* loader)
@@ -63,6 +64,16 @@ esp_err_t WebUIAdapter::start(uint16_t port) {
     return ESP_OK;
 }
 
+void WebUIAdapter::add_route_provider(RouteProvider provider) {
+    if (instance_ && instance_->server_) {
+        esp_err_t ret = provider(instance_->server_);
+        if (ret != ESP_OK) {
+            ESP_LOGW(TAG, "Route provider failed: %s", esp_err_to_name(ret));
+        }
+    }
+    route_providers_.push_back(std::move(provider));
+}
+
 // Stop HTTP server
 void WebUIAdapter::stop() {
     if (server_ != nullptr) {
@@ -106,6 +117,14 @@ esp_err_t WebUIAdapter::register_uri_handlers() {
     ret = httpd_register_uri_handler(server_, &api_uri);
     if (ret != ESP_OK) return ret;
     
+    // Handlers of other components; one failing does not stop the UI
+    for (const auto& provider : route_providers_) {
+        esp_err_t provider_ret = provider(server_);
+        if (provider_ret != ESP_OK) {
+            ESP_LOGW(TAG, "Route provider failed: %s", esp_err_to_name(provider_ret));
+        }
+    }
+    
     ESP_LOGI(TAG, "All URI handlers registered");
     return ESP_OK;
 }
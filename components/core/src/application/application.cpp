@@ -7,6 +7,7 @@
 #include "module_lifecycle.h"
 #include "esphal.h"
 #include "sensor_driver_init.h"
+#include "actuator_driver_init.h"
 // #include "configuration_manager.h" // Removed - moved to adaptive_ui
 // #include "api_dispatcher.h" // Removed - moved to adaptive_ui
 // #include "test_core_components.h" // TODO: Add core component tests
@@ -90,6 +91,9 @@ esp_err_t init() {
     // Initialize built-in sensor drivers
     initialize_builtin_sensor_drivers();
     
+    // Initialize built-in actuator drivers
+    initialize_builtin_actuator_drivers();
+    
     // Provide ModuleManager with the heartbeat monitor instance
     ModuleManager::set_heartbeat_monitor(&heartbeat);
     
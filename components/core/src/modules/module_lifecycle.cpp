@@ -9,6 +9,7 @@
 #include "module_lifecycle.h"
 #include "module_manager.h"
 #include "logger_module.h"
+#include "web_ui_adapter.h"
 #include <esp_log.h>
 #include <memory>
 
@@ -81,11 +82,17 @@ esp_err_t register_all_modules() {
     // Register Logger Module (CRITICAL priority)
     {
         auto logger_module = std::make_unique<LoggerModule>();
+        LoggerModule* logger = logger_module.get();
         ret = ModuleManager::register_module(std::move(logger_module), ModuleType::CRITICAL);
         if (ret != ESP_OK) {
             ESP_LOGE(TAG, "Failed to register Logger: %s", esp_err_to_name(ret));
             return ret;
         }
+        
+        // Streaming log export on the web UI server (/api/logs/export)
+        UI::WebUIAdapter::add_route_provider([logger](httpd_handle_t server) {
+            return logger->registerHttpHandlers(server);
+        });
         ESP_LOGI(TAG, "✅ Logger registered (CRITICAL)");
     }
     
@@ -0,0 +1,477 @@
+#include "haccp_rollup.h"
+#include <esp_log.h>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <ctime>
+#include <unistd.h>
+#include <sys/stat.h>
+
+static const char* TAG = "HaccpRollup";
+
+namespace ModESP {
+
+HaccpRollup::HaccpRollup(const char* path)
+    : m_path(path)
+    , m_file(nullptr)
+    , m_defaultThreshold(800)
+    , m_checkpointInterval(600)
+    , m_skippedUnsynced(0)
+    , m_dayClosed(nullptr)
+    , m_dayClosedCtx(nullptr) {
+    memset(m_sensors, 0, sizeof(m_sensors));
+}
+
+HaccpRollup::~HaccpRollup() {
+    persist();
+
+    std::lock_guard<std::mutex> lock(m_fileMutex);
+    if (m_file) {
+        fclose(m_file);
+        m_file = nullptr;
+    }
+}
+
+esp_err_t HaccpRollup::init() {
+    std::unique_lock<std::mutex> lock(m_fileMutex);
+
+    m_file = fopen(m_path.c_str(), "r+b");
+
+    FileHeader header = {};
+    bool valid = m_file &&
+                 fread(&header, sizeof(header), 1, m_file) == 1 &&
+                 header.magic == MAGIC &&
+                 header.version == VERSION &&
+                 header.maxSensors == MAX_SENSORS &&
+                 header.hourlySlots == HOURLY_SLOTS &&
+                 header.dailySlots == DAILY_SLOTS;
+
+    if (!valid) {
+        if (m_file) {
+            ESP_LOGW(TAG, "Rollup store layout changed, recreating %s", m_path.c_str());
+            fclose(m_file);
+            m_file = nullptr;
+        }
+        esp_err_t ret = createFile();
+        if (ret != ESP_OK) {
+            return ret;
+        }
+    }
+
+    lock.unlock();
+    loadFile();
+
+    ESP_LOGI(TAG, "Rollup store ready: %s (%ld bytes)", m_path.c_str(),
+             static_cast<long>(sizeof(FileHeader) + MAX_SENSORS * SENSOR_AREA));
+    return ESP_OK;
+}
+
+void HaccpRollup::setDefaultThreshold(float threshold) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_defaultThreshold = lroundf(threshold * 100);
+
+    // Ролі, відновлені з файлу в init(), отримали попередній поріг;
+    // власні пороги ролей лишаються
+    for (auto& slot : m_sensors) {
+        if (slot.used) {
+            slot.threshold = thresholdFor(slot.role);
+        }
+    }
+}
+
+void HaccpRollup::setThreshold(const std::string& role, float threshold) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    int32_t value = lroundf(threshold * 100);
+
+    auto it = std::find_if(m_thresholds.begin(), m_thresholds.end(),
+        [&role](const std::pair<std::string, int32_t>& t) { return t.first == role; });
+    if (it != m_thresholds.end()) {
+        it->second = value;
+    } else {
+        m_thresholds.emplace_back(role, value);
+    }
+
+    for (auto& slot : m_sensors) {
+        if (slot.used && role == slot.role) {
+            slot.threshold = value;
+        }
+    }
+}
+
+void HaccpRollup::ingest(const std::string& role, float value, uint32_t now) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (now < MIN_VALID_TIME) {
+        m_skippedUnsynced++;
+        return;
+    }
+
+    SensorSlot* slot = findOrCreate(role);
+    if (!slot) {
+        return;
+    }
+
+    int32_t v = lroundf(value * 100);
+    uint32_t hourStart = now - now % HOUR;
+    uint32_t dayStart = now - now % DAY;
+
+    if (slot->lastTime == 0 && slot->hour.periodStart == 0) {
+        // Перший показ після старту - продовжуємо збережені періоди
+        restoreOpen(slot - m_sensors, hourStart, dayStart);
+    }
+
+    // Інтегруємо час з моменту попереднього показу
+    bool integrate = slot->lastTime != 0 && now > slot->lastTime &&
+                     now - slot->lastTime <= MAX_GAP;
+    bool above = slot->lastValue > slot->threshold;
+    uint32_t from = slot->lastTime;
+
+    if (integrate) {
+        cover(slot->hour, HOUR, from, now, above);
+        cover(slot->day, DAY, from, now, above);
+    }
+
+    if (slot->hour.periodStart != hourStart) {
+        if (slot->hour.periodStart != 0) {
+            slot->closedHour = slot->hour;
+            slot->closedHourDirty = true;
+        }
+        openBucket(slot->hour, hourStart);
+        if (integrate) {
+            cover(slot->hour, HOUR, from, now, above);
+        }
+    }
+
+    if (slot->day.periodStart != dayStart) {
+        if (slot->day.periodStart != 0) {
+            slot->closedDay = slot->day;
+            slot->closedDayDirty = true;
+            if (m_dayClosed) {
+                m_dayClosed(m_dayClosedCtx, slot->role, slot->closedDay);
+            }
+        }
+        openBucket(slot->day, dayStart);
+        if (integrate) {
+            cover(slot->day, DAY, from, now, above);
+        }
+    }
+
+    addSample(slot->hour, v);
+    addSample(slot->day, v);
+
+    slot->lastTime = now;
+    slot->lastValue = v;
+    slot->openDirty = true;
+}
+
+esp_err_t HaccpRollup::persist() {
+    if (!m_file) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    uint32_t now = static_cast<uint32_t>(time(nullptr));
+    bool wrote = false;
+
+    for (size_t i = 0; i < MAX_SENSORS; i++) {
+        // Копіюємо під m_mutex, пишемо без нього - ingest не чекає на flash
+        char role[ROLE_LEN] = {};
+        RollupBucket pending[4];
+        Period periods[4];
+        size_t count = 0;
+        bool writeRoleName = false;
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            SensorSlot& slot = m_sensors[i];
+            if (!slot.used) {
+                continue;
+            }
+
+            if (slot.roleDirty) {
+                memcpy(role, slot.role, ROLE_LEN);
+                writeRoleName = true;
+                slot.roleDirty = false;
+            }
+            if (slot.closedHourDirty) {
+                pending[count] = slot.closedHour;
+                periods[count++] = Period::HOUR;
+                slot.closedHourDirty = false;
+            }
+            if (slot.closedDayDirty) {
+                pending[count] = slot.closedDay;
+                periods[count++] = Period::DAY;
+                slot.closedDayDirty = false;
+            }
+            if (slot.openDirty && now - slot.lastCheckpoint >= m_checkpointInterval) {
+                pending[count] = slot.hour;
+                periods[count++] = Period::HOUR;
+                pending[count] = slot.day;
+                periods[count++] = Period::DAY;
+                slot.openDirty = false;
+                slot.lastCheckpoint = now;
+            }
+        }
+
+        if (writeRoleName) {
+            writeRole(i, role);
+            wrote = true;
+        }
+        for (size_t j = 0; j < count; j++) {
+            writeBucket(i, periods[j], pending[j]);
+            wrote = true;
+        }
+    }
+
+    if (wrote) {
+        std::lock_guard<std::mutex> lock(m_fileMutex);
+        fflush(m_file);
+        fsync(fileno(m_file));
+    }
+
+    return ESP_OK;
+}
+
+std::vector<RollupBucket> HaccpRollup::query(const std::string& role, Period period,
+                                             uint32_t from, uint32_t to) {
+    std::vector<RollupBucket> result;
+    uint32_t length = period == Period::HOUR ? HOUR : DAY;
+    size_t slots = period == Period::HOUR ? HOURLY_SLOTS : DAILY_SLOTS;
+
+    // Знімок RAM стану
+    int index = -1;
+    RollupBucket open = {};
+    RollupBucket closed = {};
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (size_t i = 0; i < MAX_SENSORS; i++) {
+            if (m_sensors[i].used && role == m_sensors[i].role) {
+                index = i;
+                open = period == Period::HOUR ? m_sensors[i].hour : m_sensors[i].day;
+                closed = period == Period::HOUR ? m_sensors[i].closedHour : m_sensors[i].closedDay;
+                break;
+            }
+        }
+    }
+
+    if (index < 0 || to < from) {
+        return result;
+    }
+
+    // Не глибше ніж тримає кільце
+    uint32_t first = from - from % length;
+    uint32_t last = to - to % length;
+    if ((last - first) / length >= slots) {
+        first = last - (slots - 1) * length;
+    }
+
+    result.reserve((last - first) / length + 1);
+    for (uint32_t start = first; start <= last; start += length) {
+        RollupBucket bucket;
+        if (open.periodStart == start) {
+            bucket = open;
+        } else if (closed.periodStart == start) {
+            bucket = closed;
+        } else if (!readBucket(index, period, start, bucket)) {
+            continue;
+        }
+
+        if (bucket.sampleCount > 0) {
+            result.push_back(bucket);
+        }
+    }
+
+    return result;
+}
+
+std::vector<std::string> HaccpRollup::getRoles() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<std::string> roles;
+    for (const auto& slot : m_sensors) {
+        if (slot.used) {
+            roles.emplace_back(slot.role);
+        }
+    }
+    return roles;
+}
+
+// Приватні методи
+
+HaccpRollup::SensorSlot* HaccpRollup::findOrCreate(const std::string& role) {
+    SensorSlot* freeSlot = nullptr;
+
+    for (auto& slot : m_sensors) {
+        if (slot.used) {
+            if (role == slot.role) {
+                return &slot;
+            }
+        } else if (!freeSlot) {
+            freeSlot = &slot;
+        }
+    }
+
+    if (!freeSlot) {
+        ESP_LOGW(TAG, "No rollup slot for sensor '%s'", role.c_str());
+        return nullptr;
+    }
+
+    memset(freeSlot, 0, sizeof(*freeSlot));
+    strncpy(freeSlot->role, role.c_str(), ROLE_LEN - 1);
+    freeSlot->threshold = thresholdFor(role);
+    freeSlot->used = true;
+    freeSlot->roleDirty = true;
+    return freeSlot;
+}
+
+int32_t HaccpRollup::thresholdFor(const std::string& role) const {
+    for (const auto& t : m_thresholds) {
+        if (t.first == role) {
+            return t.second;
+        }
+    }
+    return m_defaultThreshold;
+}
+
+void HaccpRollup::restoreOpen(size_t index, uint32_t hourStart, uint32_t dayStart) {
+    SensorSlot& slot = m_sensors[index];
+
+    RollupBucket bucket;
+    if (readBucket(index, Period::HOUR, hourStart, bucket)) {
+        slot.hour = bucket;
+    }
+    if (readBucket(index, Period::DAY, dayStart, bucket)) {
+        slot.day = bucket;
+    }
+}
+
+void HaccpRollup::openBucket(RollupBucket& bucket, uint32_t periodStart) {
+    memset(&bucket, 0, sizeof(bucket));
+    bucket.periodStart = periodStart;
+    bucket.minValue = INT32_MAX;
+    bucket.maxValue = INT32_MIN;
+}
+
+void HaccpRollup::addSample(RollupBucket& bucket, int32_t value) {
+    bucket.minValue = std::min(bucket.minValue, value);
+    bucket.maxValue = std::max(bucket.maxValue, value);
+    bucket.sumValue += value;
+    bucket.sampleCount++;
+}
+
+void HaccpRollup::cover(RollupBucket& bucket, uint32_t length, uint32_t from, uint32_t to, bool above) {
+    if (bucket.periodStart == 0) {
+        return;
+    }
+
+    uint32_t start = std::max(from, bucket.periodStart);
+    uint32_t end = std::min(to, bucket.periodStart + length);
+    if (end > start) {
+        bucket.secondsCovered += end - start;
+        if (above) {
+            bucket.secondsAbove += end - start;
+        }
+    }
+}
+
+long HaccpRollup::slotOffset(size_t sensorIndex, Period period, uint32_t periodStart) const {
+    long base = sizeof(FileHeader) + sensorIndex * SENSOR_AREA + ROLE_LEN;
+    if (period == Period::HOUR) {
+        return base + ((periodStart / HOUR) % HOURLY_SLOTS) * sizeof(RollupBucket);
+    }
+    return base + (HOURLY_SLOTS + (periodStart / DAY) % DAILY_SLOTS) * sizeof(RollupBucket);
+}
+
+esp_err_t HaccpRollup::writeBucket(size_t sensorIndex, Period period, const RollupBucket& bucket) {
+    std::lock_guard<std::mutex> lock(m_fileMutex);
+
+    if (!m_file || fseek(m_file, slotOffset(sensorIndex, period, bucket.periodStart), SEEK_SET) != 0 ||
+        fwrite(&bucket, sizeof(bucket), 1, m_file) != 1) {
+        ESP_LOGE(TAG, "Failed to write rollup bucket");
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+bool HaccpRollup::readBucket(size_t sensorIndex, Period period, uint32_t periodStart, RollupBucket& bucket) {
+    std::lock_guard<std::mutex> lock(m_fileMutex);
+
+    if (!m_file || fseek(m_file, slotOffset(sensorIndex, period, periodStart), SEEK_SET) != 0 ||
+        fread(&bucket, sizeof(bucket), 1, m_file) != 1) {
+        return false;
+    }
+
+    // Слот міг бути перезаписаний новішим періодом
+    return bucket.periodStart == periodStart;
+}
+
+esp_err_t HaccpRollup::writeRole(size_t sensorIndex, const char* role) {
+    std::lock_guard<std::mutex> lock(m_fileMutex);
+
+    long offset = sizeof(FileHeader) + sensorIndex * SENSOR_AREA;
+    if (!m_file || fseek(m_file, offset, SEEK_SET) != 0 ||
+        fwrite(role, ROLE_LEN, 1, m_file) != 1) {
+        ESP_LOGE(TAG, "Failed to write rollup role");
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+esp_err_t HaccpRollup::createFile() {
+    // Каталог може не існувати, якщо логи пишуться в raw розділ
+    size_t slash = m_path.rfind('/');
+    if (slash != std::string::npos && slash > 0) {
+        mkdir(m_path.substr(0, slash).c_str(), 0755);
+    }
+
+    m_file = fopen(m_path.c_str(), "w+b");
+    if (!m_file) {
+        ESP_LOGE(TAG, "Failed to create %s", m_path.c_str());
+        return ESP_FAIL;
+    }
+
+    FileHeader header = {};
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.maxSensors = MAX_SENSORS;
+    header.hourlySlots = HOURLY_SLOTS;
+    header.dailySlots = DAILY_SLOTS;
+    fwrite(&header, sizeof(header), 1, m_file);
+
+    // Нульові області сенсорів - файл має фіксований розмір з першого дня
+    char zeros[128] = {};
+    long remaining = MAX_SENSORS * SENSOR_AREA;
+    while (remaining > 0) {
+        size_t part = std::min<long>(remaining, sizeof(zeros));
+        fwrite(zeros, 1, part, m_file);
+        remaining -= part;
+    }
+
+    fflush(m_file);
+    fsync(fileno(m_file));
+    return ESP_OK;
+}
+
+void HaccpRollup::loadFile() {
+    for (size_t i = 0; i < MAX_SENSORS; i++) {
+        char role[ROLE_LEN] = {};
+        {
+            std::lock_guard<std::mutex> fileLock(m_fileMutex);
+            long offset = sizeof(FileHeader) + i * SENSOR_AREA;
+            if (fseek(m_file, offset, SEEK_SET) != 0 || fread(role, ROLE_LEN, 1, m_file) != 1) {
+                continue;
+            }
+        }
+        role[ROLE_LEN - 1] = '\0';
+        if (role[0] == '\0') {
+            continue;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        SensorSlot& slot = m_sensors[i];
+        memset(&slot, 0, sizeof(slot));
+        memcpy(slot.role, role, ROLE_LEN);
+        slot.threshold = thresholdFor(role);
+        slot.used = true;
+    }
+}
+
+} // namespace ModESP
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <esp_err.h>
+
+namespace ModESP {
+
+/**
+ * @brief Агрегат показів сенсора за період (година або доба)
+ *
+ * Значення зберігаються як value * 100, як і в LoggerModule::logSensorData().
+ */
+struct RollupBucket {
+    uint32_t periodStart;       // Unix time початку періоду (UTC), 0 = порожній
+    int32_t minValue;
+    int32_t maxValue;
+    int64_t sumValue;
+    uint32_t sampleCount;
+    uint32_t secondsAbove;      // Час вище порогу (sample-and-hold між показами)
+    uint32_t secondsCovered;    // Час, покритий показами
+
+    int32_t mean() const {
+        return sampleCount ? static_cast<int32_t>(sumValue / sampleCount) : 0;
+    }
+} __attribute__((packed));
+
+/**
+ * @brief Інкрементальні HACCP агрегати по сенсорах
+ *
+ * Оновлюється на кожному sensor.reading за O(1) в RAM. Закриті та відкриті
+ * періоди скидаються у файл фіксованої структури фоновим persist().
+ * Слот періоду в кільці визначається часом: (periodStart / period) % slots,
+ * тому звіт за N діб читає рівно N слотів.
+ */
+class HaccpRollup {
+public:
+    static constexpr size_t MAX_SENSORS = 8;
+    static constexpr size_t ROLE_LEN = 24;
+    static constexpr size_t HOURLY_SLOTS = 48;     // 2 доби погодинно
+    static constexpr size_t DAILY_SLOTS = 62;      // 2 місяці подобово
+    static constexpr uint32_t HOUR = 3600;
+    static constexpr uint32_t DAY = 86400;
+
+    enum class Period : uint8_t { HOUR, DAY };
+
+    // Викликається при закритті доби (для HACCP_REPORT)
+    using DayClosedCallback = void (*)(void* ctx, const char* role, const RollupBucket& day);
+
+    explicit HaccpRollup(const char* path);
+    ~HaccpRollup();
+
+    esp_err_t init();
+    void setDefaultThreshold(float threshold);
+    void setThreshold(const std::string& role, float threshold);
+    void setCheckpointInterval(uint32_t seconds) { m_checkpointInterval = seconds; }
+    void setDayClosedCallback(DayClosedCallback cb, void* ctx) { m_dayClosed = cb; m_dayClosedCtx = ctx; }
+
+    // Додати показ сенсора; now - Unix time
+    void ingest(const std::string& role, float value, uint32_t now);
+
+    // Записати змінені агрегати у файл (з фонової задачі)
+    esp_err_t persist();
+
+    // Агрегати в межах [from, to], від старішого до новішого
+    std::vector<RollupBucket> query(const std::string& role, Period period,
+                                    uint32_t from, uint32_t to);
+
+    std::vector<std::string> getRoles();
+
+private:
+    struct FileHeader {
+        uint32_t magic;
+        uint16_t version;
+        uint8_t maxSensors;
+        uint8_t reserved;
+        uint16_t hourlySlots;
+        uint16_t dailySlots;
+    } __attribute__((packed));
+
+    struct SensorSlot {
+        char role[ROLE_LEN];
+        int32_t threshold;          // value * 100
+        bool used;
+
+        // Відкриті періоди
+        RollupBucket hour;
+        RollupBucket day;
+
+        // Останній показ для інтегрування часу
+        uint32_t lastTime;
+        int32_t lastValue;
+
+        // Закриті періоди, що чекають запису
+        RollupBucket closedHour;
+        RollupBucket closedDay;
+        bool closedHourDirty;
+        bool closedDayDirty;
+        bool openDirty;
+        bool roleDirty;
+        uint32_t lastCheckpoint;
+    };
+
+    static constexpr uint32_t MAGIC = 0x50524348;  // "HCRP"
+    static constexpr uint16_t VERSION = 1;
+    static constexpr uint32_t MIN_VALID_TIME = 1600000000;  // Раніше - час ще не синхронізовано
+    static constexpr uint32_t MAX_GAP = 600;                // Більший проміжок не інтегрується
+    static constexpr long SENSOR_AREA = ROLE_LEN + (HOURLY_SLOTS + DAILY_SLOTS) * sizeof(RollupBucket);
+
+    SensorSlot* findOrCreate(const std::string& role);
+    int32_t thresholdFor(const std::string& role) const;
+    void restoreOpen(size_t index, uint32_t hourStart, uint32_t dayStart);
+    static void openBucket(RollupBucket& bucket, uint32_t periodStart);
+    static void addSample(RollupBucket& bucket, int32_t value);
+    static void cover(RollupBucket& bucket, uint32_t length, uint32_t from, uint32_t to, bool above);
+
+    long slotOffset(size_t sensorIndex, Period period, uint32_t periodStart) const;
+    esp_err_t writeBucket(size_t sensorIndex, Period period, const RollupBucket& bucket);
+    bool readBucket(size_t sensorIndex, Period period, uint32_t periodStart, RollupBucket& bucket);
+    esp_err_t writeRole(size_t sensorIndex, const char* role);
+    esp_err_t createFile();
+    void loadFile();
+
+    std::string m_path;
+    FILE* m_file;
+    std::mutex m_mutex;         // Стан агрегатів
+    std::mutex m_fileMutex;     // Файл (не тримається разом з m_mutex, крім ingest)
+
+    SensorSlot m_sensors[MAX_SENSORS];
+    std::vector<std::pair<std::string, int32_t>> m_thresholds;
+    int32_t m_defaultThreshold;
+    uint32_t m_checkpointInterval;
+    uint32_t m_skippedUnsynced;
+
+    DayClosedCallback m_dayClosed;
+    void* m_dayClosedCtx;
+};
+
+} // namespace ModESP
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "logger_interface.h"
+#include <esp_rom_crc.h>
+#include <cstring>
+#include <cstddef>
+
+namespace ModESP {
+
+/**
+ * @brief Блок логів фіксованого розміру для запису на flash
+ *
+ * Записи групуються в блоки з CRC та наскрізним номером послідовності.
+ * Блок пишеться цілком, тому після втрати живлення він або валідний,
+ * або відкидається при відновленні хвоста.
+ */
+struct LogBlock {
+    static constexpr uint32_t MAGIC = 0x314B4C4D;  // "MLK1"
+    static constexpr size_t SIZE = 512;
+    static constexpr size_t HEADER_SIZE = 16;
+    static constexpr size_t CAPACITY = (SIZE - HEADER_SIZE) / sizeof(LogEntry);
+
+    struct Header {
+        uint32_t magic;
+        uint32_t sequence;
+        uint16_t count;
+        uint16_t reserved;
+        uint32_t crc;       // CRC32 всього блоку, крім самого поля crc
+    } __attribute__((packed));
+
+    Header header;
+    LogEntry entries[CAPACITY];
+    uint8_t padding[SIZE - HEADER_SIZE - CAPACITY * sizeof(LogEntry)];
+
+    void reset() {
+        memset(this, 0, sizeof(*this));
+    }
+
+    bool empty() const { return header.count == 0; }
+    bool full() const { return header.count >= CAPACITY; }
+
+    bool add(const LogEntry& entry) {
+        if (full()) {
+            return false;
+        }
+        entries[header.count++] = entry;
+        return true;
+    }
+
+    void seal(uint32_t sequence) {
+        header.magic = MAGIC;
+        header.sequence = sequence;
+        header.crc = computeCrc();
+    }
+
+    bool isValid() const {
+        return header.magic == MAGIC &&
+               header.count <= CAPACITY &&
+               header.crc == computeCrc();
+    }
+
+    uint32_t computeCrc() const {
+        const uint8_t* raw = reinterpret_cast<const uint8_t*>(this);
+        constexpr size_t crcOffset = offsetof(Header, crc);
+        uint32_t crc = esp_rom_crc32_le(0, raw, crcOffset);
+        return esp_rom_crc32_le(crc, raw + HEADER_SIZE, SIZE - HEADER_SIZE);
+    }
+} __attribute__((packed));
+
+static_assert(sizeof(LogBlock::Header) == LogBlock::HEADER_SIZE, "LogBlock header size mismatch");
+static_assert(sizeof(LogBlock) == LogBlock::SIZE, "LogBlock must be exactly SIZE bytes");
+
+} // namespace ModESP
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "logger_interface.h"
+#include "event_bus.h"
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+namespace ModESP {
+
+/**
+ * @brief Міст EventBus -> лог за декларативними правилами
+ *
+ * Правила з logging.json ("routes") компілюються в configure():
+ * назви кодів і рівнів перетворюються в enum, шляхи до полів - в
+ * послідовність ключів. Обробник події лише перевіряє семплінг, умови
+ * та бере значення прямим пошуком ключів, без розбору рядків.
+ *
+ * Правило:
+ * {
+ *   "event": "actuator.compressor.state",  // шаблон EventBus
+ *   "code": "COMPRESSOR_ON",               // EventCode (назва або число)
+ *   "level": "INFO",                       // рівень запису
+ *   "module": "COMPRESSOR",                // модуль запису (за замовчуванням SYSTEM)
+ *   "value": "runtime",                    // шлях до значення ("reading.value")
+ *   "scale": 1,                            // value * scale -> int32
+ *   "sample": 1,                           // писати кожну N-ту подію
+ *   "when": {"on": true},                  // умови рівності полів
+ *   "message": "Compressor on"             // текст запису (до 31 символу)
+ * }
+ */
+class LogEventRouter {
+public:
+    struct Condition {
+        std::vector<std::string> path;
+        nlohmann::json expected;
+    };
+
+    struct Route {
+        std::string pattern;
+        EventCode code;
+        LogLevel level;
+        uint8_t moduleId;
+        std::vector<std::string> valuePath;     // Порожній - value = 0
+        float scale;
+        uint16_t sampleEvery;
+        std::vector<Condition> when;
+        char message[sizeof(LogEntry::message)];
+
+        // Статистика
+        uint32_t seen;
+        uint32_t logged;
+        uint32_t missing;                       // Поле value відсутнє або не число
+        EventBus::SubscriptionHandle handle;
+    };
+
+    // Запис події в лог
+    using EmitCallback = void (*)(void* ctx, const Route& route, int32_t value);
+
+    LogEventRouter(ILogger& logger, EmitCallback emit, void* ctx);
+    ~LogEventRouter();
+
+    /**
+     * @brief Скомпілювати правила
+     * @param routes Масив правил; не масив - вбудовані правила за замовчуванням
+     * @return Кількість прийнятих правил (некоректні пропускаються з попередженням)
+     */
+    size_t compile(const nlohmann::json& routes);
+
+    // Підписатись на EventBus (з головної задачі, після compile)
+    void subscribe();
+    void unsubscribe();
+
+    const std::vector<Route>& routes() const { return m_routes; }
+    bool isCompiled() const { return m_compiled; }
+
+    static bool parseEventCode(const nlohmann::json& value, EventCode& code);
+    static const char* const DEFAULT_ROUTES;
+
+private:
+    void dispatch(size_t index, const EventBus::Event& event);
+
+    static std::vector<std::string> compilePath(const std::string& path);
+    static const nlohmann::json* lookup(const nlohmann::json& data, const std::vector<std::string>& path);
+
+    ILogger& m_logger;
+    EmitCallback m_emit;
+    void* m_ctx;
+    std::vector<Route> m_routes;
+    bool m_compiled;
+    bool m_subscribed;
+};
+
+} // namespace ModESP
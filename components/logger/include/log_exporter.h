@@ -0,0 +1,84 @@
+#pragma once
+
+#include "logger_interface.h"
+#include "log_storage.h"
+#include <esp_err.h>
+#include <functional>
+
+namespace ModESP {
+
+/**
+ * @brief Формат експорту логів
+ */
+enum class ExportFormat : uint8_t {
+    CSV,
+    JSON,
+    BINARY
+};
+
+/**
+ * @brief Потоковий експорт логів фрагментами фіксованого розміру
+ *
+ * Читає сховище через LogCursor і віддає дані в sink частинами не більше
+ * CHUNK_SIZE байт. Використання пам'яті не залежить від розміру логів.
+ *
+ * В кінці потоку записується токен курсора для продовження експорту:
+ * - CSV: останній рядок "# cursor=<token>"
+ * - JSON: поле "cursor"
+ * - BINARY: заголовок BinaryHeader, далі записи LogEntry, в кінці
+ *   LogEntry з level = NONE, message якого містить токен
+ */
+class LogExporter {
+public:
+    using ChunkSink = std::function<esp_err_t(const char* data, size_t len)>;
+
+    struct BinaryHeader {
+        char magic[4];          // "MLOG"
+        uint8_t version;
+        uint8_t entrySize;      // sizeof(LogEntry)
+        uint16_t reserved;
+    } __attribute__((packed));
+
+    LogExporter(LogStorage& storage, ExportFormat format, const LogFilter& filter,
+                const LogCursor& start = LogCursor());
+
+    /**
+     * @brief Експортувати записи в sink
+     * @param sink Отримувач фрагментів
+     * @param maxEntries Ліміт записів (0 = до кінця логів)
+     * @return ESP_OK або помилка sink
+     */
+    esp_err_t run(const ChunkSink& sink, uint32_t maxEntries = 0);
+
+    // Позиція, з якої можна продовжити експорт
+    const LogCursor& cursor() const { return m_cursor; }
+
+    static bool parseFormat(const char* name, ExportFormat& format);
+    static const char* contentType(ExportFormat format);
+
+    static constexpr size_t CHUNK_SIZE = 512;
+    static constexpr size_t READ_BATCH = 8;
+
+private:
+    esp_err_t writeHeader();
+    esp_err_t writeEntry(const LogEntry& entry);
+    esp_err_t writeFooter();
+
+    // Буферизація з відправкою повних фрагментів
+    esp_err_t append(const char* data, size_t len);
+    esp_err_t flush();
+
+    LogStorage& m_storage;
+    ExportFormat m_format;
+    const LogFilter& m_filter;
+    LogCursor m_cursor;
+
+    const ChunkSink* m_sink;
+    uint32_t m_written;
+
+    char m_chunk[CHUNK_SIZE];
+    size_t m_chunkUsed;
+    LogEntry m_batch[READ_BATCH];
+};
+
+} // namespace ModESP
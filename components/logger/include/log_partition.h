@@ -0,0 +1,87 @@
+#pragma once
+
+#include <esp_err.h>
+#include <esp_partition.h>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ModESP {
+
+/**
+ * @brief Доступ до raw розділу flash для кільцевого логу
+ *
+ * Семантика NOR flash: стирання сектору встановлює всі біти в 1,
+ * запис може лише скидати біти в 0.
+ */
+class LogPartition {
+public:
+    virtual ~LogPartition() = default;
+
+    virtual esp_err_t read(size_t offset, void* dst, size_t len) = 0;
+    virtual esp_err_t write(size_t offset, const void* src, size_t len) = 0;
+    virtual esp_err_t eraseSector(size_t sector) = 0;
+
+    virtual size_t size() const = 0;
+    virtual size_t sectorSize() const = 0;
+};
+
+/**
+ * @brief Розділ з таблиці розділів ESP-IDF (esp_partition)
+ */
+class EspLogPartition : public LogPartition {
+public:
+    explicit EspLogPartition(const esp_partition_t* partition);
+
+    // nullptr якщо розділ з такою міткою не знайдено
+    static std::unique_ptr<LogPartition> open(const char* label);
+
+    esp_err_t read(size_t offset, void* dst, size_t len) override;
+    esp_err_t write(size_t offset, const void* src, size_t len) override;
+    esp_err_t eraseSector(size_t sector) override;
+
+    size_t size() const override;
+    size_t sectorSize() const override;
+
+private:
+    const esp_partition_t* m_partition;
+};
+
+/**
+ * @brief Емулятор розділу у звичайному файлі (для перевірок на Linux)
+ *
+ * Відтворює семантику NOR flash: запис виконує AND з вмістом, тому
+ * повторний запис без стирання псує дані так само як на залізі.
+ * Рахує стирання кожного сектору для перевірки рівномірності зносу.
+ */
+class FileLogPartition : public LogPartition {
+public:
+    FileLogPartition(const std::string& path, size_t size, size_t sectorSize = 4096);
+    ~FileLogPartition() override;
+
+    // Відкрити файл; новий файл створюється стертим (0xFF)
+    esp_err_t open();
+
+    esp_err_t read(size_t offset, void* dst, size_t len) override;
+    esp_err_t write(size_t offset, const void* src, size_t len) override;
+    esp_err_t eraseSector(size_t sector) override;
+
+    size_t size() const override { return m_size; }
+    size_t sectorSize() const override { return m_sectorSize; }
+
+    uint32_t eraseCount(size_t sector) const;
+    // Кількість спроб записати 1 поверх 0 (помилка на реальному flash)
+    uint32_t writeViolations() const { return m_writeViolations; }
+
+private:
+    std::string m_path;
+    size_t m_size;
+    size_t m_sectorSize;
+    FILE* m_file;
+    std::vector<uint32_t> m_eraseCounts;
+    uint32_t m_writeViolations;
+};
+
+} // namespace ModESP
@@ -1,47 +1,118 @@
 #pragma once
 
 #include "logger_interface.h"
+#include "log_block.h"
 #include <string>
 #include <vector>
+#include <memory>
+#include <mutex>
 #include <esp_littlefs.h>
 
 namespace ModESP {
 
 /**
- * @brief Клас для роботи з файловим сховищем логів
+ * @brief Сховище логів (спільна частина бекендів)
  * 
- * Використовує LittleFS для збереження логів з підтримкою:
- * - Автоматичної ротації файлів
- * - Стиснення архівів
- * - Пошуку та фільтрації
+ * Записи групуються в блоки LogBlock (group commit). Записи накопичуються
+ * в RAM блоці і фіксуються на flash коли блок заповнений, при записі
+ * рівня config.syncLevel і вище, або за викликом commit().
+ * Бекенд відповідає лише за розміщення блоків на носії.
  */
 class LogStorage {
 public:
-    LogStorage(const LoggerConfig& config);
-    ~LogStorage();
+    explicit LogStorage(const LoggerConfig& config);
+    virtual ~LogStorage() = default;
     
-    // Ініціалізація та монтування LittleFS
-    esp_err_t init();
-    esp_err_t deinit();
+    // Створити бекенд за config.backend
+    static std::unique_ptr<LogStorage> create(const LoggerConfig& config);
     
-    // Запис логів
+    virtual esp_err_t init() = 0;
+    virtual esp_err_t deinit() = 0;
+    
+    // Запис логів (критичні записи фіксуються негайно)
     esp_err_t writeEntry(const LogEntry& entry);
     esp_err_t writeEntries(const std::vector<LogEntry>& entries);
     
+    // Group commit: append() лише буферизує, commit() записує блок на носій.
+    // Незаписаний блок зберігається до наступного commit(); поки він повний,
+    // append() повертає ESP_ERR_NO_MEM і запис втрачається
+    esp_err_t append(const LogEntry& entry);
+    esp_err_t commit();
+    bool hasPending() const { return !m_pending.empty(); }
+    uint32_t pendingAgeMs() const;
+    
     // Читання логів
     std::vector<LogEntry> readLogs(const LogFilter& filter);
-    size_t getLogCount();
+    virtual size_t getLogCount() = 0;
     
-    // Управління файлами
-    bool clearLogs();
-    bool rotateFiles();
+    // Потокове читання: до maxCount відфільтрованих записів з позиції курсора.
+    // Може повернути 0 поки cursor.done == false (всі прочитані записи відфільтровані)
+    virtual size_t readBatch(LogCursor& cursor, const LogFilter& filter, LogEntry* out, size_t maxCount) = 0;
+    
+    // Управління
+    virtual bool clearLogs() = 0;
+    virtual bool rotateFiles() = 0;
     
-    // Експорт
-    bool exportToCSV(std::string& output, const LogFilter& filter);
-    bool exportToJSON(std::string& output, const LogFilter& filter);    
     // Статистика
-    size_t getUsedSpace();
-    size_t getTotalSpace();
+    virtual size_t getUsedSpace() = 0;
+    virtual size_t getTotalSpace() = 0;
+    
+protected:
+    // Чи готовий бекенд приймати блоки
+    virtual bool isWritable() const = 0;
+    
+    // Записати m_pending (вже запечатаний номером m_nextSequence) на носій
+    virtual esp_err_t writeBlock() = 0;
+    
+    // Викликається після успішного commit() (ротація тощо)
+    virtual void afterCommit() {}
+    
+    const LoggerConfig& m_config;
+    
+    // Group commit
+    LogBlock m_pending;         // Блок що накопичується
+    LogBlock m_scratch;         // Буфер читання (під m_mutex)
+    uint32_t m_nextSequence;
+    int64_t m_pendingSinceUs;
+    
+    // Захищає носій від ротації під час потокового читання
+    std::recursive_mutex m_mutex;
+};
+
+/**
+ * @brief Сховище логів у файлах LittleFS
+ * 
+ * Використовує LittleFS для збереження логів з підтримкою:
+ * - Автоматичної ротації файлів
+ * - Стиснення архівів
+ * - Пошуку та фільтрації
+ * 
+ * Файли складаються з блоків LogBlock, кожен commit() завершується fsync.
+ * При ініціалізації хвіст current.log обрізається до останнього валідного блоку.
+ */
+class FileLogStorage : public LogStorage {
+public:
+    explicit FileLogStorage(const LoggerConfig& config);
+    ~FileLogStorage() override;
+    
+    // Ініціалізація та монтування LittleFS
+    esp_err_t init() override;
+    esp_err_t deinit() override;
+    
+    size_t getLogCount() override;
+    size_t readBatch(LogCursor& cursor, const LogFilter& filter, LogEntry* out, size_t maxCount) override;
+    
+    // Управління файлами
+    bool clearLogs() override;
+    bool rotateFiles() override;
+    
+    size_t getUsedSpace() override;
+    size_t getTotalSpace() override;
+    
+protected:
+    bool isWritable() const override { return m_currentFile != nullptr; }
+    esp_err_t writeBlock() override;
+    void afterCommit() override;
     
 private:
     // Внутрішні методи
@@ -52,6 +123,11 @@ private:
     std::string getArchiveLogPath(int index);
     std::string getCriticalLogPath();
     
+    esp_err_t recoverTail();
+    void rollbackBlock();
+    uint32_t readLastSequence(const std::string& path);
+    size_t countEntries(const std::string& path);
+    
     bool checkRotationNeeded();
     void performRotation();
     void enforceQuota();
@@ -64,13 +140,11 @@ private:
     FILE* openLogFile(const std::string& path, const char* mode);
     void closeLogFile(FILE* file);
     
-    // Конфігурація
-    const LoggerConfig& m_config;
-    
     // Стан
     bool m_mounted;
     FILE* m_currentFile;
     size_t m_currentFileSize;
+    uint32_t m_generation;      // Лічильник ротацій для LogCursor
     
     // Шляхи (використовує той же базовий шлях що і ConfigManager)
     static constexpr const char* MOUNT_POINT = "/storage";
@@ -78,6 +152,7 @@ private:
     static constexpr const char* CURRENT_LOG = "/storage/logs/current.log";
     static constexpr const char* CRITICAL_LOG = "/storage/logs/critical.log";
     static constexpr const char* ARCHIVE_PREFIX = "/storage/logs/archive_";
+    static constexpr const char* LEGACY_LOG = "/storage/logs/legacy.log";
 };
 
 } // namespace ModESP
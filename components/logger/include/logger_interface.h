@@ -6,6 +6,8 @@
 #include <vector>
 #include <cstdarg>
 #include <cstdio>
+#include <array>
+#include "sdkconfig.h"
 
 namespace ModESP {
 
@@ -21,6 +23,30 @@ enum class LogLevel : uint8_t {
     NONE = 5
 };
 
+/**
+ * @brief Фіксовані ID модулів логування
+ * 
+ * Файл може визначити MLOG_MODULE перед включенням заголовка, тоді MLOG_*
+ * використовують ID відомий на етапі компіляції. Інакше ID отримується
+ * з TAG один раз на кожне місце виклику.
+ */
+enum class LogModule : uint8_t {
+    OTHER = 0,          // Модулі поза таблицею
+    SYSTEM = 1,
+    SENSOR = 2,
+    ACTUATOR = 3,
+    DEFROST = 4,
+    COMPRESSOR = 5,
+    UI = 6,
+    NETWORK = 7,
+    DYNAMIC_START = 8   // Перший ID для модулів що реєструються за TAG
+};
+
+static constexpr size_t LOG_MAX_MODULES = 32;
+
+// Місце виклику MLOG_* ще не отримало ID (OTHER теж є валідним результатом)
+static constexpr uint8_t LOG_MODULE_UNRESOLVED = 0xFF;
+
 /**
  * @brief Коди подій для структурованого логування
  */
@@ -84,6 +110,87 @@ struct LogFilter {
     std::vector<uint8_t> moduleIds;
     std::vector<uint16_t> eventCodes;
     uint32_t maxEntries = 100;
+    
+    bool matches(const LogEntry& entry) const {
+        if (static_cast<LogLevel>(entry.level) < minLevel) return false;
+        if (startTime > 0 && entry.timestamp < startTime) return false;
+        if (endTime > 0 && entry.timestamp > endTime) return false;
+        
+        if (!moduleIds.empty()) {
+            bool found = false;
+            for (uint8_t id : moduleIds) {
+                if (id == entry.moduleId) { found = true; break; }
+            }
+            if (!found) return false;
+        }
+        
+        if (!eventCodes.empty()) {
+            bool found = false;
+            for (uint16_t code : eventCodes) {
+                if (code == entry.eventCode) { found = true; break; }
+            }
+            if (!found) return false;
+        }
+        
+        return true;
+    }
+};
+
+/**
+ * @brief Позиція потокового читання логів
+ * 
+ * Файли читаються від найстарішого архіву до поточного файлу.
+ * fileIndex: 0 = current.log, N = archive_N.log.
+ * generation - номер ротації на момент видачі курсора; після ротації
+ * індекс файлу зсувається, тому курсор лишається валідним.
+ */
+struct LogCursor {
+    uint32_t generation = 0;    // Ротація (файли) або номер сектору (raw розділ)
+    uint8_t fileIndex = 0;
+    uint32_t offset = 0;        // Блок * LogBlock::CAPACITY + запис у блоці
+    bool started = false;       // false = почати з найстарішого файлу
+    bool done = false;          // Досягнуто кінця поточного файлу
+    
+    // Найдовший токен "4294967295.255.4294967295" + NUL, із запасом
+    static constexpr size_t TOKEN_SIZE = 32;
+    
+    // Токен у форматі "generation.file.offset"
+    void toToken(char* out, size_t size) const {
+        snprintf(out, size, "%lu.%u.%lu",
+                 static_cast<unsigned long>(generation),
+                 static_cast<unsigned>(fileIndex),
+                 static_cast<unsigned long>(offset));
+    }
+    
+    bool fromToken(const char* token) {
+        unsigned long gen = 0, off = 0;
+        unsigned file = 0;
+        if (!token || sscanf(token, "%lu.%u.%lu", &gen, &file, &off) != 3 || file > 255) {
+            return false;
+        }
+        generation = gen;
+        fileIndex = static_cast<uint8_t>(file);
+        offset = off;
+        started = true;
+        done = false;
+        return true;
+    }
+};
+
+// Рівень за назвою з конфігурації ("WARN" = "WARNING"), невідома назва - CRITICAL
+inline LogLevel log_level_from_name(const std::string& name) {
+    return name == "DEBUG" ? LogLevel::DEBUG :
+           name == "INFO" ? LogLevel::INFO :
+           name == "WARNING" || name == "WARN" ? LogLevel::WARNING :
+           name == "ERROR" ? LogLevel::ERROR : LogLevel::CRITICAL;
+}
+
+/**
+ * @brief Бекенд зберігання логів
+ */
+enum class LogBackend : uint8_t {
+    LITTLEFS,       // Файли з ротацією на LittleFS
+    PARTITION       // Кільцевий лог на окремому raw розділі
 };
 
 /**
@@ -95,9 +202,12 @@ struct LoggerConfig {
     size_t maxFileSize = 64 * 1024;      // 64KB на файл
     size_t maxTotalSize = 256 * 1024;    // 256KB всього
     uint8_t maxArchiveFiles = 3;         // 3 архівні файли
-    uint32_t flushInterval = 5000;       // Запис кожні 5 сек
+    uint32_t flushInterval = 5000;       // Group commit кожні 5 сек
+    LogLevel syncLevel = LogLevel::ERROR; // Цей рівень і вище - негайний commit + fsync
     bool compressOldLogs = false;        // Стиснення архівів
     bool haccp = true;                   // HACCP режим
+    LogBackend backend = LogBackend::LITTLEFS;
+    std::string partitionLabel = "logs"; // Розділ для LogBackend::PARTITION
 };
 
 /**
@@ -109,8 +219,12 @@ public:
     
     // Базові методи логування
     virtual void logFormatted(LogLevel level, const char* module, const char* message) = 0;
+    virtual void logMessage(LogLevel level, uint8_t moduleId, const char* message) = 0;
     virtual void logEvent(EventCode code, int32_t value = 0, const char* message = nullptr) = 0;
     
+    // ID модуля за іменем (викликається один раз на місце виклику MLOG_*)
+    virtual uint8_t internModule(const char* module) = 0;
+    
     // Спеціалізовані методи
     virtual void logSensorData(uint8_t sensorId, float value) = 0;
     virtual void logCompressorCycle(bool on, uint32_t runtime) = 0;
@@ -132,6 +246,41 @@ public:
 // Глобальний доступ до логера
 extern ILogger* g_logger;
 
+/**
+ * @brief Маски дозволених рівнів по модулях: біт N = LogLevel N дозволений
+ * 
+ * Читається без блокувань з MLOG_*; змінюється LoggerModule (RPC logger.set_level).
+ */
+constexpr uint8_t log_level_mask(LogLevel minLevel) {
+    return static_cast<uint8_t>(0x1F & (0xFF << static_cast<uint8_t>(minLevel)));
+}
+
+constexpr std::array<uint8_t, LOG_MAX_MODULES> log_default_masks() {
+    std::array<uint8_t, LOG_MAX_MODULES> masks{};
+    for (size_t i = 0; i < LOG_MAX_MODULES; i++) {
+        masks[i] = log_level_mask(LogLevel::INFO);
+    }
+    return masks;
+}
+
+extern std::array<uint8_t, LOG_MAX_MODULES> g_logLevelMask;
+
+inline bool mlog_enabled(LogLevel level, uint8_t moduleId) {
+    return (g_logLevelMask[moduleId] >> static_cast<uint8_t>(level)) & 1;
+}
+
+// ID для місця виклику: кешується в static змінній, включно з OTHER
+// для переповненої таблиці. До створення логера - OTHER без кешування
+inline uint8_t mlog_resolve(uint8_t& siteId, const char* module) {
+    if (siteId == LOG_MODULE_UNRESOLVED) {
+        if (!g_logger) {
+            return static_cast<uint8_t>(LogModule::OTHER);
+        }
+        siteId = g_logger->internModule(module);
+    }
+    return siteId;
+}
+
 // Допоміжна функція для форматованого логування
 inline void log_formatted(ILogger* logger, LogLevel level, const char* module, const char* fmt, ...) {
     if (!logger) return;
@@ -145,21 +294,69 @@ inline void log_formatted(ILogger* logger, LogLevel level, const char* module, c
     logger->logFormatted(level, module, buffer);
 }
 
+// Форматування лише після перевірки рівня (викликається з MLOG_*)
+inline void log_formatted_id(ILogger* logger, LogLevel level, uint8_t moduleId, const char* fmt, ...) {
+    if (!logger) return;
+    
+    char buffer[128];
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(buffer, sizeof(buffer), fmt, args);
+    va_end(args);
+    
+    logger->logMessage(level, moduleId, buffer);
+}
+
+// Мінімальний рівень що компілюється (Kconfig LOGGER_MIN_LEVEL)
+#ifdef CONFIG_LOGGER_MIN_LEVEL
+#define MLOG_MIN_LEVEL CONFIG_LOGGER_MIN_LEVEL
+#else
+#define MLOG_MIN_LEVEL 0
+#endif
+
+#ifdef MLOG_MODULE
+#define MLOG_SITE_ID_(site) static_cast<uint8_t>(MLOG_MODULE)
+#else
+#define MLOG_SITE_ID_(site) mlog_resolve(site, TAG)
+#endif
+
+// Рівень перевіряється до форматування; ID модуля не шукається на кожен виклик
+#define MLOG_AT_(level, fmt, ...) \
+    do { \
+        [[maybe_unused]] static uint8_t mlog_site_id_ = LOG_MODULE_UNRESOLVED; \
+        uint8_t mlog_id_ = MLOG_SITE_ID_(mlog_site_id_); \
+        if (mlog_enabled(level, mlog_id_)) { \
+            log_formatted_id(g_logger, level, mlog_id_, fmt, ##__VA_ARGS__); \
+        } \
+    } while (0)
+
 // Макроси для зручного логування
-#define MLOG_DEBUG(fmt, ...) \
-    log_formatted(g_logger, LogLevel::DEBUG, TAG, fmt, ##__VA_ARGS__)
+#if MLOG_MIN_LEVEL <= 0
+#define MLOG_DEBUG(fmt, ...) MLOG_AT_(LogLevel::DEBUG, fmt, ##__VA_ARGS__)
+#else
+#define MLOG_DEBUG(fmt, ...) do {} while (0)
+#endif
 
-#define MLOG_INFO(fmt, ...) \
-    log_formatted(g_logger, LogLevel::INFO, TAG, fmt, ##__VA_ARGS__)
+#if MLOG_MIN_LEVEL <= 1
+#define MLOG_INFO(fmt, ...) MLOG_AT_(LogLevel::INFO, fmt, ##__VA_ARGS__)
+#else
+#define MLOG_INFO(fmt, ...) do {} while (0)
+#endif
 
-#define MLOG_WARNING(fmt, ...) \
-    log_formatted(g_logger, LogLevel::WARNING, TAG, fmt, ##__VA_ARGS__)
+#if MLOG_MIN_LEVEL <= 2
+#define MLOG_WARNING(fmt, ...) MLOG_AT_(LogLevel::WARNING, fmt, ##__VA_ARGS__)
+#else
+#define MLOG_WARNING(fmt, ...) do {} while (0)
+#endif
 
-#define MLOG_ERROR(fmt, ...) \
-    log_formatted(g_logger, LogLevel::ERROR, TAG, fmt, ##__VA_ARGS__)
+#if MLOG_MIN_LEVEL <= 3
+#define MLOG_ERROR(fmt, ...) MLOG_AT_(LogLevel::ERROR, fmt, ##__VA_ARGS__)
+#else
+#define MLOG_ERROR(fmt, ...) do {} while (0)
+#endif
 
-#define MLOG_CRITICAL(fmt, ...) \
-    log_formatted(g_logger, LogLevel::CRITICAL, TAG, fmt, ##__VA_ARGS__)
+// CRITICAL не вимикається
+#define MLOG_CRITICAL(fmt, ...) MLOG_AT_(LogLevel::CRITICAL, fmt, ##__VA_ARGS__)
 
 #define MLOG_EVENT(code, value) \
     if (g_logger) g_logger->logEvent(code, value)
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "log_storage.h"
+#include "log_partition.h"
+#include <memory>
+#include <vector>
+
+namespace ModESP {
+
+/**
+ * @brief Кільцевий лог на raw розділі flash без файлової системи
+ *
+ * Розділ поділено на сектори (одиниця стирання). Перший слот сектору -
+ * SectorHeader з наскрізним номером сектору, решта - блоки LogBlock:
+ *
+ *   | SectorHeader | LogBlock 0 | LogBlock 1 | ... | LogBlock N-1 |
+ *
+ * Сектори заповнюються по колу. Сектор після поточного завжди стертий
+ * заздалегідь (erase-ahead), тому перехід на новий сектор - лише запис
+ * заголовка, а найстаріші дані втрачаються на сектор раніше.
+ * Кожен сектор стирається один раз за оберт кільця - знос рівномірний.
+ *
+ * При ініціалізації поточним вважається сектор з найбільшим номером,
+ * позиція запису - перший стертий слот у ньому. Недописаний блок
+ * (втрата живлення) не проходить CRC і пропускається.
+ *
+ * LogCursor: generation = номер сектору, offset = блок * CAPACITY + запис.
+ * Курсор на вже перезаписаний сектор продовжує з найстарішого.
+ */
+class PartitionLogStorage : public LogStorage {
+public:
+    // partition == nullptr - відкрити розділ config.partitionLabel
+    explicit PartitionLogStorage(const LoggerConfig& config,
+                                 std::unique_ptr<LogPartition> partition = nullptr);
+    ~PartitionLogStorage() override;
+
+    esp_err_t init() override;
+    esp_err_t deinit() override;
+
+    size_t getLogCount() override;
+    size_t readBatch(LogCursor& cursor, const LogFilter& filter, LogEntry* out, size_t maxCount) override;
+
+    bool clearLogs() override;
+    // Кільце не ротується - найстаріший сектор стирається автоматично
+    bool rotateFiles() override { return false; }
+
+    size_t getUsedSpace() override;
+    size_t getTotalSpace() override;
+
+protected:
+    bool isWritable() const override { return m_ready; }
+    esp_err_t writeBlock() override;
+    void afterCommit() override;
+
+private:
+    struct SectorHeader {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t blockSize;     // LogBlock::SIZE
+        uint32_t sequence;      // Наскрізний номер сектору, 0 не використовується
+        uint32_t firstBlock;    // Номер першого LogBlock у секторі
+        uint32_t eraseCount;    // Скільки разів сектор стирався
+        uint32_t crc;
+    } __attribute__((packed));
+
+    static constexpr uint32_t SECTOR_MAGIC = 0x52474C4D;   // "MLGR"
+    static constexpr uint16_t SECTOR_VERSION = 1;
+    static constexpr uint32_t ERASED_WORD = 0xFFFFFFFF;
+    static constexpr size_t MIN_SECTORS = 3;
+
+    bool readSectorHeader(size_t sector, SectorHeader& header);
+    esp_err_t openSector(size_t sector, uint32_t sequence);
+    esp_err_t eraseSector(size_t sector);
+    esp_err_t advanceSector();
+    esp_err_t format();
+    void scanHead(uint32_t firstBlock);
+
+    bool isErased(size_t offset, size_t len);
+    size_t blockOffset(size_t sector, size_t block) const;
+    bool locate(uint32_t sequence, size_t& sector) const;
+    size_t oldestSector() const;
+    size_t usedSectors() const;
+    static uint32_t headerCrc(const SectorHeader& header);
+
+    std::unique_ptr<LogPartition> m_partition;
+    size_t m_sectorSize;
+    size_t m_sectorCount;
+    size_t m_blocksPerSector;
+
+    std::vector<uint32_t> m_sectorSeq;      // Номер сектору, 0 = стертий або невалідний
+    std::vector<uint32_t> m_eraseCount;
+
+    size_t m_head;              // Сектор, в який зараз пишемо
+    uint32_t m_headSeq;
+    size_t m_writeBlock;        // Наступний вільний блок у m_head
+    bool m_eraseAheadPending;   // Стерти сектор після m_head після commit
+    bool m_ready;
+};
+
+} // namespace ModESP
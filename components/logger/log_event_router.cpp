@@ -0,0 +1,230 @@
+#include "log_event_router.h"
+#include <esp_log.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+static const char* TAG = "LogEventRouter";
+
+namespace ModESP {
+
+// Замінює колишні жорстко закодовані підписки LoggerModule
+const char* const LogEventRouter::DEFAULT_ROUTES = R"([
+    {"event": "sensor.temperature.alarm", "code": "HACCP_TEMP_VIOLATION",
+     "value": "temperature", "scale": 10, "message": "Temperature violation"},
+    {"event": "actuator.compressor.state", "when": {"on": true},
+     "code": "COMPRESSOR_ON", "module": "COMPRESSOR", "value": "runtime", "message": "Compressor on"},
+    {"event": "actuator.compressor.state", "when": {"on": false},
+     "code": "COMPRESSOR_OFF", "module": "COMPRESSOR", "value": "runtime", "message": "Compressor off"}
+])";
+
+namespace {
+
+struct EventCodeName {
+    const char* name;
+    EventCode code;
+};
+
+const EventCodeName EVENT_CODE_NAMES[] = {
+    {"SYSTEM_START", EventCode::SYSTEM_START},
+    {"SYSTEM_STOP", EventCode::SYSTEM_STOP},
+    {"CONFIG_CHANGED", EventCode::CONFIG_CHANGED},
+    {"MODULE_ERROR", EventCode::MODULE_ERROR},
+    {"TEMP_ALARM_HIGH", EventCode::TEMP_ALARM_HIGH},
+    {"TEMP_ALARM_LOW", EventCode::TEMP_ALARM_LOW},
+    {"TEMP_NORMAL", EventCode::TEMP_NORMAL},
+    {"TEMP_SENSOR_FAIL", EventCode::TEMP_SENSOR_FAIL},
+    {"TEMP_SNAPSHOT", EventCode::TEMP_SNAPSHOT},
+    {"DEFROST_START", EventCode::DEFROST_START},
+    {"DEFROST_END", EventCode::DEFROST_END},
+    {"DEFROST_TIMEOUT", EventCode::DEFROST_TIMEOUT},
+    {"DEFROST_SKIP", EventCode::DEFROST_SKIP},
+    {"COMPRESSOR_ON", EventCode::COMPRESSOR_ON},
+    {"COMPRESSOR_OFF", EventCode::COMPRESSOR_OFF},
+    {"COMPRESSOR_PROTECT", EventCode::COMPRESSOR_PROTECT},
+    {"COMPRESSOR_STATS", EventCode::COMPRESSOR_STATS},
+    {"DOOR_OPEN", EventCode::DOOR_OPEN},
+    {"DOOR_CLOSE", EventCode::DOOR_CLOSE},
+    {"DOOR_ALARM", EventCode::DOOR_ALARM},
+    {"HACCP_TEMP_VIOLATION", EventCode::HACCP_TEMP_VIOLATION},
+    {"HACCP_TEMP_RESTORED", EventCode::HACCP_TEMP_RESTORED},
+    {"HACCP_REPORT", EventCode::HACCP_REPORT},
+};
+
+} // namespace
+
+LogEventRouter::LogEventRouter(ILogger& logger, EmitCallback emit, void* ctx)
+    : m_logger(logger)
+    , m_emit(emit)
+    , m_ctx(ctx)
+    , m_compiled(false)
+    , m_subscribed(false) {
+}
+
+LogEventRouter::~LogEventRouter() {
+    unsubscribe();
+}
+
+size_t LogEventRouter::compile(const nlohmann::json& routes) {
+    if (m_subscribed) {
+        ESP_LOGW(TAG, "Routes already subscribed, recompiling requires restart");
+        return m_routes.size();
+    }
+    m_compiled = true;
+
+    const nlohmann::json source = routes.is_array() ? routes : nlohmann::json::parse(DEFAULT_ROUTES);
+    m_routes.clear();
+    m_routes.reserve(source.size());
+
+    for (size_t i = 0; i < source.size(); i++) {
+        const auto& rule = source[i];
+        if (!rule.is_object() || !rule.contains("event") || !rule["event"].is_string()) {
+            ESP_LOGW(TAG, "Route %zu: missing \"event\"", i);
+            continue;
+        }
+
+        Route route = {};
+        route.pattern = rule["event"].get<std::string>();
+
+        if (!rule.contains("code") || !parseEventCode(rule["code"], route.code)) {
+            ESP_LOGW(TAG, "Route %zu (%s): unknown event code", i, route.pattern.c_str());
+            continue;
+        }
+
+        route.level = log_level_from_name(rule.value("level", "INFO"));
+        std::string module = rule.value("module", "SYSTEM");
+        route.moduleId = m_logger.internModule(module.c_str());
+
+        if (rule.contains("value") && rule["value"].is_string()) {
+            route.valuePath = compilePath(rule["value"].get<std::string>());
+        }
+        route.scale = rule.value("scale", 1.0f);
+        route.sampleEvery = std::max<uint16_t>(1, rule.value("sample", 1));
+
+        if (rule.contains("when") && rule["when"].is_object()) {
+            for (const auto& item : rule["when"].items()) {
+                route.when.push_back({compilePath(item.key()), item.value()});
+            }
+        }
+
+        std::string message = rule.value("message", "");
+        strncpy(route.message, message.c_str(), sizeof(route.message) - 1);
+
+        m_routes.push_back(std::move(route));
+    }
+
+    ESP_LOGI(TAG, "Compiled %zu/%zu log routes%s", m_routes.size(), source.size(),
+             routes.is_array() ? "" : " (defaults)");
+    return m_routes.size();
+}
+
+void LogEventRouter::subscribe() {
+    if (m_subscribed) {
+        return;
+    }
+
+    // Одна підписка на правило - EventBus сам фільтрує за шаблоном,
+    // обробник отримує індекс правила без пошуку
+    for (size_t i = 0; i < m_routes.size(); i++) {
+        m_routes[i].handle = EventBus::subscribe(m_routes[i].pattern,
+            [this, i](const EventBus::Event& event) {
+                dispatch(i, event);
+            });
+    }
+    m_subscribed = true;
+}
+
+void LogEventRouter::unsubscribe() {
+    if (!m_subscribed) {
+        return;
+    }
+
+    for (auto& route : m_routes) {
+        EventBus::unsubscribe(route.handle);
+    }
+    m_subscribed = false;
+}
+
+void LogEventRouter::dispatch(size_t index, const EventBus::Event& event) {
+    Route& route = m_routes[index];
+
+    // Умови перевіряємо до семплінгу, щоб рахувати лише свої події
+    for (const auto& condition : route.when) {
+        const nlohmann::json* field = lookup(event.data, condition.path);
+        if (!field || *field != condition.expected) {
+            return;
+        }
+    }
+
+    if (route.seen++ % route.sampleEvery != 0) {
+        return;
+    }
+
+    int32_t value = 0;
+    if (!route.valuePath.empty()) {
+        const nlohmann::json* field = lookup(event.data, route.valuePath);
+        if (field && field->is_number()) {
+            value = static_cast<int32_t>(lroundf(field->get<float>() * route.scale));
+        } else if (field && field->is_boolean()) {
+            value = field->get<bool>() ? 1 : 0;
+        } else {
+            route.missing++;
+        }
+    }
+
+    route.logged++;
+    m_emit(m_ctx, route, value);
+}
+
+bool LogEventRouter::parseEventCode(const nlohmann::json& value, EventCode& code) {
+    if (value.is_number_unsigned()) {
+        code = static_cast<EventCode>(value.get<uint16_t>());
+        return true;
+    }
+    if (!value.is_string()) {
+        return false;
+    }
+
+    const std::string& name = value.get_ref<const std::string&>();
+    for (const auto& entry : EVENT_CODE_NAMES) {
+        if (name == entry.name) {
+            code = entry.code;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<std::string> LogEventRouter::compilePath(const std::string& path) {
+    std::vector<std::string> keys;
+    size_t start = 0;
+    while (start <= path.size()) {
+        size_t dot = path.find('.', start);
+        if (dot == std::string::npos) {
+            dot = path.size();
+        }
+        if (dot > start) {
+            keys.push_back(path.substr(start, dot - start));
+        }
+        start = dot + 1;
+    }
+    return keys;
+}
+
+const nlohmann::json* LogEventRouter::lookup(const nlohmann::json& data,
+                                             const std::vector<std::string>& path) {
+    const nlohmann::json* node = &data;
+    for (const auto& key : path) {
+        if (!node->is_object()) {
+            return nullptr;
+        }
+        auto it = node->find(key);
+        if (it == node->end()) {
+            return nullptr;
+        }
+        node = &*it;
+    }
+    return node;
+}
+
+} // namespace ModESP
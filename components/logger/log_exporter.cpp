@@ -0,0 +1,212 @@
+#include "log_exporter.h"
+#include <esp_log.h>
+#include <cstring>
+#include <algorithm>
+
+static const char* TAG = "LogExporter";
+
+namespace ModESP {
+
+LogExporter::LogExporter(LogStorage& storage, ExportFormat format,
+                         const LogFilter& filter, const LogCursor& start)
+    : m_storage(storage)
+    , m_format(format)
+    , m_filter(filter)
+    , m_cursor(start)
+    , m_sink(nullptr)
+    , m_written(0)
+    , m_chunkUsed(0) {
+}
+
+esp_err_t LogExporter::run(const ChunkSink& sink, uint32_t maxEntries) {
+    m_sink = &sink;
+    m_written = 0;
+    m_chunkUsed = 0;
+
+    esp_err_t ret = writeHeader();
+
+    while (ret == ESP_OK && !m_cursor.done) {
+        size_t request = READ_BATCH;
+        if (maxEntries > 0) {
+            if (m_written >= maxEntries) {
+                break;
+            }
+            // Не читаємо більше ніж лишилось - курсор не проскочить ліміт
+            request = std::min<size_t>(request, maxEntries - m_written);
+        }
+
+        size_t count = m_storage.readBatch(m_cursor, m_filter, m_batch, request);
+        for (size_t i = 0; i < count && ret == ESP_OK; i++) {
+            ret = writeEntry(m_batch[i]);
+        }
+    }
+
+    if (ret == ESP_OK) {
+        ret = writeFooter();
+    }
+    if (ret == ESP_OK) {
+        ret = flush();
+    }
+
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Export aborted after %lu entries: %s", m_written, esp_err_to_name(ret));
+    } else {
+        ESP_LOGD(TAG, "Exported %lu entries", m_written);
+    }
+
+    m_sink = nullptr;
+    return ret;
+}
+
+esp_err_t LogExporter::writeHeader() {
+    switch (m_format) {
+        case ExportFormat::CSV: {
+            static const char header[] = "Timestamp,Level,Module,Event,Value,Message\n";
+            return append(header, sizeof(header) - 1);
+        }
+        case ExportFormat::JSON: {
+            static const char header[] = "{\n  \"logs\": [\n";
+            return append(header, sizeof(header) - 1);
+        }
+        case ExportFormat::BINARY: {
+            BinaryHeader header = {};
+            memcpy(header.magic, "MLOG", sizeof(header.magic));
+            header.version = 1;
+            header.entrySize = sizeof(LogEntry);
+            return append(reinterpret_cast<const char*>(&header), sizeof(header));
+        }
+    }
+    return ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t LogExporter::writeEntry(const LogEntry& entry) {
+    if (m_format == ExportFormat::BINARY) {
+        m_written++;
+        return append(reinterpret_cast<const char*>(&entry), sizeof(entry));
+    }
+
+    // Повідомлення з файлу може бути без завершального нуля
+    char message[sizeof(entry.message) * 2 + 1];
+    size_t len = strnlen(entry.message, sizeof(entry.message));
+    size_t pos = 0;
+    for (size_t i = 0; i < len; i++) {
+        char c = entry.message[i];
+        if (m_format == ExportFormat::JSON && (c == '"' || c == '\\')) {
+            message[pos++] = '\\';
+        } else if (m_format == ExportFormat::CSV && c == ',') {
+            c = ';';
+        }
+        message[pos++] = (static_cast<unsigned char>(c) < 0x20) ? ' ' : c;
+    }
+    message[pos] = '\0';
+
+    char line[160];
+    int n;
+    if (m_format == ExportFormat::CSV) {
+        n = snprintf(line, sizeof(line),
+            "%lu,%u,%u,%u,%ld,%s\n",
+            entry.timestamp,
+            entry.level,
+            entry.moduleId,
+            entry.eventCode,
+            entry.value,
+            message
+        );
+    } else {
+        n = snprintf(line, sizeof(line),
+            "%s    {\"timestamp\": %lu, \"level\": %u, \"module\": %u, "
+            "\"event\": %u, \"value\": %ld, \"message\": \"%s\"}",
+            m_written > 0 ? ",\n" : "",
+            entry.timestamp,
+            entry.level,
+            entry.moduleId,
+            entry.eventCode,
+            entry.value,
+            message
+        );
+    }
+
+    m_written++;
+    return append(line, std::min<size_t>(n, sizeof(line) - 1));
+}
+
+esp_err_t LogExporter::writeFooter() {
+    char token[LogCursor::TOKEN_SIZE];
+    m_cursor.toToken(token, sizeof(token));
+
+    switch (m_format) {
+        case ExportFormat::CSV: {
+            char line[48];
+            int n = snprintf(line, sizeof(line), "# cursor=%s\n", token);
+            return append(line, n);
+        }
+        case ExportFormat::JSON: {
+            char tail[80];
+            int n = snprintf(tail, sizeof(tail),
+                "\n  ],\n  \"count\": %lu,\n  \"cursor\": \"%s\",\n  \"complete\": %s\n}",
+                m_written, token, m_cursor.done ? "true" : "false");
+            return append(tail, n);
+        }
+        case ExportFormat::BINARY: {
+            LogEntry trailer = {};
+            trailer.level = static_cast<uint8_t>(LogLevel::NONE);
+            trailer.value = m_cursor.done ? 1 : 0;
+            strncpy(trailer.message, token, sizeof(trailer.message) - 1);
+            return append(reinterpret_cast<const char*>(&trailer), sizeof(trailer));
+        }
+    }
+    return ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t LogExporter::append(const char* data, size_t len) {
+    while (len > 0) {
+        size_t space = CHUNK_SIZE - m_chunkUsed;
+        size_t part = std::min(space, len);
+        memcpy(m_chunk + m_chunkUsed, data, part);
+        m_chunkUsed += part;
+        data += part;
+        len -= part;
+
+        if (m_chunkUsed == CHUNK_SIZE) {
+            esp_err_t ret = flush();
+            if (ret != ESP_OK) {
+                return ret;
+            }
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t LogExporter::flush() {
+    if (m_chunkUsed == 0 || !m_sink) {
+        return ESP_OK;
+    }
+
+    esp_err_t ret = (*m_sink)(m_chunk, m_chunkUsed);
+    m_chunkUsed = 0;
+    return ret;
+}
+
+bool LogExporter::parseFormat(const char* name, ExportFormat& format) {
+    if (!name || strcmp(name, "csv") == 0) {
+        format = ExportFormat::CSV;
+    } else if (strcmp(name, "json") == 0) {
+        format = ExportFormat::JSON;
+    } else if (strcmp(name, "bin") == 0 || strcmp(name, "binary") == 0) {
+        format = ExportFormat::BINARY;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* LogExporter::contentType(ExportFormat format) {
+    switch (format) {
+        case ExportFormat::CSV: return "text/csv";
+        case ExportFormat::JSON: return "application/json";
+        case ExportFormat::BINARY: return "application/octet-stream";
+    }
+    return "application/octet-stream";
+}
+
+} // namespace ModESP
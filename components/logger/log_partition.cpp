@@ -0,0 +1,150 @@
+#include "log_partition.h"
+#include <esp_log.h>
+
+static const char* TAG = "LogPartition";
+
+namespace ModESP {
+
+// === EspLogPartition ===
+
+EspLogPartition::EspLogPartition(const esp_partition_t* partition)
+    : m_partition(partition) {
+}
+
+std::unique_ptr<LogPartition> EspLogPartition::open(const char* label) {
+    const esp_partition_t* partition = esp_partition_find_first(
+        ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, label);
+    if (!partition) {
+        ESP_LOGE(TAG, "Partition '%s' not found", label);
+        return nullptr;
+    }
+
+    ESP_LOGI(TAG, "Using partition '%s' at 0x%lx, %lu bytes", label,
+             static_cast<unsigned long>(partition->address),
+             static_cast<unsigned long>(partition->size));
+    return std::make_unique<EspLogPartition>(partition);
+}
+
+esp_err_t EspLogPartition::read(size_t offset, void* dst, size_t len) {
+    return esp_partition_read(m_partition, offset, dst, len);
+}
+
+esp_err_t EspLogPartition::write(size_t offset, const void* src, size_t len) {
+    return esp_partition_write(m_partition, offset, src, len);
+}
+
+esp_err_t EspLogPartition::eraseSector(size_t sector) {
+    return esp_partition_erase_range(m_partition, sector * m_partition->erase_size,
+                                     m_partition->erase_size);
+}
+
+size_t EspLogPartition::size() const {
+    return m_partition->size;
+}
+
+size_t EspLogPartition::sectorSize() const {
+    return m_partition->erase_size;
+}
+
+// === FileLogPartition ===
+
+FileLogPartition::FileLogPartition(const std::string& path, size_t size, size_t sectorSize)
+    : m_path(path)
+    , m_size(size - size % sectorSize)
+    , m_sectorSize(sectorSize)
+    , m_file(nullptr)
+    , m_eraseCounts(size / sectorSize, 0)
+    , m_writeViolations(0) {
+}
+
+FileLogPartition::~FileLogPartition() {
+    if (m_file) {
+        fclose(m_file);
+    }
+}
+
+esp_err_t FileLogPartition::open() {
+    m_file = fopen(m_path.c_str(), "r+b");
+    if (m_file) {
+        fseek(m_file, 0, SEEK_END);
+        if (static_cast<size_t>(ftell(m_file)) >= m_size) {
+            return ESP_OK;
+        }
+        // Файл коротший за розділ - створюємо заново
+        fclose(m_file);
+    }
+
+    m_file = fopen(m_path.c_str(), "w+b");
+    if (!m_file) {
+        ESP_LOGE(TAG, "Failed to create %s", m_path.c_str());
+        return ESP_FAIL;
+    }
+
+    std::vector<uint8_t> erased(m_sectorSize, 0xFF);
+    for (size_t offset = 0; offset < m_size; offset += m_sectorSize) {
+        if (fwrite(erased.data(), 1, erased.size(), m_file) != erased.size()) {
+            return ESP_FAIL;
+        }
+    }
+    fflush(m_file);
+    return ESP_OK;
+}
+
+esp_err_t FileLogPartition::read(size_t offset, void* dst, size_t len) {
+    if (!m_file || offset + len > m_size) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (fseek(m_file, offset, SEEK_SET) != 0 || fread(dst, 1, len, m_file) != len) {
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+esp_err_t FileLogPartition::write(size_t offset, const void* src, size_t len) {
+    if (!m_file || offset + len > m_size) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    std::vector<uint8_t> current(len);
+    esp_err_t ret = read(offset, current.data(), len);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    // Запис на NOR flash може лише скидати біти
+    const uint8_t* data = static_cast<const uint8_t*>(src);
+    for (size_t i = 0; i < len; i++) {
+        if (data[i] & ~current[i]) {
+            m_writeViolations++;
+        }
+        current[i] &= data[i];
+    }
+
+    if (fseek(m_file, offset, SEEK_SET) != 0 ||
+        fwrite(current.data(), 1, len, m_file) != len) {
+        return ESP_FAIL;
+    }
+    fflush(m_file);
+    return ESP_OK;
+}
+
+esp_err_t FileLogPartition::eraseSector(size_t sector) {
+    if (!m_file || (sector + 1) * m_sectorSize > m_size) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    std::vector<uint8_t> erased(m_sectorSize, 0xFF);
+    if (fseek(m_file, sector * m_sectorSize, SEEK_SET) != 0 ||
+        fwrite(erased.data(), 1, erased.size(), m_file) != erased.size()) {
+        return ESP_FAIL;
+    }
+    fflush(m_file);
+    m_eraseCounts[sector]++;
+    return ESP_OK;
+}
+
+uint32_t FileLogPartition::eraseCount(size_t sector) const {
+    return sector < m_eraseCounts.size() ? m_eraseCounts[sector] : 0;
+}
+
+} // namespace ModESP
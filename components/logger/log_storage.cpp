@@ -1,6 +1,8 @@
 #include "log_storage.h"
+#include "partition_log_storage.h"
 #include <esp_log.h>
 #include <esp_littlefs.h>
+#include <esp_timer.h>
 #include <cstring>
 #include <algorithm>
 #include <sys/stat.h>
@@ -10,18 +12,145 @@ static const char* TAG = "LogStorage";
 
 namespace ModESP {
 
-LogStorage::LogStorage(const LoggerConfig& config) 
+LogStorage::LogStorage(const LoggerConfig& config)
     : m_config(config)
+    , m_nextSequence(0)
+    , m_pendingSinceUs(0) {
+    m_pending.reset();
+}
+
+std::unique_ptr<LogStorage> LogStorage::create(const LoggerConfig& config) {
+    if (config.backend == LogBackend::PARTITION) {
+        return std::make_unique<PartitionLogStorage>(config);
+    }
+    return std::make_unique<FileLogStorage>(config);
+}
+
+esp_err_t LogStorage::writeEntry(const LogEntry& entry) {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    
+    esp_err_t ret = append(entry);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    
+    // Критичні записи фіксуємо негайно
+    if (static_cast<LogLevel>(entry.level) >= m_config.syncLevel) {
+        return commit();
+    }
+    
+    return ESP_OK;
+}
+
+esp_err_t LogStorage::writeEntries(const std::vector<LogEntry>& entries) {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    
+    if (!isWritable() || entries.empty()) {
+        return ESP_FAIL;
+    }
+    
+    bool syncNeeded = false;
+    for (const auto& entry : entries) {
+        esp_err_t ret = append(entry);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+        syncNeeded |= static_cast<LogLevel>(entry.level) >= m_config.syncLevel;
+    }
+    
+    // Один commit на всю пачку
+    return syncNeeded ? commit() : ESP_OK;
+}
+
+esp_err_t LogStorage::append(const LogEntry& entry) {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    
+    if (!isWritable()) {
+        return ESP_FAIL;
+    }
+    
+    // Блок, який не вдалося записати, ще займає буфер - повторюємо спробу.
+    // Якщо носій досі недоступний, новий запис втрачається
+    if (m_pending.full() && commit() != ESP_OK) {
+        return ESP_ERR_NO_MEM;
+    }
+    
+    if (m_pending.empty()) {
+        m_pendingSinceUs = esp_timer_get_time();
+    }
+    m_pending.add(entry);
+    
+    // Повний блок записуємо одразу
+    if (m_pending.full()) {
+        return commit();
+    }
+    
+    return ESP_OK;
+}
+
+esp_err_t LogStorage::commit() {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    
+    if (m_pending.empty()) {
+        return ESP_OK;
+    }
+    
+    m_pending.seal(m_nextSequence);
+    esp_err_t ret = writeBlock();
+    if (ret != ESP_OK) {
+        // Бекенд відкотив або пропустив пошкоджене місце - блок лишається
+        // в RAM і записується наступним commit() з тим самим номером.
+        // Відлік flushInterval починається заново, щоб не повторювати щоциклу
+        ESP_LOGE(TAG, "Failed to write log block #%lu, will retry", m_nextSequence);
+        m_pendingSinceUs = esp_timer_get_time();
+        return ret;
+    }
+    
+    // Неповний блок не дописується пізніше - вже записаний блок
+    // ніколи не перезаписується, тому не може бути пошкоджений
+    m_nextSequence++;
+    m_pending.reset();
+    afterCommit();
+    
+    return ESP_OK;
+}
+
+uint32_t LogStorage::pendingAgeMs() const {
+    if (m_pending.empty()) {
+        return 0;
+    }
+    return static_cast<uint32_t>((esp_timer_get_time() - m_pendingSinceUs) / 1000);
+}
+
+std::vector<LogEntry> LogStorage::readLogs(const LogFilter& filter) {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    std::vector<LogEntry> result;
+    
+    LogCursor cursor;
+    LogEntry batch[LogBlock::CAPACITY];
+    
+    while (!cursor.done && result.size() < filter.maxEntries) {
+        size_t request = std::min<size_t>(LogBlock::CAPACITY, filter.maxEntries - result.size());
+        size_t count = readBatch(cursor, filter, batch, request);
+        result.insert(result.end(), batch, batch + count);
+    }
+    
+    return result;
+}
+
+FileLogStorage::FileLogStorage(const LoggerConfig& config) 
+    : LogStorage(config)
     , m_mounted(false)
     , m_currentFile(nullptr)
-    , m_currentFileSize(0) {
+    , m_currentFileSize(0)
+    , m_generation(0) {
 }
 
-LogStorage::~LogStorage() {
+FileLogStorage::~FileLogStorage() {
     deinit();
 }
 
-esp_err_t LogStorage::init() {
+esp_err_t FileLogStorage::init() {
     ESP_LOGI(TAG, "Initializing LittleFS storage");
     
     // Монтуємо файлову систему
@@ -46,6 +175,12 @@ esp_err_t LogStorage::init() {
         }
     }
     
+    // Відкидаємо недописаний хвіст після втрати живлення
+    ret = recoverTail();
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    
     // Відкриваємо поточний файл логів
     m_currentFile = openLogFile(CURRENT_LOG, "ab");
     if (!m_currentFile) {
@@ -57,12 +192,18 @@ esp_err_t LogStorage::init() {
     fseek(m_currentFile, 0, SEEK_END);
     m_currentFileSize = ftell(m_currentFile);
     
-    ESP_LOGI(TAG, "Storage initialized, current log size: %zu bytes", m_currentFileSize);
+    ESP_LOGI(TAG, "Storage initialized, current log size: %zu bytes, next block #%lu",
+             m_currentFileSize, m_nextSequence);
     return ESP_OK;
 }
-esp_err_t LogStorage::deinit() {
+esp_err_t FileLogStorage::deinit() {
     ESP_LOGI(TAG, "Deinitializing storage");
     
+    {
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
+        commit();
+    }
+    
     if (m_currentFile) {
         closeLogFile(m_currentFile);
         m_currentFile = nullptr;
@@ -71,7 +212,7 @@ esp_err_t LogStorage::deinit() {
     return unmountLittleFS();
 }
 
-esp_err_t LogStorage::mountLittleFS() {
+esp_err_t FileLogStorage::mountLittleFS() {
     // Перевіряємо чи LittleFS вже змонтована (наприклад ConfigManager)
     struct stat st;
     if (stat(MOUNT_POINT, &st) == 0) {
@@ -129,7 +270,7 @@ esp_err_t LogStorage::mountLittleFS() {
     
     return ESP_OK;
 }
-esp_err_t LogStorage::unmountLittleFS() {
+esp_err_t FileLogStorage::unmountLittleFS() {
     if (!m_mounted) {
         return ESP_OK;
     }
@@ -142,103 +283,221 @@ esp_err_t LogStorage::unmountLittleFS() {
     return ESP_OK;
 }
 
-esp_err_t LogStorage::writeEntry(const LogEntry& entry) {
+esp_err_t FileLogStorage::writeBlock() {
     if (!m_currentFile) {
         return ESP_FAIL;
     }
     
-    // Записуємо запис
-    size_t written = fwrite(&entry, sizeof(LogEntry), 1, m_currentFile);
-    if (written != 1) {
-        ESP_LOGE(TAG, "Failed to write log entry");
+    bool written = fwrite(&m_pending, LogBlock::SIZE, 1, m_currentFile) == 1 &&
+                   fflush(m_currentFile) == 0;
+    if (!written) {
+        ESP_LOGE(TAG, "Short write of block #%lu", m_nextSequence);
+        rollbackBlock();
         return ESP_FAIL;
     }
     
-    m_currentFileSize += sizeof(LogEntry);
+    // Не підтверджений на флеші блок не рахується записаним: його
+    // послідовність буде використана знову
+    if (fsync(fileno(m_currentFile)) != 0) {
+        ESP_LOGE(TAG, "fsync failed for block #%lu", m_nextSequence);
+        rollbackBlock();
+        return ESP_FAIL;
+    }
     
-    // Флашимо для критичних записів
-    if (static_cast<LogLevel>(entry.level) >= LogLevel::ERROR) {
-        fflush(m_currentFile);
+    m_currentFileSize += LogBlock::SIZE;
+    return ESP_OK;
+}
+
+void FileLogStorage::rollbackBlock() {
+    // Частина блоку зсунула б усі наступні з 512-байтної сітки. Файл
+    // відкрито на дозапис, тому закриваємо його (залишок буфера stdio
+    // потрапляє у файл) і обрізаємо до останнього цілого блоку
+    closeLogFile(m_currentFile);
+    m_currentFile = nullptr;
+    
+    if (truncate(CURRENT_LOG, m_currentFileSize) != 0) {
+        // Наступні блоки були б зміщені - запис зупиняється до перезапуску
+        ESP_LOGE(TAG, "Failed to truncate %s to %zu bytes", CURRENT_LOG, m_currentFileSize);
+        return;
     }
     
-    // Перевіряємо необхідність ротації
+    m_currentFile = openLogFile(CURRENT_LOG, "ab");
+    if (!m_currentFile) {
+        ESP_LOGE(TAG, "Failed to reopen current log file");
+    }
+}
+
+void FileLogStorage::afterCommit() {
     if (checkRotationNeeded()) {
         performRotation();
     }
-    
-    return ESP_OK;
 }
-esp_err_t LogStorage::writeEntries(const std::vector<LogEntry>& entries) {
-    if (!m_currentFile || entries.empty()) {
-        return ESP_FAIL;
+
+esp_err_t FileLogStorage::recoverTail() {
+    FILE* file = openLogFile(CURRENT_LOG, "rb");
+    if (!file) {
+        // Поточного файлу немає - продовжуємо нумерацію з архіву
+        uint32_t last = readLastSequence(getArchiveLogPath(1));
+        m_nextSequence = last + 1;
+        return ESP_OK;
     }
     
-    // Записуємо всі записи
-    size_t written = fwrite(entries.data(), sizeof(LogEntry), entries.size(), m_currentFile);
-    if (written != entries.size()) {
-        ESP_LOGE(TAG, "Failed to write all entries: %zu of %zu", written, entries.size());
-        return ESP_FAIL;
+    fseek(file, 0, SEEK_END);
+    size_t fileSize = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    
+    size_t validBlocks = 0;
+    bool legacy = false;
+    while (fread(&m_scratch, LogBlock::SIZE, 1, file) == 1) {
+        if (validBlocks == 0 && m_scratch.header.magic != LogBlock::MAGIC) {
+            legacy = true;
+            break;
+        }
+        if (!m_scratch.isValid()) {
+            break;
+        }
+        if (validBlocks > 0 && m_scratch.header.sequence != m_nextSequence) {
+            break;
+        }
+        m_nextSequence = m_scratch.header.sequence + 1;
+        validBlocks++;
+    }
+    if (validBlocks == 0 && fileSize > 0 && fileSize < LogBlock::SIZE) {
+        // Занадто малий для блоку - перевіряємо magic часткового запису
+        uint32_t magic = 0;
+        fseek(file, 0, SEEK_SET);
+        legacy = fread(&magic, sizeof(magic), 1, file) == 1 && magic != LogBlock::MAGIC;
+    }
+    closeLogFile(file);
+    
+    if (legacy) {
+        // Файл старого формату (суцільні LogEntry) - зберігаємо окремо
+        ESP_LOGW(TAG, "Legacy log format detected, moving to %s", LEGACY_LOG);
+        deleteFile(LEGACY_LOG);
+        renameFile(CURRENT_LOG, LEGACY_LOG);
+        m_nextSequence = 0;
+        return ESP_OK;
     }
     
-    m_currentFileSize += written * sizeof(LogEntry);
+    if (validBlocks == 0) {
+        m_nextSequence = readLastSequence(getArchiveLogPath(1)) + 1;
+    }
     
-    // Перевіряємо ротацію
-    if (checkRotationNeeded()) {
-        performRotation();
+    size_t validSize = validBlocks * LogBlock::SIZE;
+    if (fileSize != validSize) {
+        ESP_LOGW(TAG, "Truncating torn log tail: %zu -> %zu bytes", fileSize, validSize);
+        if (truncate(CURRENT_LOG, validSize) != 0) {
+            ESP_LOGE(TAG, "Failed to truncate %s", CURRENT_LOG);
+            return ESP_FAIL;
+        }
     }
     
     return ESP_OK;
 }
 
-std::vector<LogEntry> LogStorage::readLogs(const LogFilter& filter) {
-    std::vector<LogEntry> result;
+uint32_t FileLogStorage::readLastSequence(const std::string& path) {
+    FILE* file = openLogFile(path, "rb");
+    if (!file) {
+        return 0;
+    }
+    
+    uint32_t sequence = 0;
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    if (size >= static_cast<long>(LogBlock::SIZE)) {
+        long last = (size / LogBlock::SIZE - 1) * LogBlock::SIZE;
+        if (fseek(file, last, SEEK_SET) == 0 &&
+            fread(&m_scratch, LogBlock::SIZE, 1, file) == 1 &&
+            m_scratch.isValid()) {
+            sequence = m_scratch.header.sequence;
+        }
+    }
     
-    // Список файлів для читання
-    std::vector<std::string> files = {
-        CURRENT_LOG,
-        getCriticalLogPath()
-    };
+    closeLogFile(file);
+    return sequence;
+}
+
+size_t FileLogStorage::readBatch(LogCursor& cursor, const LogFilter& filter,
+                             LogEntry* out, size_t maxCount) {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    
+    if (cursor.done || maxCount == 0) {
+        return 0;
+    }
+    
+    if (!cursor.started) {
+        // Починаємо з найстарішого архіву
+        cursor.generation = m_generation;
+        cursor.fileIndex = m_config.maxArchiveFiles;
+        cursor.offset = 0;
+        cursor.started = true;
+    } else if (cursor.generation != m_generation) {
+        // Після ротації файли зсунулись на (m_generation - generation) позицій
+        uint32_t shift = m_generation - cursor.generation;
+        uint32_t index = cursor.fileIndex + shift;
+        if (index > m_config.maxArchiveFiles) {
+            // Файл курсора вже видалено - продовжуємо з найстарішого наявного
+            ESP_LOGW(TAG, "Cursor file rotated out, resuming from oldest archive");
+            index = m_config.maxArchiveFiles;
+            cursor.offset = 0;
+        }
+        cursor.fileIndex = static_cast<uint8_t>(index);
+        cursor.generation = m_generation;
+    }
     
-    // Додаємо архівні файли
-    for (int i = 1; i <= m_config.maxArchiveFiles; i++) {
-        files.push_back(getArchiveLogPath(i));
-    }    
-    // Читаємо з кожного файлу
-    for (const auto& filepath : files) {
-        FILE* file = openLogFile(filepath, "rb");
-        if (!file) continue;
+    while (true) {
+        std::string path = cursor.fileIndex == 0 ? std::string(CURRENT_LOG)
+                                                 : getArchiveLogPath(cursor.fileIndex);
+        FILE* file = openLogFile(path, "rb");
         
-        LogEntry entry;
-        while (fread(&entry, sizeof(LogEntry), 1, file) == 1) {
-            // Застосовуємо фільтр
-            if (static_cast<LogLevel>(entry.level) < filter.minLevel) continue;
-            if (filter.startTime > 0 && entry.timestamp < filter.startTime) continue;
-            if (filter.endTime > 0 && entry.timestamp > filter.endTime) continue;
-            
-            if (!filter.moduleIds.empty()) {
-                if (std::find(filter.moduleIds.begin(), filter.moduleIds.end(), 
-                    entry.moduleId) == filter.moduleIds.end()) continue;
-            }
+        // offset = номер блоку * CAPACITY + запис у блоці
+        size_t blockIndex = cursor.offset / LogBlock::CAPACITY;
+        size_t entryIndex = cursor.offset % LogBlock::CAPACITY;
+        
+        bool haveBlock = false;
+        if (file) {
+            haveBlock = fseek(file, static_cast<long>(blockIndex * LogBlock::SIZE), SEEK_SET) == 0 &&
+                        fread(&m_scratch, LogBlock::SIZE, 1, file) == 1;
+            closeLogFile(file);
+        }
+        
+        if (haveBlock) {
+            size_t matched = 0;
+            bool valid = m_scratch.isValid();
             
-            if (!filter.eventCodes.empty()) {
-                if (std::find(filter.eventCodes.begin(), filter.eventCodes.end(), 
-                    entry.eventCode) == filter.eventCodes.end()) continue;
+            if (valid) {
+                size_t end = std::min<size_t>(m_scratch.header.count, entryIndex + maxCount);
+                for (size_t i = entryIndex; i < end; i++) {
+                    if (filter.matches(m_scratch.entries[i])) {
+                        out[matched++] = m_scratch.entries[i];
+                    }
+                }
+                entryIndex = end;
+            } else {
+                ESP_LOGW(TAG, "Skipping corrupted block %zu in %s", blockIndex, path.c_str());
             }
             
-            result.push_back(entry);
-            
-            if (result.size() >= filter.maxEntries) {
-                closeLogFile(file);
-                return result;
+            // Неповний або пошкоджений блок - переходимо до наступного
+            if (!valid || entryIndex >= m_scratch.header.count) {
+                cursor.offset = (blockIndex + 1) * LogBlock::CAPACITY;
+            } else {
+                cursor.offset = blockIndex * LogBlock::CAPACITY + entryIndex;
             }
+            return matched;
         }
         
-        closeLogFile(file);
+        // Файл вичерпано (або відсутній) - переходимо до новішого
+        if (cursor.fileIndex == 0) {
+            cursor.done = true;
+            return 0;
+        }
+        cursor.fileIndex--;
+        cursor.offset = 0;
     }
-    
-    return result;
 }
-size_t LogStorage::getLogCount() {
+
+size_t FileLogStorage::getLogCount() {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
     size_t count = 0;
     
     // Список файлів для підрахунку
@@ -253,21 +512,36 @@ size_t LogStorage::getLogCount() {
     }
     
     for (const auto& filepath : files) {
-        FILE* file = openLogFile(filepath, "rb");
-        if (!file) continue;
-        
-        // Рахуємо записи
-        fseek(file, 0, SEEK_END);
-        size_t fileSize = ftell(file);
-        count += fileSize / sizeof(LogEntry);
-        
-        closeLogFile(file);
+        count += countEntries(filepath);
+    }
+    
+    return count + m_pending.header.count;
+}
+
+size_t FileLogStorage::countEntries(const std::string& path) {
+    FILE* file = openLogFile(path, "rb");
+    if (!file) {
+        return 0;
+    }
+    
+    // Читаємо лише заголовки блоків
+    size_t count = 0;
+    LogBlock::Header header;
+    long offset = 0;
+    while (fseek(file, offset, SEEK_SET) == 0 &&
+           fread(&header, sizeof(header), 1, file) == 1) {
+        if (header.magic == LogBlock::MAGIC && header.count <= LogBlock::CAPACITY) {
+            count += header.count;
+        }
+        offset += LogBlock::SIZE;
     }
     
+    closeLogFile(file);
     return count;
 }
 
-bool LogStorage::clearLogs() {
+bool FileLogStorage::clearLogs() {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
     ESP_LOGI(TAG, "Clearing all log files");
     
     // Закриваємо поточний файл
@@ -287,11 +561,17 @@ bool LogStorage::clearLogs() {
     // Відкриваємо новий поточний файл
     m_currentFile = openLogFile(CURRENT_LOG, "wb");
     m_currentFileSize = 0;
+    m_pending.reset();
+    
+    // Інвалідуємо видані курсори - вони продовжать з найстарішого файлу
+    m_generation += m_config.maxArchiveFiles + 1;
     
     return m_currentFile != nullptr;
 }
 
-bool LogStorage::rotateFiles() {
+bool FileLogStorage::rotateFiles() {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    
     if (!checkRotationNeeded()) {
         return false;
     }
@@ -300,63 +580,7 @@ bool LogStorage::rotateFiles() {
     return true;
 }
 
-bool LogStorage::exportToCSV(std::string& output, const LogFilter& filter) {
-    auto logs = readLogs(filter);
-    
-    output = "Timestamp,Level,Module,Event,Value,Message\n";
-    
-    for (const auto& entry : logs) {
-        char line[256];
-        snprintf(line, sizeof(line), 
-            "%lu,%u,%u,%u,%ld,%s\n",
-            entry.timestamp,
-            entry.level,
-            entry.moduleId,
-            entry.eventCode,
-            entry.value,
-            entry.message
-        );
-        output += line;
-    }
-    
-    return true;
-}
-
-bool LogStorage::exportToJSON(std::string& output, const LogFilter& filter) {
-    auto logs = readLogs(filter);
-    
-    output = "{\n  \"logs\": [\n";
-    
-    for (size_t i = 0; i < logs.size(); i++) {
-        const auto& entry = logs[i];
-        
-        char jsonEntry[512];
-        snprintf(jsonEntry, sizeof(jsonEntry),
-            "    {\n"
-            "      \"timestamp\": %lu,\n"
-            "      \"level\": %u,\n"
-            "      \"module\": %u,\n"
-            "      \"event\": %u,\n"
-            "      \"value\": %ld,\n"
-            "      \"message\": \"%s\"\n"
-            "    }%s\n",
-            entry.timestamp,
-            entry.level,
-            entry.moduleId,
-            entry.eventCode,
-            entry.value,
-            entry.message,
-            (i < logs.size() - 1) ? "," : ""
-        );
-        
-        output += jsonEntry;
-    }
-    
-    output += "  ]\n}";
-    return true;
-}
-
-size_t LogStorage::getUsedSpace() {
+size_t FileLogStorage::getUsedSpace() {
     size_t total = 0;
     
     // Поточний файл
@@ -373,29 +597,29 @@ size_t LogStorage::getUsedSpace() {
     return total;
 }
 
-size_t LogStorage::getTotalSpace() {
+size_t FileLogStorage::getTotalSpace() {
     return m_config.maxTotalSize;
 }
 
 // Приватні методи
 
-std::string LogStorage::getCurrentLogPath() {
+std::string FileLogStorage::getCurrentLogPath() {
     return CURRENT_LOG;
 }
 
-std::string LogStorage::getArchiveLogPath(int index) {
+std::string FileLogStorage::getArchiveLogPath(int index) {
     return std::string(ARCHIVE_PREFIX) + std::to_string(index) + ".log";
 }
 
-std::string LogStorage::getCriticalLogPath() {
+std::string FileLogStorage::getCriticalLogPath() {
     return CRITICAL_LOG;
 }
 
-bool LogStorage::checkRotationNeeded() {
+bool FileLogStorage::checkRotationNeeded() {
     return m_currentFileSize >= m_config.maxFileSize;
 }
 
-void LogStorage::performRotation() {
+void FileLogStorage::performRotation() {
     ESP_LOGI(TAG, "Performing log rotation");
     
     // Закриваємо поточний файл
@@ -413,6 +637,7 @@ void LogStorage::performRotation() {
     
     // Переміщуємо поточний в архів
     renameFile(CURRENT_LOG, getArchiveLogPath(1));
+    m_generation++;
     
     // Створюємо новий поточний файл
     m_currentFile = openLogFile(CURRENT_LOG, "wb");
@@ -422,7 +647,7 @@ void LogStorage::performRotation() {
     enforceQuota();
 }
 
-void LogStorage::enforceQuota() {
+void FileLogStorage::enforceQuota() {
     size_t usedSpace = getUsedSpace();
     
     if (usedSpace <= m_config.maxTotalSize) {
@@ -443,7 +668,7 @@ void LogStorage::enforceQuota() {
     }
 }
 
-size_t LogStorage::getFileSize(const std::string& path) {
+size_t FileLogStorage::getFileSize(const std::string& path) {
     struct stat st;
     if (stat(path.c_str(), &st) == 0) {
         return st.st_size;
@@ -451,7 +676,7 @@ size_t LogStorage::getFileSize(const std::string& path) {
     return 0;
 }
 
-bool LogStorage::deleteFile(const std::string& path) {
+bool FileLogStorage::deleteFile(const std::string& path) {
     if (unlink(path.c_str()) == 0) {
         ESP_LOGD(TAG, "Deleted file: %s", path.c_str());
         return true;
@@ -459,7 +684,7 @@ bool LogStorage::deleteFile(const std::string& path) {
     return false;
 }
 
-bool LogStorage::renameFile(const std::string& from, const std::string& to) {
+bool FileLogStorage::renameFile(const std::string& from, const std::string& to) {
     if (rename(from.c_str(), to.c_str()) == 0) {
         ESP_LOGD(TAG, "Renamed: %s -> %s", from.c_str(), to.c_str());
         return true;
@@ -467,7 +692,7 @@ bool LogStorage::renameFile(const std::string& from, const std::string& to) {
     return false;
 }
 
-FILE* LogStorage::openLogFile(const std::string& path, const char* mode) {
+FILE* FileLogStorage::openLogFile(const std::string& path, const char* mode) {
     FILE* file = fopen(path.c_str(), mode);
     if (!file) {
         ESP_LOGD(TAG, "Failed to open file: %s", path.c_str());
@@ -475,7 +700,7 @@ FILE* LogStorage::openLogFile(const std::string& path, const char* mode) {
     return file;
 }
 
-void LogStorage::closeLogFile(FILE* file) {
+void FileLogStorage::closeLogFile(FILE* file) {
     if (file) {
         fclose(file);
     }
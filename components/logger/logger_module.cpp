@@ -1,22 +1,52 @@
 #include "logger_module.h"
+#include "log_exporter.h"
 #include "shared_state.h"
 #include "event_bus.h"
+#include "json_rpc_interface.h"
 #include <esp_log.h>
 #include <esp_timer.h>
+#include <esp_cpu.h>
 #include <cstdarg>
 #include <cstring>
+#include <cstdlib>
+#include <algorithm>
+#include <ctime>
 
 static const char* TAG = "LoggerModule";
 
 namespace ModESP {
 
+ILogger* g_logger = nullptr;
+std::array<uint8_t, LOG_MAX_MODULES> g_logLevelMask = log_default_masks();
+
+static const char* levelName(LogLevel level) {
+    switch (level) {
+        case LogLevel::DEBUG: return "DEBUG";
+        case LogLevel::INFO: return "INFO";
+        case LogLevel::WARNING: return "WARNING";
+        case LogLevel::ERROR: return "ERROR";
+        case LogLevel::CRITICAL: return "CRITICAL";
+        default: return "NONE";
+    }
+}
+
 LoggerModule::LoggerModule() 
     : m_ramBuffer(RAM_BUFFER_SIZE)
+    , m_router(*this, onRoutedEvent, this)
     , m_writeQueue(nullptr)
     , m_writerTaskHandle(nullptr)
-    , m_nextModuleId(1)
+    , m_nextModuleId(static_cast<uint8_t>(LogModule::DYNAMIC_START))
     , m_initialized(false)
     , m_running(false) {
+    memset(m_moduleNames, 0, sizeof(m_moduleNames));
+    
+    // Стандартні модулі мають фіксовані id (LogModule)
+    static const char* const standard[] = {
+        "OTHER", "SYSTEM", "SENSOR", "ACTUATOR", "DEFROST", "COMPRESSOR", "UI", "NETWORK"
+    };
+    for (size_t id = 0; id < sizeof(standard) / sizeof(standard[0]); id++) {
+        strncpy(m_moduleNames[id], standard[id], MODULE_NAME_LEN - 1);
+    }
 }
 
 LoggerModule::~LoggerModule() {
@@ -27,12 +57,20 @@ void LoggerModule::configure(const nlohmann::json& config) {
     if (!config.empty()) {
         m_config.enabled = config.value("enabled", true);
         
-        std::string level = config.value("level", "INFO");
-        m_config.defaultLevel = 
-            level == "DEBUG" ? LogLevel::DEBUG :
-            level == "INFO" ? LogLevel::INFO :
-            level == "WARNING" ? LogLevel::WARNING :
-            level == "ERROR" ? LogLevel::ERROR : LogLevel::CRITICAL;
+        m_config.defaultLevel = log_level_from_name(config.value("level", "INFO"));
+        for (auto& mask : g_logLevelMask) {
+            mask = log_level_mask(m_config.defaultLevel);
+        }
+        
+        // Рівні окремих модулів
+        if (config.contains("modules") && config["modules"].is_object()) {
+            for (const auto& item : config["modules"].items()) {
+                if (item.value().is_string()) {
+                    setModuleLevel(internModule(item.key().c_str()),
+                                   log_level_from_name(item.value().get<std::string>()));
+                }
+            }
+        }
             
         if (config.contains("storage")) {
             auto storage = config["storage"];
@@ -40,6 +78,28 @@ void LoggerModule::configure(const nlohmann::json& config) {
             m_config.maxTotalSize = storage.value("maxTotalSize", 10*1024*1024);
             m_config.maxArchiveFiles = storage.value("maxArchiveFiles", 5);
             m_config.flushInterval = storage.value("flushInterval", 5000);
+            
+            m_config.syncLevel = log_level_from_name(storage.value("syncLevel", "ERROR"));
+            m_config.backend = storage.value("backend", "littlefs") == "partition" ?
+                LogBackend::PARTITION : LogBackend::LITTLEFS;
+            m_config.partitionLabel = storage.value("partition", "logs");
+        }
+        
+        // Правила маршрутизації подій компілюються тут, а не на кожну подію
+        m_router.compile(config.contains("routes") ? config["routes"] : nlohmann::json());
+        
+        if (config.contains("haccp") && config["haccp"].is_object()) {
+            m_haccpConfig = config["haccp"];
+            m_config.haccp = m_haccpConfig.value("enabled", true);
+            
+            m_haccpRoles.clear();
+            if (m_haccpConfig.contains("roles") && m_haccpConfig["roles"].is_array()) {
+                for (const auto& role : m_haccpConfig["roles"]) {
+                    if (role.is_string()) {
+                        m_haccpRoles.push_back(role.get<std::string>());
+                    }
+                }
+            }
         }
     }
 }
@@ -60,27 +120,39 @@ esp_err_t LoggerModule::init() {
     }
     
     // Ініціалізуємо сховище
-    m_storage = std::make_unique<LogStorage>(m_config);
+    m_storage = LogStorage::create(m_config);
     esp_err_t ret = m_storage->init();
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "Failed to initialize storage: %s", esp_err_to_name(ret));
         return ret;
     }
     
-    // Реєструємо стандартні модулі
-    m_moduleMap["SYSTEM"] = m_nextModuleId++;
-    m_moduleMap["SENSOR"] = m_nextModuleId++;
-    m_moduleMap["ACTUATOR"] = m_nextModuleId++;
-    m_moduleMap["DEFROST"] = m_nextModuleId++;
-    m_moduleMap["COMPRESSOR"] = m_nextModuleId++;
-    m_moduleMap["UI"] = m_nextModuleId++;
-    m_moduleMap["NETWORK"] = m_nextModuleId++;
+    // HACCP агрегати - помилка не блокує логування
+    if (m_config.haccp) {
+        m_rollup = std::make_unique<HaccpRollup>(ROLLUP_PATH);
+        if (m_rollup->init() == ESP_OK) {
+            m_rollup->setDefaultThreshold(m_haccpConfig.value("threshold", 8.0f));
+            m_rollup->setCheckpointInterval(m_haccpConfig.value("checkpointInterval", 600));
+            if (m_haccpConfig.contains("thresholds") && m_haccpConfig["thresholds"].is_object()) {
+                for (const auto& item : m_haccpConfig["thresholds"].items()) {
+                    if (item.value().is_number()) {
+                        m_rollup->setThreshold(item.key(), item.value().get<float>());
+                    }
+                }
+            }
+            m_rollup->setDayClosedCallback(onHaccpDayClosed, this);
+        } else {
+            ESP_LOGW(TAG, "HACCP rollups disabled: store init failed");
+            m_rollup.reset();
+        }
+    }
     
     // Ініціалізуємо статистику
     m_stats = {};
     
     m_initialized = true;
     m_running = true;  // Встановлюємо перед створенням задачі
+    g_logger = this;
     
     // Створюємо задачу для асинхронного запису
     BaseType_t task_ret = xTaskCreate(
@@ -117,6 +189,10 @@ void LoggerModule::stop() {
     
     // Зупиняємо робочу задачу
     m_running = false;
+    m_router.unsubscribe();
+    if (g_logger == this) {
+        g_logger = nullptr;
+    }
     
     // Відправляємо стоп-сигнал
     if (m_writerTaskHandle) {
@@ -141,18 +217,22 @@ void LoggerModule::stop() {
 }
 
 void LoggerModule::logFormatted(LogLevel level, const char* module, const char* message) {
+    logMessage(level, internModule(module), message);
+}
+
+void LoggerModule::logMessage(LogLevel level, uint8_t moduleId, const char* message) {
     if (!m_initialized || !m_config.enabled) {
         return;
     }
     
-    if (level < m_config.defaultLevel) {
+    if (!mlog_enabled(level, moduleId)) {
         return;
     }
     
     LogEntry entry = {};
     entry.timestamp = esp_timer_get_time() / 1000;
     entry.level = static_cast<uint8_t>(level);
-    entry.moduleId = getModuleId(module);
+    entry.moduleId = moduleId;
     
     // Копіюємо повідомлення
     strncpy(entry.message, message, sizeof(entry.message) - 1);
@@ -162,7 +242,7 @@ void LoggerModule::logFormatted(LogLevel level, const char* module, const char*
     
     // Оновлюємо статистику
     m_stats.totalLogs++;
-    m_stats.levelCounts[level]++;
+    m_stats.levelCounts[static_cast<uint8_t>(level)]++;
     
     // Відправляємо в чергу запису
     if (m_writeQueue) {
@@ -171,6 +251,11 @@ void LoggerModule::logFormatted(LogLevel level, const char* module, const char*
 }
 
 void LoggerModule::log(LogLevel level, const char* module, const char* fmt, ...) {
+    uint8_t moduleId = internModule(module);
+    if (!mlog_enabled(level, moduleId)) {
+        return;
+    }
+    
     // Форматуємо повідомлення
     char buffer[128];
     va_list args;
@@ -179,18 +264,23 @@ void LoggerModule::log(LogLevel level, const char* module, const char* fmt, ...)
     va_end(args);
     
     // Викликаємо основну функцію
-    logFormatted(level, module, buffer);
+    logMessage(level, moduleId, buffer);
 }
 
 void LoggerModule::logEvent(EventCode code, int32_t value, const char* message) {
+    logEventAt(LogLevel::INFO, static_cast<uint8_t>(LogModule::SYSTEM), code, value, message);
+}
+
+void LoggerModule::logEventAt(LogLevel level, uint8_t moduleId, EventCode code,
+                              int32_t value, const char* message) {
     if (!m_initialized || !m_config.enabled) {
         return;
     }
     
     LogEntry entry = {};
     entry.timestamp = esp_timer_get_time() / 1000;
-    entry.level = static_cast<uint8_t>(LogLevel::INFO);
-    entry.moduleId = getModuleId("SYSTEM");
+    entry.level = static_cast<uint8_t>(level);
+    entry.moduleId = moduleId;
     entry.eventCode = static_cast<uint16_t>(code);
     entry.value = value;
     
@@ -278,19 +368,7 @@ std::vector<LogEntry> LoggerModule::readLogs(const LogFilter& filter) {
     auto ramLogs = m_ramBuffer.getAll();
     for (const auto& entry : ramLogs) {
         // Застосовуємо фільтр
-        if (static_cast<LogLevel>(entry.level) < filter.minLevel) continue;
-        if (filter.startTime > 0 && entry.timestamp < filter.startTime) continue;
-        if (filter.endTime > 0 && entry.timestamp > filter.endTime) continue;
-        
-        if (!filter.moduleIds.empty()) {
-            if (std::find(filter.moduleIds.begin(), filter.moduleIds.end(),
-                entry.moduleId) == filter.moduleIds.end()) continue;
-        }
-        
-        if (!filter.eventCodes.empty()) {
-            if (std::find(filter.eventCodes.begin(), filter.eventCodes.end(),
-                entry.eventCode) == filter.eventCodes.end()) continue;
-        }
+        if (!filter.matches(entry)) continue;
         
         result.push_back(entry);
         
@@ -319,15 +397,86 @@ bool LoggerModule::exportLogs(const std::string& format, std::string& output) {
         return false;
     }
     
+    ExportFormat exportFormat;
+    if (!LogExporter::parseFormat(format.c_str(), exportFormat)) {
+        return false;
+    }
+    
     LogFilter filter; // Без фільтрації
+    output.clear();
+    
+    auto exporter = std::make_unique<LogExporter>(*m_storage, exportFormat, filter);
+    esp_err_t ret = exporter->run([&output](const char* data, size_t len) {
+        output.append(data, len);
+        return ESP_OK;
+    });
+    
+    return ret == ESP_OK;
+}
+
+esp_err_t LoggerModule::registerHttpHandlers(httpd_handle_t server) {
+    httpd_uri_t export_uri = {
+        .uri = "/api/logs/export",
+        .method = HTTP_GET,
+        .handler = handleHttpExport,
+        .user_ctx = this
+    };
+    return httpd_register_uri_handler(server, &export_uri);
+}
+
+esp_err_t LoggerModule::handleHttpExport(httpd_req_t* req) {
+    auto* self = static_cast<LoggerModule*>(req->user_ctx);
+    if (!self || !self->m_storage) {
+        return httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "Log storage unavailable");
+    }
     
-    if (format == "csv") {
-        return m_storage->exportToCSV(output, filter);
-    } else if (format == "json") {
-        return m_storage->exportToJSON(output, filter);
+    // Параметри: format=csv|json|bin, cursor=<token>, limit=N, from=T, to=T, level=L
+    char query[128] = {};
+    char value[LogCursor::TOKEN_SIZE] = {};
+    ExportFormat format = ExportFormat::CSV;
+    LogCursor cursor;
+    LogFilter filter;
+    uint32_t limit = 0;
+    
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK) {
+        if (httpd_query_key_value(query, "format", value, sizeof(value)) == ESP_OK &&
+            !LogExporter::parseFormat(value, format)) {
+            return httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Unknown format");
+        }
+        if (httpd_query_key_value(query, "cursor", value, sizeof(value)) == ESP_OK &&
+            !cursor.fromToken(value)) {
+            return httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Invalid cursor");
+        }
+        if (httpd_query_key_value(query, "limit", value, sizeof(value)) == ESP_OK) {
+            limit = strtoul(value, nullptr, 10);
+        }
+        if (httpd_query_key_value(query, "from", value, sizeof(value)) == ESP_OK) {
+            filter.startTime = strtoul(value, nullptr, 10);
+        }
+        if (httpd_query_key_value(query, "to", value, sizeof(value)) == ESP_OK) {
+            filter.endTime = strtoul(value, nullptr, 10);
+        }
+        if (httpd_query_key_value(query, "level", value, sizeof(value)) == ESP_OK) {
+            filter.minLevel = static_cast<LogLevel>(std::min<unsigned long>(
+                strtoul(value, nullptr, 10), static_cast<unsigned long>(LogLevel::CRITICAL)));
+        }
     }
     
-    return false;
+    httpd_resp_set_type(req, LogExporter::contentType(format));
+    
+    // Експортер тримає буфер фрагмента та пакет записів - не на стеку httpd
+    auto exporter = std::make_unique<LogExporter>(*self->m_storage, format, filter, cursor);
+    esp_err_t ret = exporter->run([req](const char* data, size_t len) {
+        return httpd_resp_send_chunk(req, data, len);
+    }, limit);
+    
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "HTTP log export failed: %s", esp_err_to_name(ret));
+        return ret;
+    }
+    
+    // Завершуємо chunked відповідь
+    return httpd_resp_send_chunk(req, nullptr, 0);
 }
 
 size_t LoggerModule::getUsedSpace() {
@@ -350,6 +499,8 @@ void LoggerModule::getStatistics(std::string& stats) {
         "Warnings: %lu\n"
         "Errors: %lu\n"
         "Rotations: %lu\n"
+        "Dropped logs: %lu\n"
+        "Failed commits: %lu\n"
         "RAM buffer: %zu/%zu\n"
         "Level counts:\n"
         "  DEBUG: %lu\n"
@@ -362,44 +513,235 @@ void LoggerModule::getStatistics(std::string& stats) {
         m_stats.warnings,
         m_stats.errors,
         m_stats.rotations,
+        m_stats.droppedLogs,
+        m_stats.failedCommits,
         m_ramBuffer.size(), RAM_BUFFER_SIZE,
-        m_stats.levelCounts[LogLevel::DEBUG],
-        m_stats.levelCounts[LogLevel::INFO],
-        m_stats.levelCounts[LogLevel::WARNING],
-        m_stats.levelCounts[LogLevel::ERROR],
-        m_stats.levelCounts[LogLevel::CRITICAL]
+        m_stats.levelCounts[static_cast<uint8_t>(LogLevel::DEBUG)],
+        m_stats.levelCounts[static_cast<uint8_t>(LogLevel::INFO)],
+        m_stats.levelCounts[static_cast<uint8_t>(LogLevel::WARNING)],
+        m_stats.levelCounts[static_cast<uint8_t>(LogLevel::ERROR)],
+        m_stats.levelCounts[static_cast<uint8_t>(LogLevel::CRITICAL)]
     );
     
     stats = buffer;
 }
 
-uint8_t LoggerModule::getModuleId(const char* moduleName) {
-    std::string name(moduleName);
+uint8_t LoggerModule::internModule(const char* moduleName) {
+    if (!moduleName) {
+        return static_cast<uint8_t>(LogModule::OTHER);
+    }
+    
+    std::lock_guard<std::mutex> lock(m_moduleMutex);
+    
+    for (size_t id = 1; id < m_nextModuleId; id++) {
+        if (strncmp(m_moduleNames[id], moduleName, MODULE_NAME_LEN - 1) == 0) {
+            return id;
+        }
+    }
     
-    auto it = m_moduleMap.find(name);
-    if (it != m_moduleMap.end()) {
-        return it->second;
+    // Таблиця заповнена - модуль ділить маску з OTHER
+    if (m_nextModuleId >= LOG_MAX_MODULES) {
+        return static_cast<uint8_t>(LogModule::OTHER);
     }
     
     // Новий модуль - додаємо
     uint8_t id = m_nextModuleId++;
-    m_moduleMap[name] = id;
+    strncpy(m_moduleNames[id], moduleName, MODULE_NAME_LEN - 1);
     return id;
 }
 
+void LoggerModule::setModuleLevel(uint8_t moduleId, LogLevel level) {
+    if (moduleId < LOG_MAX_MODULES) {
+        g_logLevelMask[moduleId] = log_level_mask(level);
+    }
+}
+
 void LoggerModule::setupEventSubscriptions() {
-    // Підписуємось на температурні аларми
-    EventBus::subscribe("sensor.temperature.alarm", [this](const EventBus::Event& e) {
-        float temp = e.data.value("temperature", 0.0f);
-        logHACCPEvent(EventCode::HACCP_TEMP_VIOLATION, temp);
-    });
+    // Події з таблиці правил (logging.json "routes" або вбудовані)
+    if (!m_router.isCompiled()) {
+        m_router.compile(nlohmann::json());
+    }
+    m_router.subscribe();
+    
+    // Інкрементальні HACCP агрегати
+    if (m_rollup) {
+        EventBus::subscribe("sensor.reading", [this](const EventBus::Event& e) {
+            const auto& reading = e.data.value("reading", nlohmann::json::object());
+            if (!reading.value("is_valid", false)) {
+                return;
+            }
+            
+            // Лише температурні ролі: двері, тиск, rpm тощо не займають
+            // MAX_SENSORS слотів агрегатів
+            std::string role = e.data.value("role", "");
+            if (m_haccpRoles.empty()) {
+                if (reading.value("unit", "") != "°C") {
+                    return;
+                }
+            } else if (std::find(m_haccpRoles.begin(), m_haccpRoles.end(), role) == m_haccpRoles.end()) {
+                return;
+            }
+            
+            m_rollup->ingest(role, reading.value("value", 0.0f),
+                             static_cast<uint32_t>(time(nullptr)));
+        });
+    }
+}
+
+void LoggerModule::onRoutedEvent(void* ctx, const LogEventRouter::Route& route, int32_t value) {
+    auto* self = static_cast<LoggerModule*>(ctx);
+    self->logEventAt(route.level, route.moduleId, route.code, value,
+                     route.message[0] ? route.message : nullptr);
+}
+
+void LoggerModule::onHaccpDayClosed(void* ctx, const char* role, const RollupBucket& day) {
+    auto* self = static_cast<LoggerModule*>(ctx);
     
-    // Підписуємось на стан компресора
-    EventBus::subscribe("actuator.compressor.state", [this](const EventBus::Event& e) {
-        bool on = e.data.value("on", false);
-        uint32_t runtime = e.data.value("runtime", 0);
-        logCompressorCycle(on, runtime);
-    });
+    // Щоденний HACCP звіт: value = секунди вище порогу
+    char msg[32];
+    snprintf(msg, sizeof(msg), "%.10s %.1f/%.1f/%.1f", role,
+             day.minValue / 100.0f, day.mean() / 100.0f, day.maxValue / 100.0f);
+    self->logEvent(EventCode::HACCP_REPORT, static_cast<int32_t>(day.secondsAbove), msg);
+}
+
+void LoggerModule::register_rpc(IJsonRpcRegistrar& rpc) {
+    rpc.register_method("logger.haccp_rollup",
+        [this](const nlohmann::json& params, nlohmann::json& result) -> esp_err_t {
+            if (!m_rollup) {
+                return ESP_ERR_INVALID_STATE;
+            }
+            
+            std::string role = params.value("role", "");
+            auto period = params.value("period", "day") == "hour" ?
+                HaccpRollup::Period::HOUR : HaccpRollup::Period::DAY;
+            uint32_t now = static_cast<uint32_t>(time(nullptr));
+            uint32_t to = params.value("to", now);
+            uint32_t from = params.value("from", to - 7 * HaccpRollup::DAY);
+            
+            result["role"] = role;
+            result["buckets"] = nlohmann::json::array();
+            for (const auto& bucket : m_rollup->query(role, period, from, to)) {
+                result["buckets"].push_back({
+                    {"start", bucket.periodStart},
+                    {"min", bucket.minValue / 100.0f},
+                    {"max", bucket.maxValue / 100.0f},
+                    {"mean", bucket.mean() / 100.0f},
+                    {"samples", bucket.sampleCount},
+                    {"seconds_above", bucket.secondsAbove},
+                    {"seconds_covered", bucket.secondsCovered}
+                });
+            }
+            return ESP_OK;
+        },
+        "HACCP hourly/daily aggregates: {role, period: hour|day, from, to}");
+    
+    rpc.register_method("logger.set_level",
+        [this](const nlohmann::json& params, nlohmann::json& result) -> esp_err_t {
+            if (!params.contains("level") || !params["level"].is_string()) {
+                return ESP_ERR_INVALID_ARG;
+            }
+            LogLevel level = log_level_from_name(params["level"].get<std::string>());
+            
+            if (params.contains("module") && params["module"].is_string()) {
+                std::string module = params["module"];
+                uint8_t id = internModule(module.c_str());
+                setModuleLevel(id, level);
+                result["module"] = module;
+                result["module_id"] = id;
+            } else {
+                for (uint8_t id = 0; id < LOG_MAX_MODULES; id++) {
+                    setModuleLevel(id, level);
+                }
+                m_config.defaultLevel = level;
+            }
+            result["level"] = levelName(level);
+            return ESP_OK;
+        },
+        "Set runtime log level: {module?, level}");
+    
+    rpc.register_method("logger.get_levels",
+        [this](const nlohmann::json& params, nlohmann::json& result) -> esp_err_t {
+            std::lock_guard<std::mutex> lock(m_moduleMutex);
+            result["default"] = levelName(m_config.defaultLevel);
+            result["modules"] = nlohmann::json::object();
+            for (uint8_t id = 0; id < m_nextModuleId; id++) {
+                // Найнижчий дозволений рівень за маскою
+                LogLevel level = LogLevel::NONE;
+                for (uint8_t l = 0; l < static_cast<uint8_t>(LogLevel::NONE); l++) {
+                    if (g_logLevelMask[id] & (1u << l)) {
+                        level = static_cast<LogLevel>(l);
+                        break;
+                    }
+                }
+                result["modules"][m_moduleNames[id]] = levelName(level);
+            }
+            return ESP_OK;
+        },
+        "Get runtime log levels per module");
+    
+    rpc.register_method("logger.routes",
+        [this](const nlohmann::json& params, nlohmann::json& result) -> esp_err_t {
+            result["routes"] = nlohmann::json::array();
+            for (const auto& route : m_router.routes()) {
+                result["routes"].push_back({
+                    {"event", route.pattern},
+                    {"code", static_cast<uint16_t>(route.code)},
+                    {"level", levelName(route.level)},
+                    {"sample", route.sampleEvery},
+                    {"seen", route.seen},
+                    {"logged", route.logged},
+                    {"missing", route.missing}
+                });
+            }
+            return ESP_OK;
+        },
+        "Event-to-log routing table with per-route counters");
+    
+    rpc.register_method("logger.filter_cost",
+        [this](const nlohmann::json& params, nlohmann::json& result) -> esp_err_t {
+            const uint32_t iterations = params.value("iterations", 1000u);
+            if (iterations == 0 || iterations > 100000) {
+                return ESP_ERR_INVALID_ARG;
+            }
+            
+            // Вимірюємо на вимкненому рівні, щоб не засмічувати лог
+            uint8_t id = static_cast<uint8_t>(LogModule::OTHER);
+            uint8_t savedMask = g_logLevelMask[id];
+            g_logLevelMask[id] = log_level_mask(LogLevel::NONE);
+            
+            int value = 42;
+            uint32_t start = esp_cpu_get_cycle_count();
+            for (uint32_t i = 0; i < iterations; i++) {
+                if (mlog_enabled(LogLevel::INFO, id)) {
+                    log_formatted_id(this, LogLevel::INFO, id, "filter cost %d %s", value, "probe");
+                }
+            }
+            uint32_t filtered = esp_cpu_get_cycle_count() - start;
+            
+            // Попередній шлях: форматування, потім відкидання рівнем
+            start = esp_cpu_get_cycle_count();
+            for (uint32_t i = 0; i < iterations; i++) {
+                char buffer[128];
+                snprintf(buffer, sizeof(buffer), "filter cost %d %s", value, "probe");
+                logMessage(LogLevel::INFO, id, buffer);
+            }
+            uint32_t formatted = esp_cpu_get_cycle_count() - start;
+            
+            g_logLevelMask[id] = savedMask;
+            
+            result["iterations"] = iterations;
+            result["cycles_per_call_filtered"] = filtered / iterations;
+            result["cycles_per_call_format_then_drop"] = formatted / iterations;
+            return ESP_OK;
+        },
+        "Measure CPU cycles per suppressed log call: {iterations}");
+    
+    rpc.register_method("logger.haccp_roles",
+        [this](const nlohmann::json& params, nlohmann::json& result) -> esp_err_t {
+            result = m_rollup ? nlohmann::json(m_rollup->getRoles()) : nlohmann::json::array();
+            return ESP_OK;
+        },
+        "Roles with HACCP aggregates");
 }
 
 void LoggerModule::writerTaskWrapper(void* param) {
@@ -410,38 +752,42 @@ void LoggerModule::writerTask() {
     ESP_LOGI(TAG, "Writer task started");
     
     LogEntry entry;
-    std::vector<LogEntry> batch;
-    batch.reserve(10);
+    bool stopRequested = false;
     
-    TickType_t lastFlush = xTaskGetTickCount();
-    
-    while (m_running) {
-        // Очікуємо дані
+    while (m_running && !stopRequested) {
+        // Очікуємо дані, потім забираємо все що накопичилось (group commit)
         if (xQueueReceive(m_writeQueue, &entry, pdMS_TO_TICKS(100)) == pdTRUE) {
-            // Перевіряємо стоп-сигнал
-            if (entry.level == static_cast<uint8_t>(LogLevel::NONE)) {
-                break;
-            }
-            
-            batch.push_back(entry);
+            bool syncNeeded = false;
             
-            // Записуємо пакетами
-            if (batch.size() >= 10) {
-                if (m_storage) {
-                    m_storage->writeEntries(batch);
+            do {
+                // Перевіряємо стоп-сигнал
+                if (entry.level == static_cast<uint8_t>(LogLevel::NONE)) {
+                    stopRequested = true;
+                    break;
                 }
-                batch.clear();
+                
+                if (m_storage && m_storage->append(entry) == ESP_ERR_NO_MEM) {
+                    m_stats.droppedLogs++;
+                }
+                syncNeeded |= static_cast<LogLevel>(entry.level) >= m_config.syncLevel;
+            } while (xQueueReceive(m_writeQueue, &entry, 0) == pdTRUE);
+            
+            // Критичні записи - один commit + fsync на всю пачку
+            if (syncNeeded && m_storage && m_storage->commit() != ESP_OK) {
+                m_stats.failedCommits++;
             }
         }
         
-        // Періодичний запис
-        if (batch.size() > 0 &&
-            (xTaskGetTickCount() - lastFlush) > pdMS_TO_TICKS(m_config.flushInterval)) {
-            if (m_storage) {
-                m_storage->writeEntries(batch);
-            }
-            batch.clear();
-            lastFlush = xTaskGetTickCount();
+        // Решта записів фіксується не пізніше ніж через flushInterval
+        if (m_storage && m_storage->hasPending() &&
+            m_storage->pendingAgeMs() >= m_config.flushInterval &&
+            m_storage->commit() != ESP_OK) {
+            m_stats.failedCommits++;
+        }
+        
+        // Скидаємо змінені HACCP агрегати
+        if (m_rollup) {
+            m_rollup->persist();
         }
         
         // Перевіряємо ротацію
@@ -449,8 +795,12 @@ void LoggerModule::writerTask() {
     }
     
     // Записуємо залишки
-    if (!batch.empty() && m_storage) {
-        m_storage->writeEntries(batch);
+    if (m_storage && m_storage->commit() != ESP_OK) {
+        m_stats.failedCommits++;
+        ESP_LOGE(TAG, "Unsaved log block lost on shutdown");
+    }
+    if (m_rollup) {
+        m_rollup->persist();
     }
     
     ESP_LOGI(TAG, "Writer task stopped");
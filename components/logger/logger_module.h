@@ -4,12 +4,16 @@
 #include "logger_interface.h"
 #include "ring_buffer.h"
 #include "log_storage.h"
+#include "haccp_rollup.h"
+#include "log_event_router.h"
 #include "event_bus.h"
+#include <esp_http_server.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
 #include <freertos/queue.h>
 #include <memory>
 #include <map>
+#include <mutex>
 
 namespace ModESP {
 
@@ -21,7 +25,7 @@ namespace ModESP {
  * - Кільцевого буфера в RAM для швидкого доступу
  * - Асинхронного запису для мінімального впливу на систему
  * - Автоматичної ротації файлів
- * - HACCP сумісності
+ * - HACCP сумісності (погодинні/подобові агрегати, див. HaccpRollup)
  */
 class LoggerModule : public BaseModule, public ILogger {
 public:
@@ -34,9 +38,12 @@ public:
     void update() override {} // Logger doesn't need periodic updates
     void stop() override;
     void configure(const nlohmann::json& config) override;
+    void register_rpc(IJsonRpcRegistrar& rpc) override;
         
     // ILogger interface
     void logFormatted(LogLevel level, const char* module, const char* message) override;
+    void logMessage(LogLevel level, uint8_t moduleId, const char* message) override;
+    uint8_t internModule(const char* moduleName) override;
     void log(LogLevel level, const char* module, const char* fmt, ...);  // Non-virtual helper
     void logEvent(EventCode code, int32_t value = 0, const char* message = nullptr) override;
     
@@ -54,13 +61,24 @@ public:
     size_t getTotalSpace() override;
     void getStatistics(std::string& stats) override;
     
+    /**
+     * @brief Зареєструвати HTTP ендпоінт потокового експорту
+     * 
+     * GET /api/logs/export?format=csv|json|bin&cursor=<token>&limit=N&from=T&to=T&level=L
+     * Відповідь передається chunked фрагментами фіксованого розміру.
+     */
+    esp_err_t registerHttpHandlers(httpd_handle_t server);
+    
 private:
     // Внутрішні методи
     void writerTask();
     void processLogEntry(const LogEntry& entry);
     void checkRotation();
-    uint8_t getModuleId(const char* moduleName);
+    void setModuleLevel(uint8_t moduleId, LogLevel level);
     void setupEventSubscriptions();
+    void logEventAt(LogLevel level, uint8_t moduleId, EventCode code, int32_t value, const char* message);
+    static void onRoutedEvent(void* ctx, const LogEventRouter::Route& route, int32_t value);
+    static void onHaccpDayClosed(void* ctx, const char* role, const RollupBucket& day);
     
     // Конфігурація
     LoggerConfig m_config;
@@ -70,6 +88,14 @@ private:
     // Зберігання логів
     std::unique_ptr<LogStorage> m_storage;
     
+    // Правила EventBus -> лог
+    LogEventRouter m_router;
+    
+    // HACCP агрегати
+    std::unique_ptr<HaccpRollup> m_rollup;
+    nlohmann::json m_haccpConfig;
+    std::vector<std::string> m_haccpRoles;  // Порожньо - всі сенсори в °C
+    
     // Асинхронний запис
     QueueHandle_t m_writeQueue;
     TaskHandle_t m_writerTaskHandle;
@@ -81,14 +107,17 @@ private:
         uint32_t warnings;
         uint32_t errors;
         uint32_t droppedLogs;
+        uint32_t failedCommits;
         uint32_t rotations;
-        std::map<LogLevel, uint32_t> levelCounts;
+        uint32_t levelCounts[static_cast<uint8_t>(LogLevel::NONE) + 1];
         std::map<uint16_t, uint32_t> eventCounts;
     } m_stats;
     
-    // Мапа модулів
-    std::map<std::string, uint8_t> m_moduleMap;
+    // Таблиця модулів: індекс = moduleId, маска рівнів у g_logLevelMask
+    static constexpr size_t MODULE_NAME_LEN = 16;
+    char m_moduleNames[LOG_MAX_MODULES][MODULE_NAME_LEN];
     uint8_t m_nextModuleId;
+    std::mutex m_moduleMutex;
     
     // Прапорці стану
     bool m_initialized;
@@ -99,9 +128,13 @@ private:
     static constexpr size_t WRITER_TASK_STACK = 4096;
     static constexpr uint8_t WRITER_TASK_PRIORITY = 2;
     static constexpr size_t RAM_BUFFER_SIZE = 256;
+    static constexpr const char* ROLLUP_PATH = "/storage/logs/haccp_rollup.dat";
     
     // Статична задача для FreeRTOS
     static void writerTaskWrapper(void* param);
+    
+    // HTTP обробник експорту
+    static esp_err_t handleHttpExport(httpd_req_t* req);
 };
 
 } // namespace ModESP
@@ -0,0 +1,443 @@
+#include "partition_log_storage.h"
+#include <esp_log.h>
+#include <esp_rom_crc.h>
+#include <algorithm>
+#include <cstring>
+#include <cstddef>
+
+static const char* TAG = "PartitionLog";
+
+namespace ModESP {
+
+PartitionLogStorage::PartitionLogStorage(const LoggerConfig& config,
+                                         std::unique_ptr<LogPartition> partition)
+    : LogStorage(config)
+    , m_partition(std::move(partition))
+    , m_sectorSize(0)
+    , m_sectorCount(0)
+    , m_blocksPerSector(0)
+    , m_head(0)
+    , m_headSeq(0)
+    , m_writeBlock(0)
+    , m_eraseAheadPending(false)
+    , m_ready(false) {
+}
+
+PartitionLogStorage::~PartitionLogStorage() {
+    deinit();
+}
+
+esp_err_t PartitionLogStorage::init() {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+    if (!m_partition) {
+        m_partition = EspLogPartition::open(m_config.partitionLabel.c_str());
+        if (!m_partition) {
+            return ESP_ERR_NOT_FOUND;
+        }
+    }
+
+    m_sectorSize = m_partition->sectorSize();
+    m_sectorCount = m_partition->size() / m_sectorSize;
+    if (m_sectorSize % LogBlock::SIZE != 0 || m_sectorSize < 2 * LogBlock::SIZE ||
+        m_sectorCount < MIN_SECTORS) {
+        ESP_LOGE(TAG, "Unsupported partition layout: %zu sectors of %zu bytes",
+                 m_sectorCount, m_sectorSize);
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    // Слот 0 сектору - заголовок, решта - блоки логів
+    m_blocksPerSector = m_sectorSize / LogBlock::SIZE - 1;
+    m_sectorSeq.assign(m_sectorCount, 0);
+    m_eraseCount.assign(m_sectorCount, 0);
+
+    // Знаходимо поточний сектор - з найбільшим номером
+    SectorHeader headHeader = {};
+    bool found = false;
+    for (size_t sector = 0; sector < m_sectorCount; sector++) {
+        SectorHeader header;
+        if (!readSectorHeader(sector, header)) {
+            continue;
+        }
+        m_sectorSeq[sector] = header.sequence;
+        m_eraseCount[sector] = header.eraseCount;
+        if (!found || header.sequence > headHeader.sequence) {
+            headHeader = header;
+            m_head = sector;
+            found = true;
+        }
+    }
+
+    if (!found) {
+        ESP_LOGW(TAG, "No valid log sectors, formatting partition");
+        esp_err_t ret = format();
+        if (ret != ESP_OK) {
+            return ret;
+        }
+    } else {
+        m_headSeq = headHeader.sequence;
+        scanHead(headHeader.firstBlock);
+
+        // Відновлюємо інваріант erase-ahead (живлення могло зникнути до або під час стирання)
+        size_t ahead = (m_head + 1) % m_sectorCount;
+        if (m_sectorSeq[ahead] != 0 || !isErased(ahead * m_sectorSize, m_sectorSize)) {
+            m_eraseCount[ahead] = std::max(m_eraseCount[ahead], m_eraseCount[m_head]);
+            esp_err_t ret = eraseSector(ahead);
+            if (ret != ESP_OK) {
+                return ret;
+            }
+        } else {
+            // Лічильник стертого сектору невідомий - сусід по кільцю має той самий знос
+            m_eraseCount[ahead] = m_eraseCount[m_head];
+        }
+    }
+
+    m_ready = true;
+
+    uint32_t maxErase = *std::max_element(m_eraseCount.begin(), m_eraseCount.end());
+    ESP_LOGI(TAG, "Ring log ready: %zu sectors x %zu blocks, head #%lu at sector %zu, "
+             "next block #%lu, max erase count %lu",
+             m_sectorCount, m_blocksPerSector, m_headSeq, m_head,
+             m_nextSequence, maxErase);
+    return ESP_OK;
+}
+
+esp_err_t PartitionLogStorage::deinit() {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+    if (m_ready) {
+        commit();
+        m_ready = false;
+    }
+    return ESP_OK;
+}
+
+esp_err_t PartitionLogStorage::writeBlock() {
+    if (!m_ready) {
+        return ESP_FAIL;
+    }
+
+    if (m_writeBlock >= m_blocksPerSector) {
+        esp_err_t ret = advanceSector();
+        if (ret != ESP_OK) {
+            return ret;
+        }
+    }
+
+    // Слот використано навіть при помилці - частково записаний слот не перезаписуємо
+    size_t offset = blockOffset(m_head, m_writeBlock++);
+    return m_partition->write(offset, &m_pending, LogBlock::SIZE);
+}
+
+void PartitionLogStorage::afterCommit() {
+    if (!m_eraseAheadPending) {
+        return;
+    }
+
+    // Стираємо наступний сектор після запису блоку, щоб не затримувати commit
+    m_eraseAheadPending = false;
+    size_t ahead = (m_head + 1) % m_sectorCount;
+    if (eraseSector(ahead) != ESP_OK) {
+        ESP_LOGE(TAG, "Erase-ahead of sector %zu failed", ahead);
+    }
+}
+
+esp_err_t PartitionLogStorage::advanceSector() {
+    // Інваріант: сектор після m_head вже стертий
+    size_t next = (m_head + 1) % m_sectorCount;
+    if (m_eraseAheadPending) {
+        // Попереднє стирання не відбулось (commit завершився помилкою)
+        m_eraseAheadPending = false;
+        esp_err_t ret = eraseSector(next);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+    }
+
+    esp_err_t ret = openSector(next, m_headSeq + 1);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    m_head = next;
+    m_headSeq++;
+    m_writeBlock = 0;
+    m_eraseAheadPending = true;
+    return ESP_OK;
+}
+
+esp_err_t PartitionLogStorage::openSector(size_t sector, uint32_t sequence) {
+    SectorHeader header = {};
+    header.magic = SECTOR_MAGIC;
+    header.version = SECTOR_VERSION;
+    header.blockSize = LogBlock::SIZE;
+    header.sequence = sequence;
+    header.firstBlock = m_nextSequence;
+    header.eraseCount = m_eraseCount[sector];
+    header.crc = headerCrc(header);
+
+    esp_err_t ret = m_partition->write(sector * m_sectorSize, &header, sizeof(header));
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to write header of sector %zu: %s", sector, esp_err_to_name(ret));
+        return ret;
+    }
+
+    m_sectorSeq[sector] = sequence;
+    return ESP_OK;
+}
+
+esp_err_t PartitionLogStorage::eraseSector(size_t sector) {
+    esp_err_t ret = m_partition->eraseSector(sector);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to erase sector %zu: %s", sector, esp_err_to_name(ret));
+        return ret;
+    }
+
+    m_sectorSeq[sector] = 0;
+    m_eraseCount[sector]++;
+    return ESP_OK;
+}
+
+esp_err_t PartitionLogStorage::format() {
+    // Стираємо лише сектори з даними - решта і так не мають валідного заголовка
+    for (size_t sector = 0; sector < m_sectorCount; sector++) {
+        if (m_sectorSeq[sector] != 0) {
+            esp_err_t ret = eraseSector(sector);
+            if (ret != ESP_OK) {
+                return ret;
+            }
+        }
+    }
+
+    // Новий номер більший за всі попередні - старі курсори стають недійсними
+    size_t head = m_head;
+    size_t ahead = (head + 1) % m_sectorCount;
+    if (!isErased(head * m_sectorSize, m_sectorSize) && eraseSector(head) != ESP_OK) {
+        return ESP_FAIL;
+    }
+    if (!isErased(ahead * m_sectorSize, m_sectorSize) && eraseSector(ahead) != ESP_OK) {
+        return ESP_FAIL;
+    }
+
+    esp_err_t ret = openSector(head, m_headSeq + 1);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    m_headSeq++;
+    m_writeBlock = 0;
+    m_eraseAheadPending = false;
+    return ESP_OK;
+}
+
+void PartitionLogStorage::scanHead(uint32_t firstBlock) {
+    m_nextSequence = firstBlock;
+    m_writeBlock = m_blocksPerSector;
+
+    for (size_t block = 0; block < m_blocksPerSector; block++) {
+        size_t offset = blockOffset(m_head, block);
+
+        LogBlock::Header header;
+        if (m_partition->read(offset, &header, sizeof(header)) != ESP_OK) {
+            continue;
+        }
+        if (header.magic == ERASED_WORD && isErased(offset, LogBlock::SIZE)) {
+            m_writeBlock = block;
+            break;
+        }
+
+        if (m_partition->read(offset, &m_scratch, LogBlock::SIZE) == ESP_OK && m_scratch.isValid()) {
+            m_nextSequence = std::max(m_nextSequence, m_scratch.header.sequence + 1);
+        } else {
+            // Недописаний блок - слот не використовується повторно
+            ESP_LOGW(TAG, "Skipping torn block %zu in sector %zu", block, m_head);
+        }
+    }
+}
+
+bool PartitionLogStorage::readSectorHeader(size_t sector, SectorHeader& header) {
+    if (m_partition->read(sector * m_sectorSize, &header, sizeof(header)) != ESP_OK) {
+        return false;
+    }
+    return header.magic == SECTOR_MAGIC &&
+           header.version == SECTOR_VERSION &&
+           header.blockSize == LogBlock::SIZE &&
+           header.sequence != 0 &&
+           header.crc == headerCrc(header);
+}
+
+size_t PartitionLogStorage::readBatch(LogCursor& cursor, const LogFilter& filter,
+                                      LogEntry* out, size_t maxCount) {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+    if (cursor.done || maxCount == 0) {
+        return 0;
+    }
+    if (!m_ready) {
+        cursor.done = true;
+        return 0;
+    }
+
+    size_t sector = 0;
+    if (!cursor.started || !locate(cursor.generation, sector)) {
+        if (cursor.started) {
+            ESP_LOGW(TAG, "Cursor sector #%lu overwritten, resuming from oldest", cursor.generation);
+        }
+        sector = oldestSector();
+        cursor.generation = m_sectorSeq[sector];
+        cursor.fileIndex = 0;
+        cursor.offset = 0;
+        cursor.started = true;
+    }
+
+    while (true) {
+        size_t blockIndex = cursor.offset / LogBlock::CAPACITY;
+        size_t entryIndex = cursor.offset % LogBlock::CAPACITY;
+        size_t limit = sector == m_head ? m_writeBlock : m_blocksPerSector;
+
+        // Сектор закривається лише повним, тому всі слоти до limit записані
+        if (blockIndex < limit) {
+            size_t matched = 0;
+            bool valid = m_partition->read(blockOffset(sector, blockIndex), &m_scratch,
+                                           LogBlock::SIZE) == ESP_OK &&
+                         m_scratch.isValid();
+
+            if (valid) {
+                size_t end = std::min<size_t>(m_scratch.header.count, entryIndex + maxCount);
+                for (size_t i = entryIndex; i < end; i++) {
+                    if (filter.matches(m_scratch.entries[i])) {
+                        out[matched++] = m_scratch.entries[i];
+                    }
+                }
+                entryIndex = end;
+            } else {
+                ESP_LOGW(TAG, "Skipping corrupted block %zu in sector %zu", blockIndex, sector);
+            }
+
+            // Неповний або пошкоджений блок - переходимо до наступного
+            if (!valid || entryIndex >= m_scratch.header.count) {
+                cursor.offset = (blockIndex + 1) * LogBlock::CAPACITY;
+            } else {
+                cursor.offset = blockIndex * LogBlock::CAPACITY + entryIndex;
+            }
+            return matched;
+        }
+
+        // Сектор вичерпано - переходимо до новішого
+        if (sector == m_head || !locate(cursor.generation + 1, sector)) {
+            cursor.done = true;
+            return 0;
+        }
+        cursor.generation++;
+        cursor.offset = 0;
+    }
+}
+
+size_t PartitionLogStorage::getLogCount() {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    size_t count = 0;
+
+    for (size_t sector = 0; sector < m_sectorCount; sector++) {
+        if (m_sectorSeq[sector] == 0) {
+            continue;
+        }
+
+        // Читаємо лише заголовки блоків
+        size_t limit = sector == m_head ? m_writeBlock : m_blocksPerSector;
+        for (size_t block = 0; block < limit; block++) {
+            LogBlock::Header header;
+            if (m_partition->read(blockOffset(sector, block), &header, sizeof(header)) == ESP_OK &&
+                header.magic == LogBlock::MAGIC && header.count <= LogBlock::CAPACITY) {
+                count += header.count;
+            }
+        }
+    }
+
+    return count + m_pending.header.count;
+}
+
+bool PartitionLogStorage::clearLogs() {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    ESP_LOGI(TAG, "Clearing ring log");
+
+    if (!m_ready) {
+        return false;
+    }
+
+    m_pending.reset();
+    return format() == ESP_OK;
+}
+
+size_t PartitionLogStorage::getUsedSpace() {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    size_t sectors = usedSectors();
+    if (sectors == 0) {
+        return 0;
+    }
+    // Закриті сектори повністю + заголовок і записані блоки поточного
+    return (sectors - 1) * m_sectorSize + (m_writeBlock + 1) * LogBlock::SIZE;
+}
+
+size_t PartitionLogStorage::getTotalSpace() {
+    // Один сектор завжди стертий наперед
+    return m_sectorCount > 0 ? (m_sectorCount - 1) * m_sectorSize : 0;
+}
+
+// Приватні методи
+
+bool PartitionLogStorage::isErased(size_t offset, size_t len) {
+    uint32_t words[32];
+    while (len > 0) {
+        size_t part = std::min(len, sizeof(words));
+        if (m_partition->read(offset, words, part) != ESP_OK) {
+            return false;
+        }
+        for (size_t i = 0; i < part / sizeof(uint32_t); i++) {
+            if (words[i] != ERASED_WORD) {
+                return false;
+            }
+        }
+        offset += part;
+        len -= part;
+    }
+    return true;
+}
+
+size_t PartitionLogStorage::blockOffset(size_t sector, size_t block) const {
+    return sector * m_sectorSize + (block + 1) * LogBlock::SIZE;
+}
+
+bool PartitionLogStorage::locate(uint32_t sequence, size_t& sector) const {
+    // Номери секторів ідуть підряд по кільцю, закінчуючись на m_head
+    if (sequence == 0 || sequence > m_headSeq || m_headSeq - sequence >= m_sectorCount) {
+        return false;
+    }
+    size_t back = m_headSeq - sequence;
+    sector = (m_head + m_sectorCount - back) % m_sectorCount;
+    return m_sectorSeq[sector] == sequence;
+}
+
+size_t PartitionLogStorage::oldestSector() const {
+    // Йдемо назад від m_head поки номери послідовні
+    size_t sector = m_head;
+    size_t candidate = m_head;
+    for (size_t i = 1; i < m_sectorCount; i++) {
+        if (!locate(m_headSeq - i, candidate)) {
+            break;
+        }
+        sector = candidate;
+    }
+    return sector;
+}
+
+size_t PartitionLogStorage::usedSectors() const {
+    return std::count_if(m_sectorSeq.begin(), m_sectorSeq.end(),
+                         [](uint32_t sequence) { return sequence != 0; });
+}
+
+uint32_t PartitionLogStorage::headerCrc(const SectorHeader& header) {
+    return esp_rom_crc32_le(0, reinterpret_cast<const uint8_t*>(&header),
+                            offsetof(SectorHeader, crc));
+}
+
+} // namespace ModESP
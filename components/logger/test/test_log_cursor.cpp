@@ -0,0 +1,37 @@
+/**
+ * @file test_log_cursor.cpp
+ * @brief Перевірка токена курсора експорту логів
+ */
+
+#include "unity.h"
+#include "logger_interface.h"
+
+using namespace ModESP;
+
+TEST_CASE("cursor token round-trips maximal field values", "[logger]")
+{
+    LogCursor cursor;
+    cursor.generation = UINT32_MAX;
+    cursor.fileIndex = UINT8_MAX;
+    cursor.offset = UINT32_MAX;
+
+    char token[LogCursor::TOKEN_SIZE];
+    cursor.toToken(token, sizeof(token));
+    TEST_ASSERT_EQUAL_STRING("4294967295.255.4294967295", token);
+
+    LogCursor parsed;
+    TEST_ASSERT_TRUE(parsed.fromToken(token));
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, parsed.generation);
+    TEST_ASSERT_EQUAL(UINT8_MAX, parsed.fileIndex);
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, parsed.offset);
+    TEST_ASSERT_TRUE(parsed.started);
+    TEST_ASSERT_FALSE(parsed.done);
+}
+
+TEST_CASE("cursor token rejects an out of range file index", "[logger]")
+{
+    LogCursor cursor;
+    TEST_ASSERT_FALSE(cursor.fromToken("1.256.0"));
+    TEST_ASSERT_FALSE(cursor.fromToken("garbage"));
+    TEST_ASSERT_FALSE(cursor.fromToken(nullptr));
+}
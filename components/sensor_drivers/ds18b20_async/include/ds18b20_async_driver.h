@@ -3,7 +3,7 @@
  * @brief Asynchronous DS18B20 OneWire temperature sensor driver
  * 
  * Non-blocking driver for DS18B20 digital temperature sensors.
- * Uses state machine to avoid blocking during temperature conversion.
+ * Conversions are batched per bus by DS18B20BusCoordinator.
  */
 
 #pragma once
@@ -18,6 +18,7 @@
  * 
  * Features:
  * - Non-blocking temperature conversion
+ * - One broadcast conversion for all sensors on a bus
  * - Automatic sensor discovery on OneWire bus
  * - Configurable resolution (9-12 bits)
  * - Temperature offset calibration
@@ -27,11 +28,13 @@
 class DS18B20AsyncDriver : public ISensorDriver {
 public:
     DS18B20AsyncDriver() = default;
-    ~DS18B20AsyncDriver() override = default;
+    ~DS18B20AsyncDriver() override;
     
     // ISensorDriver interface implementation
     esp_err_t init(ESPhal* hal, const nlohmann::json& config) override;
     SensorReading read() override;
+    esp_err_t start_read(SensorReadCallback callback, void* context) override;
+    bool poll(uint32_t now_ms) override;
     std::string get_type() const override { return "DS18B20_Async"; }
     std::string get_description() const override { return "Async Digital Temperature Sensor"; }
     bool is_available() const override { return sensor_available_; }
@@ -45,9 +48,7 @@ private:
     // State machine states
     enum class State {
         IDLE,
-        CONVERSION_REQUESTED,
-        WAITING_FOR_CONVERSION,
-        READY_TO_READ,
+        WAITING_FOR_CONVERSION,     // Bus conversion in progress
         ERROR
     };
     
@@ -69,12 +70,17 @@ private:
     
     // State machine
     State state_ = State::IDLE;
-    int64_t conversion_start_time_ms_ = 0;
+    size_t slot_ = 0;               // Slot in the bus conversion coordinator
+    bool attached_ = false;
     int retry_count_ = 0;
     
+    // Asynchronous read in progress
+    SensorReadCallback read_callback_ = nullptr;
+    void* read_context_ = nullptr;
+    
     // Cached values
     float last_temperature_ = 0.0f;
-    int64_t last_valid_read_time_ms_ = 0;
+    uint32_t last_valid_read_time_ms_ = 0;
     bool has_valid_reading_ = false;
     
     // Statistics
@@ -84,8 +90,8 @@ private:
     
     // Helper methods
     uint64_t parse_address(const std::string& hex_address);
-    int get_conversion_time_ms() const;
     bool validate_temperature(float temp) const;
-    bool is_conversion_complete() const;
+    bool advance(uint32_t current_time_ms, esp_err_t& status);
+    SensorSample make_sample(esp_err_t status, uint32_t current_time_ms) const;
     void reset_state();
 };
@@ -0,0 +1,150 @@
+/**
+ * @file ds18b20_bus_coordinator.h
+ * @brief Per-bus conversion coordinator for DS18B20 sensors
+ *
+ * Batches conversions of all DS18B20 sensors on one OneWire bus:
+ * a single SKIP ROM + CONVERT T broadcast, one wait for the slowest
+ * resolution, then all scratchpads are read back to back.
+ * A full bus refresh takes one conversion time plus N reads instead
+ * of N conversion times.
+ *
+ * Also keeps the bus device cache: one ROM search shared by all drivers,
+ * repeated only when a sensor appears or disappears from the bus.
+ */
+
+#pragma once
+
+#include "hal_interfaces.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Shared conversion cycle for all DS18B20 drivers on a bus
+ *
+ * Driven cooperatively from the drivers' read() calls on the main loop,
+ * never blocks for the conversion time. A new broadcast is started only
+ * when a sensor asks for fresh data after consuming its last result, so
+ * a cycle is not restarted by the remaining sensors polled in the same
+ * update pass.
+ */
+class DS18B20BusCoordinator {
+public:
+    using SlotId = size_t;
+
+    /**
+     * @brief Result of the last completed cycle for one sensor
+     */
+    struct Result {
+        float temperature = 0.0f;
+        esp_err_t error = ESP_ERR_INVALID_STATE;
+        uint32_t cycle = 0;             // Cycle number that produced the result (0 = none yet)
+    };
+
+    /**
+     * @brief Get (or create) the coordinator for a bus
+     */
+    static DS18B20BusCoordinator& for_bus(IOneWireBus* bus);
+
+    /**
+     * @brief Devices found on the bus
+     *
+     * The first call runs the ROM search, later calls return the cache.
+     */
+    const std::vector<uint64_t>& devices();
+
+    /**
+     * @brief Check that a device is in the bus cache
+     */
+    bool has_device(uint64_t address);
+
+    /**
+     * @brief Search the bus again after a cache miss
+     *
+     * A device missed by the cached search (line glitch, slow power-up)
+     * would otherwise never be found: later searches run only for sensors
+     * already attached. Rate limited, so sensors missing at boot share
+     * one extra search.
+     *
+     * @return true if a search ran
+     */
+    bool retry_search(uint32_t now_ms);
+
+    /**
+     * @brief Add a sensor to the bus cycle
+     * @param address 64-bit ROM address
+     * @param resolution Sensor resolution in bits (9-12)
+     * @return Slot used by the driver for poll()
+     */
+    SlotId attach(uint64_t address, int resolution);
+
+    /**
+     * @brief Remove a sensor from the bus cycle
+     *
+     * Called from the driver destructor. A slot shared by several drivers
+     * of the same address is freed with the last one; freed slots are
+     * reused by attach(), other slot ids stay valid.
+     */
+    void detach(SlotId slot);
+
+    /**
+     * @brief Advance the bus cycle and fetch a new result for the slot
+     * @param slot Slot from attach()
+     * @param now_ms Current time in milliseconds (wraps every ~49.7 days)
+     * @param result Filled when a result newer than the one last consumed is available
+     * @return true if result holds a new value (or read error)
+     */
+    bool poll(SlotId slot, uint32_t now_ms, Result& result);
+
+    /**
+     * @brief Conversion time with margin for a given resolution
+     */
+    static int conversion_time_ms(int resolution);
+
+    bool is_converting() const { return converting_; }
+    bool is_present(SlotId slot) const { return slot < slots_.size() && slots_[slot].present; }
+    uint32_t searches() const { return searches_; }
+    uint32_t cycles() const { return cycle_; }
+    size_t sensor_count() const;
+    uint32_t last_refresh_ms() const { return last_refresh_ms_; }
+
+private:
+    struct Slot {
+        uint64_t address;
+        int resolution;
+        Result result;
+        uint32_t consumed_cycle = 0;
+        bool present = true;        // In the device cache
+        bool responding = true;     // Last scratchpad read succeeded
+        uint8_t users = 0;          // Attached drivers, 0 = free slot
+    };
+
+    explicit DS18B20BusCoordinator(IOneWireBus* bus) : bus_(bus) {}
+
+    void search(uint32_t now_ms);
+    void start_conversion(uint32_t now_ms);
+    void read_all(uint32_t now_ms);
+
+    IOneWireBus* bus_;
+    std::vector<Slot> slots_;
+
+    bool converting_ = false;
+    uint32_t conversion_start_ms_ = 0;
+    uint32_t conversion_time_ms_ = 0;
+    uint32_t cycle_ = 0;
+    uint32_t last_refresh_ms_ = 0;   // Broadcast to end of the last scratchpad read
+
+    // Device cache
+    std::vector<uint64_t> devices_;
+    bool searched_ = false;
+    bool presence_changed_ = false; // A sensor started or stopped responding
+    uint32_t last_search_ms_ = 0;
+    uint32_t last_retry_ms_ = 0;
+    bool retried_ = false;
+    uint32_t searches_ = 0;
+
+    static constexpr int CRC_RETRIES = 3;
+    static constexpr uint32_t RESEARCH_INTERVAL_MS = 10000;
+    static constexpr uint32_t RETRY_SEARCH_INTERVAL_MS = 1000;
+    static std::vector<std::unique_ptr<DS18B20BusCoordinator>> coordinators_;
+};
@@ -4,6 +4,7 @@
  */
 
 #include "ds18b20_async_driver.h"
+#include "ds18b20_bus_coordinator.h"
 #include "sensor_driver_registry.h"
 #include "esphal.h"
 #include <esp_log.h>
@@ -14,6 +15,18 @@
 
 static const char* TAG = "DS18B20_Async";
 
+// Same wrapping millisecond clock SensorModule passes to poll()
+static uint32_t uptime_ms() {
+    return static_cast<uint32_t>(esp_timer_get_time() / 1000);
+}
+
+DS18B20AsyncDriver::~DS18B20AsyncDriver() {
+    // Destroyed on reconfiguration: stop reading this address every cycle
+    if (attached_) {
+        DS18B20BusCoordinator::for_bus(bus_).detach(slot_);
+    }
+}
+
 esp_err_t DS18B20AsyncDriver::init(ESPhal* hal, const nlohmann::json& config) {
     ESP_LOGI(TAG, "Initializing DS18B20 async driver");
     
@@ -53,8 +66,12 @@ esp_err_t DS18B20AsyncDriver::init(ESPhal* hal, const nlohmann::json& config) {
     if (config_.address == "auto") {
         ESP_LOGI(TAG, "Auto-detecting DS18B20 sensor on bus %s", config_.hal_id.c_str());
         
-        // Search for devices on the bus
-        auto devices = bus_->search_devices();
+        // Devices from the shared bus search, searched again if it found none
+        DS18B20BusCoordinator& coordinator = DS18B20BusCoordinator::for_bus(bus_);
+        if (coordinator.devices().empty()) {
+            coordinator.retry_search(uptime_ms());
+        }
+        const auto& devices = coordinator.devices();
         
         if (devices.empty()) {
             ESP_LOGW(TAG, "No DS18B20 sensors found on bus %s", config_.hal_id.c_str());
@@ -87,16 +104,14 @@ esp_err_t DS18B20AsyncDriver::init(ESPhal* hal, const nlohmann::json& config) {
             return ESP_ERR_INVALID_ARG;
         }
         
-        // Verify sensor presence
-        auto devices = bus_->search_devices();
-        sensor_available_ = false;
-        
-        for (auto addr : devices) {
-            if (addr == sensor_address_) {
-                sensor_available_ = true;
-                ESP_LOGI(TAG, "Found sensor at address: 0x%016llx", sensor_address_);
-                break;
-            }
+        // Verify sensor presence against the bus device cache; a miss gets
+        // one fresh search before the sensor is reported missing
+        DS18B20BusCoordinator& coordinator = DS18B20BusCoordinator::for_bus(bus_);
+        sensor_available_ = coordinator.has_device(sensor_address_) ||
+                            (coordinator.retry_search(uptime_ms()) &&
+                             coordinator.has_device(sensor_address_));
+        if (sensor_available_) {
+            ESP_LOGI(TAG, "Found sensor at address: 0x%016llx", sensor_address_);
         }
         
         if (!sensor_available_) {
@@ -109,149 +124,142 @@ esp_err_t DS18B20AsyncDriver::init(ESPhal* hal, const nlohmann::json& config) {
     state_ = State::IDLE;
     has_valid_reading_ = false;
     
+    // Join the shared conversion cycle of this bus
+    slot_ = DS18B20BusCoordinator::for_bus(bus_).attach(sensor_address_, config_.resolution);
+    attached_ = true;
+    
     ESP_LOGI(TAG, "DS18B20 async driver initialized successfully");
     return ESP_OK;
 }
 
 SensorReading DS18B20AsyncDriver::read() {
-    SensorReading reading;
-    reading.unit = "°C";
-    reading.timestamp_ms = esp_timer_get_time() / 1000;
+    uint32_t current_time_ms = uptime_ms();
     
     if (!sensor_available_) {
-        reading.is_valid = false;
+        SensorReading reading = make_sample(ESP_ERR_INVALID_STATE, current_time_ms).to_reading();
         reading.error_message = "Sensor not available";
         return reading;
-    }    
-    int64_t current_time_ms = esp_timer_get_time() / 1000;
+    }
     
-    switch (state_) {
-        case State::IDLE:
-            // Start new conversion for specific sensor
-            ESP_LOGV(TAG, "Starting temperature conversion");
-            if (bus_->start_temperature_conversion(sensor_address_) == ESP_OK) {
-                state_ = State::CONVERSION_REQUESTED;
-                conversion_start_time_ms_ = current_time_ms;
-                total_conversions_++;
-                retry_count_ = 0;
-            } else {
-                ESP_LOGE(TAG, "Failed to request temperature");
-                error_count_++;
-                reading.is_valid = false;
-                reading.error_message = "Failed to request temperature";
-            }
-            break;
-            
-        case State::CONVERSION_REQUESTED:
-            // Move to waiting state
-            state_ = State::WAITING_FOR_CONVERSION;
-            break;
-            
-        case State::WAITING_FOR_CONVERSION:
-            // Check if conversion time has elapsed
-            if (current_time_ms - conversion_start_time_ms_ >= get_conversion_time_ms()) {
-                state_ = State::READY_TO_READ;
-            }
-            break;
-            
-        case State::READY_TO_READ:
-            // Try to read temperature
-            {
-                auto result = bus_->read_temperature(sensor_address_);
-                
-                // Give more chances for CRC errors with immediate retry
-                if (!result.is_ok() && result.error == ESP_ERR_INVALID_CRC && retry_count_ < 3) {
-                    retry_count_++;
-                    ESP_LOGV(TAG, "CRC error, immediate retry %d/3", retry_count_);
-                    state_ = State::READY_TO_READ;  // immediately retry
-                    break;
-                }
-                
-                if (result.is_ok()) {
-                    float temperature = result.value;
-                    
-                    // Validate temperature
-                    if (validate_temperature(temperature)) {
-                        // Apply calibration offset
-                        temperature += config_.offset;
-                        
-                        // Update cached values
-                        last_temperature_ = temperature;
-                        last_valid_read_time_ms_ = current_time_ms;
-                        has_valid_reading_ = true;
-                        successful_reads_++;
-                        
-                        // Return valid reading
-                        reading.value = temperature;
-                        reading.is_valid = true;
-                        
-                        // Log every temperature reading
-                        ESP_LOGI(TAG, "Temperature read: %.2f°C (sensor: %s)", temperature, config_.address.c_str());
-                        
-                        // Log diagnostics every 10 successful reads
-                        if (successful_reads_ % 10 == 0) {
-                            ESP_LOGI(TAG, "Sensor stats: %" PRIu32 " successful, %" PRIu32 " errors", 
-                                     successful_reads_, error_count_);
-                        }
-                        
-                        // Don't start next conversion immediately - let the next poll cycle handle it
-                        // This gives more time margin and reduces timing conflicts
-                        state_ = State::IDLE;
-                        retry_count_ = 0;
-                    } else {
-                        // Temperature out of range
-                        ESP_LOGW(TAG, "Temperature out of range: %.2f", temperature);
-                        error_count_++;
-                        
-                        if (++retry_count_ < config_.max_retries) {
-                            // Retry conversion
-                            state_ = State::IDLE;
-                        } else {
-                            // Max retries reached
-                            state_ = State::ERROR;
-                        }
-                    }
-                } else {
-                    // Read failed - log detailed error information
-                    ESP_LOGW(TAG, "Failed to read temperature: %s (0x%x), retry %d/%d", 
-                             esp_err_to_name(result.error), result.error, retry_count_, config_.max_retries);
-                    error_count_++;
-                    
-                    if (++retry_count_ < config_.max_retries) {
-                        // Retry conversion
-                        state_ = State::IDLE;
-                    } else {
-                        // Max retries reached
-                        state_ = State::ERROR;
-                    }
-                }
-            }
-            break;
-            
-        case State::ERROR:
-            // Reset after error
-            reset_state();
-            reading.is_valid = false;
-            reading.error_message = "Max retries exceeded";
-            break;
+    esp_err_t status = ESP_ERR_NOT_FINISHED;
+    advance(current_time_ms, status);
+    return make_sample(status, current_time_ms).to_reading();
+}
+
+esp_err_t DS18B20AsyncDriver::start_read(SensorReadCallback callback, void* context) {
+    if (read_callback_) {
+        return ESP_ERR_INVALID_STATE;
     }
     
-    // If we don't have a valid reading yet, return cached value or error
-    if (!reading.is_valid && has_valid_reading_) {
-        // Return cached value if it's not too old
-        if (current_time_ms - last_valid_read_time_ms_ < 60000) { // 1 minute
-            reading.value = last_temperature_;
-            reading.is_valid = true;
-            reading.error_message = ""; // Clear any error message
-        } else {
-            reading.is_valid = false;
-            reading.error_message = "Stale data";
+    if (!sensor_available_) {
+        callback(context, make_sample(ESP_ERR_INVALID_STATE, uptime_ms()));
+        return ESP_OK;
+    }
+    
+    read_callback_ = callback;
+    read_context_ = context;
+    poll(uptime_ms());
+    return ESP_OK;
+}
+
+bool DS18B20AsyncDriver::poll(uint32_t now_ms) {
+    if (!read_callback_) {
+        return false;
+    }
+    
+    // Bus conversion still running - come back on the next poll
+    esp_err_t status = ESP_ERR_NOT_FINISHED;
+    if (!advance(now_ms, status)) {
+        return true;
+    }
+    
+    SensorReadCallback callback = read_callback_;
+    read_callback_ = nullptr;
+    callback(read_context_, make_sample(status, now_ms));
+    return false;
+}
+
+bool DS18B20AsyncDriver::advance(uint32_t current_time_ms, esp_err_t& status) {
+    // Conversion is shared by all sensors on the bus: one SKIP ROM + CONVERT T,
+    // then the coordinator reads every scratchpad once the wait is over
+    DS18B20BusCoordinator& coordinator = DS18B20BusCoordinator::for_bus(bus_);
+    DS18B20BusCoordinator::Result result;
+    
+    if (state_ == State::ERROR) {
+        // Reset after error
+        reset_state();
+        status = ESP_ERR_TIMEOUT;   // Max retries exceeded
+        return true;
+    }
+    
+    if (!coordinator.poll(slot_, current_time_ms, result)) {
+        if (coordinator.is_converting()) {
+            state_ = State::WAITING_FOR_CONVERSION;
         }
-    } else if (!reading.is_valid) {
-        reading.error_message = "No valid reading available";
+        return false;
+    }
+    
+    total_conversions_++;
+    status = result.error;
+    
+    if (result.error != ESP_OK) {
+        // Read failed (CRC errors were already retried by the coordinator)
+        ESP_LOGW(TAG, "Failed to read temperature: %s (0x%x), retry %d/%d", 
+                 esp_err_to_name(result.error), result.error, retry_count_, config_.max_retries);
+        error_count_++;
+        state_ = (++retry_count_ < config_.max_retries) ? State::IDLE : State::ERROR;
+        return true;
+    }
+    
+    float temperature = result.temperature;
+    
+    // Validate temperature
+    if (!validate_temperature(temperature)) {
+        ESP_LOGW(TAG, "Temperature out of range: %.2f", temperature);
+        error_count_++;
+        state_ = (++retry_count_ < config_.max_retries) ? State::IDLE : State::ERROR;
+        status = ESP_ERR_INVALID_RESPONSE;
+        return true;
+    }
+    
+    // Apply calibration offset
+    temperature += config_.offset;
+    
+    // Update cached values
+    last_temperature_ = temperature;
+    last_valid_read_time_ms_ = current_time_ms;
+    has_valid_reading_ = true;
+    successful_reads_++;
+    
+    // Per-sample output on the sensor task stays at debug level
+    ESP_LOGD(TAG, "Temperature read: %.2f°C (sensor: %s)", temperature, config_.address.c_str());
+    
+    // Log diagnostics every 10 successful reads
+    if (successful_reads_ % 10 == 0) {
+        ESP_LOGD(TAG, "Sensor stats: %" PRIu32 " successful, %" PRIu32 " errors", 
+                 successful_reads_, error_count_);
     }
     
-    return reading;
+    // Next conversion is started by the next poll cycle
+    state_ = State::IDLE;
+    retry_count_ = 0;
+    return true;
+}
+
+SensorSample DS18B20AsyncDriver::make_sample(esp_err_t status, uint32_t current_time_ms) const {
+    SensorSample sample = {last_temperature_, SensorUnit::CELSIUS, status,
+                           current_time_ms};
+    
+    // Fresh value, or the cached one if it's not too old
+    if (status == ESP_OK || !has_valid_reading_) {
+        return sample;
+    }
+    if (static_cast<uint32_t>(current_time_ms - last_valid_read_time_ms_) < 60000) { // 1 minute
+        sample.status = ESP_OK;
+    } else {
+        sample.status = ESP_ERR_TIMEOUT;  // Stale data
+    }
+    return sample;
 }
 
 void DS18B20AsyncDriver::reset_state() {
@@ -360,12 +368,22 @@ nlohmann::json DS18B20AsyncDriver::get_diagnostics() const {
     std::string state_str;
     switch (state_) {
         case State::IDLE: state_str = "IDLE"; break;
-        case State::CONVERSION_REQUESTED: state_str = "CONVERSION_REQUESTED"; break;
         case State::WAITING_FOR_CONVERSION: state_str = "WAITING_FOR_CONVERSION"; break;
-        case State::READY_TO_READ: state_str = "READY_TO_READ"; break;
         case State::ERROR: state_str = "ERROR"; break;
     }
     
+    nlohmann::json bus = nullptr;
+    if (bus_) {
+        const DS18B20BusCoordinator& coordinator = DS18B20BusCoordinator::for_bus(bus_);
+        bus = {
+            {"sensors", coordinator.sensor_count()},
+            {"present", coordinator.is_present(slot_)},
+            {"searches", coordinator.searches()},
+            {"cycles", coordinator.cycles()},
+            {"refresh_ms", coordinator.last_refresh_ms()}
+        };
+    }
+    
     return {
         {"driver_type", "DS18B20_Async"},
         {"sensor_address", config_.address},
@@ -377,23 +395,12 @@ nlohmann::json DS18B20AsyncDriver::get_diagnostics() const {
         {"total_conversions", total_conversions_},
         {"sensor_available", sensor_available_},
         {"resolution_bits", config_.resolution},
-        {"retry_count", retry_count_}
+        {"retry_count", retry_count_},
+        {"bus", bus}
     };
 }
 
 // Helper methods
-int DS18B20AsyncDriver::get_conversion_time_ms() const {
-    // DS18B20 conversion times by resolution (with improved OneWire timing):
-    // 9 bits: 93.75ms, 10 bits: 187.5ms, 11 bits: 375ms, 12 bits: 750ms
-    switch (config_.resolution) {
-        case 9: return 150;   // +60% margin 
-        case 10: return 300;  // +60% margin
-        case 11: return 600;  // +60% margin
-        case 12: return 1200; // +60% margin
-        default: return 1200;
-    }
-}
-
 bool DS18B20AsyncDriver::validate_temperature(float temp) const {
     // DS18B20 valid range: -55°C to +125°C
     return (temp >= -55.0f && temp <= 125.0f);
@@ -0,0 +1,221 @@
+/**
+ * @file ds18b20_bus_coordinator.cpp
+ * @brief Implementation of per-bus DS18B20 conversion coordinator
+ */
+
+#include "ds18b20_bus_coordinator.h"
+#include <esp_log.h>
+#include <esp_timer.h>
+#include <algorithm>
+
+static const char* TAG = "DS18B20_Bus";
+
+std::vector<std::unique_ptr<DS18B20BusCoordinator>> DS18B20BusCoordinator::coordinators_;
+
+DS18B20BusCoordinator& DS18B20BusCoordinator::for_bus(IOneWireBus* bus) {
+    for (auto& coordinator : coordinators_) {
+        if (coordinator->bus_ == bus) {
+            return *coordinator;
+        }
+    }
+    coordinators_.emplace_back(new DS18B20BusCoordinator(bus));
+    return *coordinators_.back();
+}
+
+const std::vector<uint64_t>& DS18B20BusCoordinator::devices() {
+    if (!searched_) {
+        search(last_search_ms_);
+    }
+    return devices_;
+}
+
+bool DS18B20BusCoordinator::has_device(uint64_t address) {
+    const auto& found = devices();
+    return std::find(found.begin(), found.end(), address) != found.end();
+}
+
+bool DS18B20BusCoordinator::retry_search(uint32_t now_ms) {
+    if (retried_ && static_cast<uint32_t>(now_ms - last_retry_ms_) < RETRY_SEARCH_INTERVAL_MS) {
+        return false;
+    }
+    retried_ = true;
+    last_retry_ms_ = now_ms;
+    search(now_ms);
+    return true;
+}
+
+DS18B20BusCoordinator::SlotId DS18B20BusCoordinator::attach(uint64_t address, int resolution) {
+    size_t free_slot = slots_.size();
+    for (size_t i = 0; i < slots_.size(); i++) {
+        if (slots_[i].users && slots_[i].address == address) {
+            slots_[i].resolution = std::max(slots_[i].resolution, resolution);
+            slots_[i].users++;
+            return i;
+        }
+        if (!slots_[i].users && free_slot == slots_.size()) {
+            free_slot = i;
+        }
+    }
+
+    Slot slot = {};
+    slot.address = address;
+    slot.resolution = resolution;
+    slot.present = has_device(address);
+    slot.responding = slot.present;
+    slot.users = 1;
+    // Results of the previous owner are never handed out
+    slot.consumed_cycle = cycle_;
+    if (free_slot < slots_.size()) {
+        slots_[free_slot] = slot;
+    } else {
+        slots_.push_back(slot);
+    }
+
+    ESP_LOGI(TAG, "Sensor %016llx attached to bus coordinator (%zu on bus)",
+             address, sensor_count());
+    return free_slot;
+}
+
+void DS18B20BusCoordinator::detach(SlotId slot_id) {
+    if (slot_id >= slots_.size() || !slots_[slot_id].users) {
+        return;
+    }
+    Slot& slot = slots_[slot_id];
+    if (--slot.users == 0) {
+        ESP_LOGI(TAG, "Sensor %016llx detached from bus coordinator", slot.address);
+        slot = Slot();
+    }
+}
+
+size_t DS18B20BusCoordinator::sensor_count() const {
+    return std::count_if(slots_.begin(), slots_.end(), [](const Slot& slot) { return slot.users > 0; });
+}
+
+bool DS18B20BusCoordinator::poll(SlotId slot_id, uint32_t now_ms, Result& result) {
+    if (slot_id >= slots_.size() || !slots_[slot_id].users) {
+        return false;
+    }
+    Slot& slot = slots_[slot_id];
+
+    if (converting_ && static_cast<uint32_t>(now_ms - conversion_start_ms_) >= conversion_time_ms_) {
+        read_all(now_ms);
+    }
+
+    // New result from a completed cycle
+    if (slot.result.cycle > slot.consumed_cycle) {
+        slot.consumed_cycle = slot.result.cycle;
+        result = slot.result;
+        return true;
+    }
+
+    // This sensor already consumed the last cycle - it asks for a new one
+    if (!converting_) {
+        if (presence_changed_ && static_cast<uint32_t>(now_ms - last_search_ms_) >= RESEARCH_INTERVAL_MS) {
+            search(now_ms);
+        }
+        start_conversion(now_ms);
+    }
+    return false;
+}
+
+int DS18B20BusCoordinator::conversion_time_ms(int resolution) {
+    // DS18B20 conversion times by resolution (with improved OneWire timing):
+    // 9 bits: 93.75ms, 10 bits: 187.5ms, 11 bits: 375ms, 12 bits: 750ms
+    switch (resolution) {
+        case 9: return 150;   // +60% margin
+        case 10: return 300;  // +60% margin
+        case 11: return 600;  // +60% margin
+        case 12: return 1200; // +60% margin
+        default: return 1200;
+    }
+}
+
+void DS18B20BusCoordinator::search(uint32_t now_ms) {
+    // Single search for every driver on the bus
+    devices_ = bus_->search_devices();
+    searched_ = true;
+    presence_changed_ = false;
+    last_search_ms_ = now_ms;
+    searches_++;
+
+    for (auto& slot : slots_) {
+        if (!slot.users) {
+            continue;
+        }
+        bool present = std::find(devices_.begin(), devices_.end(), slot.address) != devices_.end();
+        if (present != slot.present) {
+            ESP_LOGW(TAG, "Sensor %016llx %s the bus", slot.address, present ? "returned to" : "left");
+        }
+        slot.present = present;
+    }
+
+    ESP_LOGI(TAG, "Bus search #%lu: %zu device(s)", static_cast<unsigned long>(searches_), devices_.size());
+}
+
+void DS18B20BusCoordinator::start_conversion(uint32_t now_ms) {
+    // One SKIP ROM + CONVERT T for every sensor on the bus
+    esp_err_t ret = bus_->request_temperatures();
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Broadcast conversion failed: %s", esp_err_to_name(ret));
+
+        // Report the failure to every sensor so drivers can count errors
+        cycle_++;
+        for (auto& slot : slots_) {
+            slot.result.error = ret;
+            slot.result.cycle = cycle_;
+        }
+        return;
+    }
+
+    // Wait once for the slowest sensor
+    conversion_time_ms_ = 0;
+    for (const auto& slot : slots_) {
+        if (slot.users) {
+            conversion_time_ms_ = std::max(conversion_time_ms_,
+                                           static_cast<uint32_t>(conversion_time_ms(slot.resolution)));
+        }
+    }
+
+    converting_ = true;
+    conversion_start_ms_ = now_ms;
+    ESP_LOGV(TAG, "Broadcast conversion for %zu sensors, waiting %lu ms",
+             sensor_count(), static_cast<unsigned long>(conversion_time_ms_));
+}
+
+void DS18B20BusCoordinator::read_all(uint32_t now_ms) {
+    converting_ = false;
+    cycle_++;
+    int64_t reads_start_us = esp_timer_get_time();
+
+    // Scratchpads back to back, CRC errors retried immediately.
+    // A sensor missing from the last search gets one read to notice its return
+    for (auto& slot : slots_) {
+        if (!slot.users) {
+            continue;
+        }
+        HalResult<float> read = bus_->read_temperature(slot.address);
+        int retries = slot.present ? CRC_RETRIES : 0;
+        for (int retry = 0; retry < retries && read.error == ESP_ERR_INVALID_CRC; retry++) {
+            ESP_LOGV(TAG, "CRC error on %016llx, retry %d/%d", slot.address, retry + 1, CRC_RETRIES);
+            read = bus_->read_temperature(slot.address);
+        }
+
+        slot.result.temperature = read.value;
+        slot.result.error = read.error;
+        slot.result.cycle = cycle_;
+
+        // Re-search only when a sensor starts or stops answering
+        bool responding = read.is_ok();
+        if (responding != slot.responding) {
+            slot.responding = responding;
+            presence_changed_ = true;
+        }
+    }
+
+    // Conversion wait plus the N scratchpad transfers measured after them
+    uint32_t reads_ms = static_cast<uint32_t>((esp_timer_get_time() - reads_start_us) / 1000);
+    last_refresh_ms_ = static_cast<uint32_t>(now_ms - conversion_start_ms_) + reads_ms;
+    ESP_LOGD(TAG, "Bus refresh #%lu: %zu sensors in %lu ms",
+             static_cast<unsigned long>(cycle_), sensor_count(),
+             static_cast<unsigned long>(last_refresh_ms_));
+}
@@ -1,7 +1,7 @@
 /**
  * @file gpio_input_driver.h
  * @brief GPIO input sensor driver for digital inputs
- * 
+ *
  * Self-contained driver for digital inputs like door switches,
  * alarm contacts, and other binary sensors.
  */
@@ -10,27 +10,27 @@
 
 #include "sensor_driver_interface.h"
 #include "hal_interfaces.h"
-#include <freertos/FreeRTOS.h>
-#include <freertos/timers.h>
+#include <atomic>
 
 /**
  * @brief GPIO input sensor driver
- * 
+ *
  * Features:
  * - Configurable input polarity (normal/inverted)
- * - Software debouncing with configurable time
+ * - Interrupt-driven debouncing in the HAL when the input supports it,
+ *   software debouncing on each read otherwise
+ * - Changes reported to the owner immediately, not at the poll period
  * - Edge detection and counting
- * - Pull-up/pull-down configuration
- * - Event generation on state change
  */
 class GpioInputDriver : public ISensorDriver {
 public:
     GpioInputDriver();
     ~GpioInputDriver() override;
-    
+
     // ISensorDriver interface implementation
-    esp_err_t init(ESPhal& hal, const nlohmann::json& config) override;
+    esp_err_t init(ESPhal* hal, const nlohmann::json& config) override;
     SensorReading read() override;
+    void set_change_callback(SensorChangeCallback callback, void* context) override;
     std::string get_type() const override { return "GPIO_INPUT"; }
     std::string get_description() const override { return "Digital Input Sensor"; }
     bool is_available() const override { return gpio_input_ != nullptr; }
@@ -48,19 +48,28 @@ private:
         std::string active_label = "ON";   // Label for active state
         std::string inactive_label = "OFF"; // Label for inactive state
     } config_;
-    
+
     // Runtime state
     IGpioInput* gpio_input_ = nullptr;
-    bool last_state_ = false;
-    bool debounced_state_ = false;
-    uint32_t state_change_count_ = 0;
+    bool interrupt_driven_ = false;     // HAL debounces and reports changes
     uint32_t total_reads_ = 0;
-    uint64_t last_change_time_ms_ = 0;
+
+    // Polled debouncing (inputs without interrupt support)
+    bool last_state_ = false;
     uint64_t debounce_start_time_ms_ = 0;
     bool debouncing_ = false;
-    
+
+    // Shared with the HAL change callback (esp_timer task)
+    std::atomic<bool> debounced_state_{false};
+    std::atomic<uint32_t> state_change_count_{0};
+    std::atomic<uint32_t> last_change_time_ms_{0};
+    std::atomic<SensorChangeCallback> change_callback_{nullptr};
+    std::atomic<void*> change_context_{nullptr};
+
     // Helper methods
     bool read_raw_state();
     void update_debounced_state();
+    void set_debounced_state(bool state, uint32_t timestamp_ms);
+    static void on_input_change(void* context, bool state, uint32_t timestamp_ms);
     uint64_t get_time_ms() const;
-};
\ No newline at end of file
+};
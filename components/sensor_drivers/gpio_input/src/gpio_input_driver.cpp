@@ -4,52 +4,55 @@
  */
 
 #include "gpio_input_driver.h"
-#include "sensor_driver_registry.h"
 #include "esphal.h"
 #include <esp_log.h>
 #include <esp_timer.h>
 
 static const char* TAG = "GPIO_INPUT";
 
-// Auto-register this driver
-static SensorDriverRegistrar<GpioInputDriver> registrar("GPIO_INPUT");
-
 GpioInputDriver::GpioInputDriver() {
     last_change_time_ms_ = get_time_ms();
 }
 
-GpioInputDriver::~GpioInputDriver() = default;
+GpioInputDriver::~GpioInputDriver() {
+    // Returns after any callback still running in the HAL
+    if (interrupt_driven_) {
+        gpio_input_->subscribe(nullptr, nullptr, 0);
+    }
+}
 
-esp_err_t GpioInputDriver::init(ESPhal& hal, const nlohmann::json& config) {
+esp_err_t GpioInputDriver::init(ESPhal* hal, const nlohmann::json& config) {
     ESP_LOGI(TAG, "Initializing GPIO input driver");
     
     // Parse configuration
-    try {
-        config_.hal_id = config["hal_id"].get<std::string>();
-        config_.invert = config.value("invert", false);
-        config_.debounce_ms = config.value("debounce_ms", 50);
-        config_.count_edges = config.value("count_edges", false);
-        config_.active_label = config.value("active_label", "ON");
-        config_.inactive_label = config.value("inactive_label", "OFF");
-    } catch (const nlohmann::json::exception& e) {
-        ESP_LOGE(TAG, "Configuration error: %s", e.what());
+    if (!config.contains("hal_id") || !config["hal_id"].is_string()) {
+        ESP_LOGE(TAG, "Missing or invalid hal_id in configuration");
         return ESP_ERR_INVALID_ARG;
-    }    
+    }
+    config_.hal_id = config["hal_id"].get<std::string>();
+    config_.invert = config.value("invert", false);
+    config_.debounce_ms = config.value("debounce_ms", 50u);
+    config_.count_edges = config.value("count_edges", false);
+    config_.active_label = config.value("active_label", std::string("ON"));
+    config_.inactive_label = config.value("inactive_label", std::string("OFF"));
+    
     // Get GPIO input from HAL
-    try {
-        gpio_input_ = &hal.get_gpio_input(config_.hal_id);
-    } catch (const std::exception& e) {
-        ESP_LOGE(TAG, "Failed to get GPIO input '%s': %s", 
-                 config_.hal_id.c_str(), e.what());
-        return ESP_FAIL;
+    if (!hal || !hal->has_gpio_input(config_.hal_id)) {
+        ESP_LOGE(TAG, "GPIO input '%s' not found in HAL", config_.hal_id.c_str());
+        return ESP_ERR_NOT_FOUND;
     }
+    gpio_input_ = &hal->get_gpio_input(config_.hal_id);
     
     // Read initial state
     last_state_ = read_raw_state();
     debounced_state_ = last_state_;
     
-    ESP_LOGI(TAG, "GPIO input initialized: %s, initial state: %s", 
-             config_.hal_id.c_str(), debounced_state_ ? "HIGH" : "LOW");
+    // Edge interrupts: the HAL debounces and calls back on change only
+    interrupt_driven_ = gpio_input_->subscribe(on_input_change, this, config_.debounce_ms) == ESP_OK;
+    
+    ESP_LOGI(TAG, "GPIO input initialized: %s, initial state: %s, %s", 
+             config_.hal_id.c_str(), debounced_state_ ? "HIGH" : "LOW",
+             interrupt_driven_ ? "interrupt driven" : "polled");
     
     return ESP_OK;
 }
@@ -65,9 +68,12 @@ SensorReading GpioInputDriver::read() {
         return reading;
     }
     
-    total_reads_++;    
-    // Update debounced state
-    update_debounced_state();
+    total_reads_++;
+    
+    // Interrupt-driven inputs are already debounced - no pin access
+    if (!interrupt_driven_) {
+        update_debounced_state();
+    }
     
     // Return binary value (0.0 or 1.0)
     reading.value = debounced_state_ ? 1.0f : 0.0f;
@@ -76,6 +82,35 @@ SensorReading GpioInputDriver::read() {
     return reading;
 }
 
+void GpioInputDriver::set_change_callback(SensorChangeCallback callback, void* context) {
+    change_context_ = context;
+    change_callback_ = callback;
+}
+
+void GpioInputDriver::on_input_change(void* context, bool state, uint32_t timestamp_ms) {
+    auto* driver = static_cast<GpioInputDriver*>(context);
+    driver->set_debounced_state(driver->config_.invert ? !state : state, timestamp_ms);
+    
+    SensorChangeCallback callback = driver->change_callback_;
+    if (callback) {
+        callback(driver->change_context_);
+    }
+}
+
+void GpioInputDriver::set_debounced_state(bool state, uint32_t timestamp_ms) {
+    if (state == debounced_state_) {
+        return;
+    }
+    debounced_state_ = state;
+    last_change_time_ms_ = timestamp_ms;
+    
+    if (config_.count_edges) {
+        state_change_count_++;
+    }
+    
+    ESP_LOGD(TAG, "State changed to: %s", state ? "HIGH" : "LOW");
+}
+
 void GpioInputDriver::update_debounced_state() {
     bool current_state = read_raw_state();
     uint64_t now_ms = get_time_ms();
@@ -91,17 +126,7 @@ void GpioInputDriver::update_debounced_state() {
         // Check if debounce time has passed
         if ((now_ms - debounce_start_time_ms_) >= config_.debounce_ms) {
             // Debounce complete, update state
-            if (current_state != debounced_state_) {
-                debounced_state_ = current_state;
-                last_change_time_ms_ = now_ms;
-                
-                if (config_.count_edges) {
-                    state_change_count_++;
-                }
-                
-                ESP_LOGD(TAG, "State changed to: %s", 
-                         debounced_state_ ? "HIGH" : "LOW");
-            }
+            set_debounced_state(current_state, now_ms);
             debouncing_ = false;
         }
     }
@@ -118,32 +143,38 @@ nlohmann::json GpioInputDriver::get_config() const {
 }
 
 esp_err_t GpioInputDriver::set_config(const nlohmann::json& config) {
-    try {
-        if (config.contains("invert")) {
-            config_.invert = config["invert"].get<bool>();
-        }
-        
-        if (config.contains("debounce_ms")) {
-            config_.debounce_ms = config["debounce_ms"].get<uint32_t>();
-        }
-        
-        if (config.contains("count_edges")) {
-            config_.count_edges = config["count_edges"].get<bool>();
-        }
-        
-        if (config.contains("active_label")) {
-            config_.active_label = config["active_label"].get<std::string>();
+    if (!config.is_object()) {
+        ESP_LOGE(TAG, "Configuration must be an object");
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    if (config.contains("invert") && config["invert"].is_boolean()) {
+        config_.invert = config["invert"].get<bool>();
+        if (interrupt_driven_) {
+            debounced_state_ = read_raw_state();
         }
-        
-        if (config.contains("inactive_label")) {
-            config_.inactive_label = config["inactive_label"].get<std::string>();
+    }
+    
+    if (config.contains("debounce_ms") && config["debounce_ms"].is_number_unsigned()) {
+        config_.debounce_ms = config["debounce_ms"].get<uint32_t>();
+        if (interrupt_driven_) {
+            gpio_input_->subscribe(on_input_change, this, config_.debounce_ms);
         }
-        
-        return ESP_OK;
-    } catch (const nlohmann::json::exception& e) {
-        ESP_LOGE(TAG, "Configuration update error: %s", e.what());
-        return ESP_ERR_INVALID_ARG;
     }
+    
+    if (config.contains("count_edges") && config["count_edges"].is_boolean()) {
+        config_.count_edges = config["count_edges"].get<bool>();
+    }
+    
+    if (config.contains("active_label") && config["active_label"].is_string()) {
+        config_.active_label = config["active_label"].get<std::string>();
+    }
+    
+    if (config.contains("inactive_label") && config["inactive_label"].is_string()) {
+        config_.inactive_label = config["inactive_label"].get<std::string>();
+    }
+    
+    return ESP_OK;
 }
 nlohmann::json GpioInputDriver::get_ui_schema() const {
     return {
@@ -186,16 +217,17 @@ nlohmann::json GpioInputDriver::get_ui_schema() const {
     };
 }
 nlohmann::json GpioInputDriver::get_diagnostics() const {
-    uint64_t now_ms = get_time_ms();
-    uint64_t time_since_change_ms = now_ms - last_change_time_ms_;
+    uint32_t now_ms = get_time_ms();
+    uint32_t time_since_change_ms = now_ms - last_change_time_ms_;
     
     return {
-        {"current_state", debounced_state_},
+        {"current_state", debounced_state_.load()},
         {"state_label", debounced_state_ ? config_.active_label : config_.inactive_label},
         {"raw_state", gpio_input_ ? gpio_input_->get_state() : false},
         {"inverted", config_.invert},
+        {"interrupt_driven", interrupt_driven_},
         {"debouncing", debouncing_},
-        {"state_change_count", state_change_count_},
+        {"state_change_count", state_change_count_.load()},
         {"total_reads", total_reads_},
         {"time_since_change_ms", time_since_change_ms},
         {"time_since_change_s", time_since_change_ms / 1000.0}
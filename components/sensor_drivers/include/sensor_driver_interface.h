@@ -15,6 +15,7 @@
 #include <string>
 #include <memory>
 #include <optional>
+#include <type_traits>
 #include <nlohmann/json.hpp>
 #include "esp_err.h"
 
@@ -33,6 +34,90 @@ enum class SensorType {
     UNKNOWN
 };
 
+/**
+ * @brief Unit of a sensor value
+ */
+enum class SensorUnit : uint8_t {
+    NONE,           // Binary state, counts
+    CELSIUS,
+    PERCENT,
+    PASCAL,
+    VOLT,
+    AMPERE,
+    HERTZ,
+    RPM
+};
+
+/**
+ * @brief Display string for a unit
+ */
+inline const char* sensor_unit_to_string(SensorUnit unit) {
+    switch (unit) {
+        case SensorUnit::CELSIUS: return "°C";
+        case SensorUnit::PERCENT: return "%";
+        case SensorUnit::PASCAL: return "Pa";
+        case SensorUnit::VOLT: return "V";
+        case SensorUnit::AMPERE: return "A";
+        case SensorUnit::HERTZ: return "Hz";
+        case SensorUnit::RPM: return "rpm";
+        default: return "";
+    }
+}
+
+/**
+ * @brief Unit for a display string (NONE if unknown)
+ */
+inline SensorUnit sensor_unit_from_string(const std::string& unit) {
+    for (auto candidate : {SensorUnit::CELSIUS, SensorUnit::PERCENT, SensorUnit::PASCAL,
+                           SensorUnit::VOLT, SensorUnit::AMPERE, SensorUnit::HERTZ,
+                           SensorUnit::RPM}) {
+        if (unit == sensor_unit_to_string(candidate)) {
+            return candidate;
+        }
+    }
+    return SensorUnit::NONE;
+}
+
+struct SensorReading;
+
+/**
+ * @brief Result of an asynchronous read
+ *
+ * Trivially copyable, no strings: passed by value through completion
+ * callbacks. status is ESP_OK for a valid value, otherwise the error.
+ */
+struct SensorSample {
+    float value;
+    SensorUnit unit;
+    esp_err_t status;
+    uint32_t timestamp_ms;
+    
+    bool is_valid() const { return status == ESP_OK; }
+    
+    /**
+     * @brief Build the string-based reading (UI, SharedState)
+     */
+    inline SensorReading to_reading() const;
+    
+    /**
+     * @brief Convert sample to JSON for SharedState
+     */
+    nlohmann::json to_json() const {
+        nlohmann::json j;
+        j["value"] = value;
+        j["unit"] = sensor_unit_to_string(unit);
+        j["timestamp_ms"] = timestamp_ms;
+        j["is_valid"] = is_valid();
+        if (status != ESP_OK) {
+            j["error"] = esp_err_to_name(status);
+        }
+        return j;
+    }
+};
+
+static_assert(std::is_trivially_copyable<SensorSample>::value,
+              "SensorSample is passed by value through callbacks");
+
 /**
  * @brief Sensor reading result with timestamp and status
  */
@@ -59,6 +144,31 @@ struct SensorReading {
     }
 };
 
+inline SensorReading SensorSample::to_reading() const {
+    SensorReading reading;
+    reading.value = value;
+    reading.unit = sensor_unit_to_string(unit);
+    reading.timestamp_ms = timestamp_ms;
+    reading.is_valid = is_valid();
+    if (status != ESP_OK) {
+        reading.error_message = esp_err_to_name(status);
+    }
+    return reading;
+}
+
+/**
+ * @brief Completion callback of an asynchronous read
+ * @param context Pointer passed to start_read()
+ * @param sample Result of the read
+ */
+using SensorReadCallback = void (*)(void* context, const SensorSample& sample);
+
+/**
+ * @brief Notification that a driver has a new value outside its poll period
+ * @param context Pointer passed to set_change_callback()
+ */
+using SensorChangeCallback = void (*)(void* context);
+
 /**
  * @brief Base interface for all sensor drivers
  * 
@@ -95,6 +205,54 @@ public:
      */
     virtual SensorReading read() = 0;
     
+    /**
+     * @brief Start a non-blocking read
+     * 
+     * The callback is invoked exactly once, either from start_read() itself
+     * (result available immediately) or from a later poll(). The default
+     * completes synchronously through read(); drivers that wait for
+     * hardware override start_read() and poll().
+     * 
+     * @param callback Completion callback
+     * @param context Passed back to the callback
+     * @return ESP_OK if the read was started, ESP_ERR_INVALID_STATE if one is in progress
+     */
+    virtual esp_err_t start_read(SensorReadCallback callback, void* context) {
+        SensorReading reading = read();
+        SensorSample sample = {
+            reading.value,
+            sensor_unit_from_string(reading.unit),
+            reading.is_valid ? ESP_OK : ESP_FAIL,
+            reading.timestamp_ms
+        };
+        callback(context, sample);
+        return ESP_OK;
+    }
+    
+    /**
+     * @brief Advance a read started by start_read()
+     * 
+     * Never blocks. May invoke the completion callback.
+     * 
+     * @param now_ms Current time in milliseconds
+     * @return true while the read is still in progress
+     */
+    virtual bool poll(uint32_t now_ms) {
+        return false;
+    }
+    
+    /**
+     * @brief Register for value change notifications
+     * 
+     * Event-driven drivers (interrupt inputs) call it from any task when
+     * their value changes; the owner then reads the driver right away
+     * instead of waiting for the poll period. Polled drivers ignore it.
+     * 
+     * @param callback Notification, nullptr to unregister
+     * @param context Passed back to the callback
+     */
+    virtual void set_change_callback(SensorChangeCallback callback, void* context) {}
+    
     /**
      * @brief Get driver type identifier
      * @return String identifier like "DS18B20", "NTC", "PRESSURE_4_20MA"
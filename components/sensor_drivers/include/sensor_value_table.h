@@ -0,0 +1,62 @@
+/**
+ * @file sensor_value_table.h
+ * @brief Latest published value of every sensor role
+ *
+ * SensorModule stores each accepted sample here by slot. Consumers inside
+ * the sensor layer (virtual sensors) resolve roles to slots once at
+ * configure time and then read values and change counters directly,
+ * without SharedState lookups or JSON.
+ */
+
+#pragma once
+
+#include "sensor_driver_interface.h"
+#include <string>
+#include <vector>
+
+/**
+ * @brief Role-indexed table of latest sensor samples
+ */
+class SensorValueTable {
+public:
+    struct Entry {
+        SensorSample sample = {0.0f, SensorUnit::NONE, ESP_ERR_NOT_FINISHED, 0};
+        uint32_t version = 0;       // Incremented on every update
+    };
+
+    static SensorValueTable& instance() {
+        static SensorValueTable table;
+        return table;
+    }
+
+    /**
+     * @brief Slot for a role, created on first use
+     *
+     * Call during configuration only: slots are never removed, so indices
+     * stay valid for the lifetime of the table.
+     */
+    int resolve(const std::string& role) {
+        for (size_t i = 0; i < roles_.size(); i++) {
+            if (roles_[i] == role) {
+                return static_cast<int>(i);
+            }
+        }
+        roles_.push_back(role);
+        entries_.emplace_back();
+        return static_cast<int>(roles_.size() - 1);
+    }
+
+    void update(int slot, const SensorSample& sample) {
+        Entry& entry = entries_[slot];
+        entry.sample = sample;
+        entry.version++;
+    }
+
+    const Entry& get(int slot) const { return entries_[slot]; }
+
+private:
+    SensorValueTable() = default;
+
+    std::vector<std::string> roles_;
+    std::vector<Entry> entries_;
+};
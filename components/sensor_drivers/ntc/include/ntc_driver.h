@@ -10,7 +10,9 @@
 
 #include "sensor_driver_interface.h"
 #include "hal_interfaces.h"
+#include "ntc_table.h"
 #include <array>
+#include <memory>
 
 /**
  * @brief NTC thermistor sensor driver
@@ -19,6 +21,7 @@
  * - Multiple NTC curve profiles (10K, 100K, etc.)
  * - Steinhart-Hart equation for accurate conversion
  * - Beta coefficient calculation
+ * - Lookup table with fixed-point interpolation (no logf per read)
  * - Automatic averaging for noise reduction
  * - Configurable voltage divider parameters
  */
@@ -37,6 +40,8 @@ public:
     // ISensorDriver interface implementation
     esp_err_t init(ESPhal* hal, const nlohmann::json& config) override;
     SensorReading read() override;
+    esp_err_t start_read(SensorReadCallback callback, void* context) override;
+    bool poll(uint32_t now_ms) override;
     std::string get_type() const override { return "NTC"; }
     std::string get_description() const override { return "NTC Thermistor Temperature Sensor"; }
     bool is_available() const override { return adc_channel_ != nullptr; }
@@ -72,9 +77,28 @@ private:
     float last_temperature_ = 0.0f;
     float last_resistance_ = 0.0f;
     
+    // ADC code to temperature table: built-in profile or generated at init
+    const ntc::Table* table_ = nullptr;
+    std::unique_ptr<ntc::Table> runtime_table_;
+    
+    // Running ADC average (blocking read or one sample per poll)
+    struct {
+        float sum = 0.0f;
+        int taken = 0;
+        int valid = 0;
+        esp_err_t last_error = ESP_FAIL;
+    } average_;
+    SensorReadCallback read_callback_ = nullptr;
+    void* read_context_ = nullptr;
+    
     // Helper methods
-    float calculate_resistance(int adc_value) const;
+    esp_err_t read_adc(float& adc_value);
+    void accumulate_sample();
+    esp_err_t finish_average(float& adc_value);
+    SensorSample make_sample(esp_err_t adc_status, float adc_value);
+    float calculate_resistance(float adc_value) const;
     float resistance_to_temperature(float resistance) const;
     float steinhart_hart(float resistance) const;
     void load_ntc_profile(NTCType type);
+    void build_table();
 };
\ No newline at end of file
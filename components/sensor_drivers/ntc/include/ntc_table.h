@@ -0,0 +1,129 @@
+/**
+ * @file ntc_table.h
+ * @brief ADC code to temperature lookup tables for NTC thermistors
+ *
+ * The divider output ratio does not depend on Vcc, so a table indexed by
+ * the 12-bit ADC code covers any supply voltage. Points are spaced every
+ * 16 codes and hold centi-degrees; values between points are linearly
+ * interpolated in fixed point, within 0.05 °C of the Beta equation from
+ * -40 to +60 °C. Tables for the standard profiles are evaluated by the
+ * compiler and live in flash, other parameter sets are generated once at
+ * driver init.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace ntc {
+
+constexpr int ADC_MAX_CODE = 4095;
+constexpr int ADC_FRACTION_BITS = 4;        // Lookup input is 12.4 fixed point
+constexpr int STEP_BITS = 4;                // 16 ADC codes per segment
+constexpr int TABLE_SIZE = ((ADC_MAX_CODE + 1) >> STEP_BITS) + 1;
+
+constexpr int16_t CENTI_MIN = -27315;       // Open divider side (R -> infinity)
+constexpr int16_t CENTI_MAX = INT16_MAX;    // Shorted NTC (R -> 0)
+
+using Table = std::array<int16_t, TABLE_SIZE>;
+
+/**
+ * @brief Natural logarithm usable in constant expressions
+ */
+constexpr double ln(double x) {
+    constexpr double LN2 = 0.69314718055994530942;
+    int exponent = 0;
+    while (x > 2.0) { x /= 2.0; exponent++; }
+    while (x < 1.0) { x *= 2.0; exponent--; }
+
+    // ln(x) = 2 * atanh((x - 1) / (x + 1)), |y| <= 1/3 after reduction
+    double y = (x - 1.0) / (x + 1.0);
+    double y2 = y * y;
+    double term = y;
+    double sum = 0.0;
+    for (int n = 1; n < 40; n += 2) {
+        sum += term / n;
+        term *= y2;
+    }
+    return 2.0 * sum + exponent * LN2;
+}
+
+/**
+ * @brief Beta equation: 1/T = 1/T0 + ln(R/R0) / B
+ */
+constexpr double beta_celsius(double resistance, double r_nominal, double beta, double t_nominal) {
+    constexpr double KELVIN = 273.15;
+    return 1.0 / (1.0 / (t_nominal + KELVIN) + ln(resistance / r_nominal) / beta) - KELVIN;
+}
+
+/**
+ * @brief Build a table from any resistance to temperature function
+ * @param r_series Divider series resistor (NTC on the low side)
+ * @param celsius Callable double(double resistance)
+ */
+template <typename Fn>
+constexpr Table make_table(double r_series, Fn celsius) {
+    Table table{};
+    for (int i = 0; i < TABLE_SIZE; i++) {
+        int code = i << STEP_BITS;
+        double value = 0.0;
+        if (code <= 0) {
+            value = CENTI_MAX;
+        } else if (code >= ADC_MAX_CODE) {
+            value = CENTI_MIN;
+        } else {
+            double resistance = r_series * code / (ADC_MAX_CODE - code);
+            value = celsius(resistance) * 100.0;
+        }
+        if (value > CENTI_MAX) value = CENTI_MAX;
+        if (!(value > CENTI_MIN)) value = CENTI_MIN;     // Also catches NaN
+        table[i] = static_cast<int16_t>(value < 0 ? value - 0.5 : value + 0.5);
+    }
+    return table;
+}
+
+constexpr Table make_beta_table(double r_series, double r_nominal, double beta, double t_nominal) {
+    return make_table(r_series, [=](double resistance) {
+        return beta_celsius(resistance, r_nominal, beta, t_nominal);
+    });
+}
+
+// Standard profiles with a matched divider (R_series == R_nominal)
+inline constexpr Table TABLE_10K_3950 = make_beta_table(10000.0, 10000.0, 3950.0, 25.0);
+inline constexpr Table TABLE_10K_3435 = make_beta_table(10000.0, 10000.0, 3435.0, 25.0);
+inline constexpr Table TABLE_100K_3950 = make_beta_table(100000.0, 100000.0, 3950.0, 25.0);
+
+/**
+ * @brief Precomputed table for a parameter set, nullptr if there is none
+ */
+inline const Table* builtin_table(float r_series, float r_nominal, float beta, float t_nominal) {
+    if (r_series != r_nominal || t_nominal != 25.0f) {
+        return nullptr;
+    }
+    if (r_nominal == 10000.0f && beta == 3950.0f) return &TABLE_10K_3950;
+    if (r_nominal == 10000.0f && beta == 3435.0f) return &TABLE_10K_3435;
+    if (r_nominal == 100000.0f && beta == 3950.0f) return &TABLE_100K_3950;
+    return nullptr;
+}
+
+/**
+ * @brief Interpolate temperature for an ADC code
+ * @param code_q4 ADC code in 12.4 fixed point
+ * @return Temperature in centi-degrees Celsius
+ */
+inline int32_t lookup(const Table& table, int32_t code_q4) {
+    constexpr int SHIFT = STEP_BITS + ADC_FRACTION_BITS;
+    constexpr int32_t MAX_Q4 = ((ADC_MAX_CODE + 1) << ADC_FRACTION_BITS) - 1;
+
+    if (code_q4 < 0) code_q4 = 0;
+    if (code_q4 > MAX_Q4) code_q4 = MAX_Q4;
+
+    int32_t index = code_q4 >> SHIFT;
+    int32_t fraction = code_q4 & ((1 << SHIFT) - 1);
+    int32_t low = table[index];
+    int32_t high = table[index + 1];
+    return low + (((high - low) * fraction) >> SHIFT);
+}
+
+} // namespace ntc
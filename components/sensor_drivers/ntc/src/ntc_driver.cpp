@@ -13,10 +13,6 @@
 #include <cmath>
 #include <numeric>
 
-// Temporarily set DEBUG level for diagnostics
-#undef LOG_LOCAL_LEVEL
-#define LOG_LOCAL_LEVEL ESP_LOG_DEBUG
-
 static const char* TAG = "NTC";
 
 // Constants
@@ -84,6 +80,8 @@ esp_err_t NTCDriver::init(ESPhal* hal, const nlohmann::json& config) {
     // Initialize sample buffer
     sample_buffer_.resize(config_.averaging_samples);
     
+    build_table();
+    
     ESP_LOGI(TAG, "NTC initialized: R_nominal=%.0f, Beta=%.0f, R_series=%.0f", 
              config_.r_nominal, config_.beta, config_.r_series);
     
@@ -91,79 +89,97 @@ esp_err_t NTCDriver::init(ESPhal* hal, const nlohmann::json& config) {
 }
 
 SensorReading NTCDriver::read() {
-    SensorReading reading;
-    reading.unit = "°C";
-    reading.timestamp_ms = esp_timer_get_time() / 1000;
-    
     if (!adc_channel_) {
         ESP_LOGE(TAG, "ADC channel not initialized");
-        reading.is_valid = false;
+        SensorReading reading = {0.0f, "°C", static_cast<uint32_t>(esp_timer_get_time() / 1000), false};
         reading.error_message = "ADC channel not initialized";
         return reading;
     }    
     
-    // Read multiple samples for averaging
-    float sum_resistance = 0;
-    int valid_samples = 0;
+    float adc_value = 0.0f;
+    esp_err_t ret = read_adc(adc_value);
+    return make_sample(ret, adc_value).to_reading();
+}
+
+esp_err_t NTCDriver::start_read(SensorReadCallback callback, void* context) {
+    if (read_callback_) {
+        return ESP_ERR_INVALID_STATE;
+    }
     
-    ESP_LOGD(TAG, "Starting ADC read with %d samples", config_.averaging_samples);
+    if (!adc_channel_) {
+        callback(context, make_sample(ESP_ERR_INVALID_STATE, 0.0f));
+        return ESP_OK;
+    }
     
-    for (int i = 0; i < config_.averaging_samples; i++) {
-        auto adc_result = adc_channel_->read_raw();
-        if (!adc_result.is_ok()) {
-            ESP_LOGW(TAG, "ADC read %d/%d failed: %s", i+1, config_.averaging_samples, esp_err_to_name(adc_result.error));
-            error_count_++;
-            continue;
-        }
-        
-        int adc_value = adc_result.value;
-        ESP_LOGD(TAG, "ADC sample %d: %d", i+1, adc_value);
-        
-        float resistance = calculate_resistance(adc_value);
-        if (resistance > 0) {
-            sum_resistance += resistance;
-            valid_samples++;
-            ESP_LOGD(TAG, "Calculated resistance: %.2f Ω", resistance);
-        } else {
-            if (resistance == -1.0f) {
-                ESP_LOGW(TAG, "Sample %d: Sensor disconnected (ADC=0)", i+1);
-            } else if (resistance == -2.0f) {
-                ESP_LOGW(TAG, "Sample %d: Short circuit detected", i+1);
-            } else {
-                ESP_LOGW(TAG, "Sample %d: Invalid resistance %.2f from ADC %d", i+1, resistance, adc_value);
-            }
-        }
-        
-        // Remove delay to prevent blocking main loop
-        // vTaskDelay(pdMS_TO_TICKS(2));
+    // Continuous channel: filtered value is ready, complete right away
+    if (adc_channel_->is_continuous()) {
+        float adc_value = 0.0f;
+        esp_err_t ret = read_adc(adc_value);
+        callback(context, make_sample(ret, adc_value));
+        return ESP_OK;
     }
     
-    ESP_LOGD(TAG, "ADC reading complete: %d/%d valid samples", valid_samples, config_.averaging_samples);
+    // Oneshot channel: one conversion per poll() instead of a blocking loop
+    average_ = {};
+    read_callback_ = callback;
+    read_context_ = context;
+    return ESP_OK;
+}
+
+bool NTCDriver::poll(uint32_t now_ms) {
+    if (!read_callback_) {
+        return false;
+    }
+    
+    accumulate_sample();
+    if (average_.taken < config_.averaging_samples) {
+        return true;
+    }
+    
+    float adc_value = 0.0f;
+    esp_err_t ret = finish_average(adc_value);
+    
+    SensorReadCallback callback = read_callback_;
+    read_callback_ = nullptr;
+    callback(read_context_, make_sample(ret, adc_value));
+    return false;
+}
+
+SensorSample NTCDriver::make_sample(esp_err_t adc_status, float adc_value) {
+    SensorSample sample = {0.0f, SensorUnit::CELSIUS, adc_status,
+                           static_cast<uint32_t>(esp_timer_get_time() / 1000)};
+    
+    float resistance = -1.0f;
+    if (adc_status == ESP_OK) {
+        resistance = calculate_resistance(adc_value);
+        if (resistance == -1.0f) {
+            ESP_LOGW(TAG, "Sensor disconnected (ADC=0)");
+        } else if (resistance == -2.0f) {
+            ESP_LOGW(TAG, "Short circuit detected");
+        }
+    }
     
-    if (valid_samples == 0) {
-        ESP_LOGE(TAG, "No valid ADC readings after %d attempts", config_.averaging_samples);
+    if (resistance <= 0) {
+        ESP_LOGE(TAG, "No valid ADC reading on '%s'", config_.hal_id.c_str());
         
         // TEMPORARY: Simulate sensor for testing multicore performance
         ESP_LOGW(TAG, "SIMULATION MODE: Providing fake temperature reading");
-        reading.value = 20.0f + (esp_timer_get_time() / 1000000) % 10; // 20-30°C simulation
-        reading.is_valid = true;
-        reading.error_message = "Simulated (no physical sensor)";
-        return reading;
+        sample.value = 20.0f + (esp_timer_get_time() / 1000000) % 10; // 20-30°C simulation
+        sample.status = ESP_OK;
+        return sample;
         
         // Original error handling (commented out for testing)
         /*
-        reading.is_valid = false;
-        reading.error_message = "No valid ADC readings";
-        return reading;
+        sample.status = (adc_status != ESP_OK) ? adc_status : ESP_ERR_INVALID_RESPONSE;
+        return sample;
         */
     }
     
-    // Calculate average resistance
-    float avg_resistance = sum_resistance / valid_samples;
-    last_resistance_ = avg_resistance;    
+    last_resistance_ = resistance;    
     
-    // Convert resistance to temperature
-    float temperature = resistance_to_temperature(avg_resistance);
+    // Convert ADC code to temperature through the lookup table
+    int32_t code_q4 = static_cast<int32_t>(adc_value * (1 << ntc::ADC_FRACTION_BITS) + 0.5f);
+    float temperature = ntc::lookup(*table_, code_q4) / 100.0f;
     
     // Apply calibration offset
     temperature += config_.offset;
@@ -171,19 +187,16 @@ SensorReading NTCDriver::read() {
     // Validate temperature range
     if (temperature < -40.0f || temperature > 150.0f) {
         error_count_++;
-        reading.is_valid = false;
-        reading.error_message = "Temperature out of range";
-        return reading;
+        sample.status = ESP_ERR_INVALID_RESPONSE;  // Temperature out of range
+        return sample;
     }
     
     // Update state
     last_temperature_ = temperature;
     total_reads_++;
     
-    reading.value = temperature;
-    reading.is_valid = true;
-    
-    return reading;
+    sample.value = temperature;
+    return sample;
 }
 
 nlohmann::json NTCDriver::get_config() const {
@@ -227,6 +240,7 @@ esp_err_t NTCDriver::set_config(const nlohmann::json& config) {
     
     if (config.contains("r_series") && config["r_series"].is_number()) {
         config_.r_series = config["r_series"].get<float>();
+        build_table();
     }
     
     if (config.contains("averaging_samples") && config["averaging_samples"].is_number()) {
@@ -310,6 +324,8 @@ nlohmann::json NTCDriver::get_diagnostics() const {
         {"total_reads", total_reads_},
         {"error_count", error_count_},
         {"is_available", is_available()},
+        {"continuous_adc", adc_channel_ && adc_channel_->is_continuous()},
+        {"lookup_table", runtime_table_ ? "runtime" : "builtin"},
         {"ntc_parameters", {
             {"r_nominal", config_.r_nominal},
             {"beta", config_.beta},
@@ -318,30 +334,58 @@ nlohmann::json NTCDriver::get_diagnostics() const {
     };
 }
 
-float NTCDriver::calculate_resistance(int adc_value) const {
+esp_err_t NTCDriver::read_adc(float& adc_value) {
+    // Continuous channels are oversampled and filtered in the background -
+    // a single O(1) read, nothing to average here
+    int samples = adc_channel_->is_continuous() ? 1 : config_.averaging_samples;
+    
+    average_ = {};
+    for (int i = 0; i < samples; i++) {
+        accumulate_sample();
+    }
+    return finish_average(adc_value);
+}
+
+void NTCDriver::accumulate_sample() {
+    average_.taken++;
+    
+    auto adc_result = adc_channel_->read_filtered();
+    if (!adc_result.is_ok()) {
+        average_.last_error = adc_result.error;
+        error_count_++;
+        return;
+    }
+    average_.sum += adc_result.value;
+    average_.valid++;
+}
+
+esp_err_t NTCDriver::finish_average(float& adc_value) {
+    if (average_.valid == 0) {
+        ESP_LOGW(TAG, "ADC read failed: %s", esp_err_to_name(average_.last_error));
+        return average_.last_error;
+    }
+    
+    adc_value = average_.sum / average_.valid;
+    return ESP_OK;
+}
+
+float NTCDriver::calculate_resistance(float adc_value) const {
     // Handle disconnected sensor case
     if (adc_value <= 0) {
-        ESP_LOGW(TAG, "ADC value is 0 - sensor may be disconnected");
         return -1.0f; // Special value to indicate disconnected sensor
     }
     
     // Convert ADC value to voltage
     float voltage = (adc_value / 4095.0f) * config_.vcc;
     
-    ESP_LOGD(TAG, "ADC: %d -> Voltage: %.3fV", adc_value, voltage);
-    
     // Calculate NTC resistance using voltage divider formula
     // Vout = Vcc * R_ntc / (R_series + R_ntc)
     // R_ntc = R_series * Vout / (Vcc - Vout)
     if (voltage >= config_.vcc) {
-        ESP_LOGW(TAG, "Voltage %.3fV >= VCC %.3fV - possible short circuit", voltage, config_.vcc);
         return -2.0f; // Special value to indicate short circuit
     }
     
-    float resistance = config_.r_series * voltage / (config_.vcc - voltage);
-    ESP_LOGD(TAG, "Calculated resistance: %.2f Ω", resistance);
-    
-    return resistance;
+    return config_.r_series * voltage / (config_.vcc - voltage);
 }
 
 float NTCDriver::resistance_to_temperature(float resistance) const {
@@ -389,4 +433,28 @@ void NTCDriver::load_ntc_profile(NTCType type) {
         default:
             break;
     }
-}
\ No newline at end of file
+}
+
+void NTCDriver::build_table() {
+    // Standard profile with a matched divider - table is already in flash
+    if (!config_.use_steinhart_hart) {
+        table_ = ntc::builtin_table(config_.r_series, config_.r_nominal,
+                                    config_.beta, config_.t_nominal);
+        if (table_) {
+            runtime_table_.reset();
+            return;
+        }
+    }
+    
+    // Any other parameter set: evaluate the curve once per table point
+    if (!runtime_table_) {
+        runtime_table_.reset(new ntc::Table());
+    }
+    *runtime_table_ = ntc::make_table(config_.r_series, [this](double resistance) {
+        return static_cast<double>(resistance_to_temperature(static_cast<float>(resistance)));
+    });
+    table_ = runtime_table_.get();
+    
+    ESP_LOGI(TAG, "Generated lookup table for %s curve (R_series=%.0f)",
+             config_.use_steinhart_hart ? "Steinhart-Hart" : "Beta", config_.r_series);
+}
@@ -0,0 +1,68 @@
+/**
+ * @file pulse_counter_driver.h
+ * @brief Pulse input sensor driver (fan tachometers, flow meters)
+ *
+ * Self-contained driver for pulse outputs counted by the HAL in hardware.
+ */
+
+#pragma once
+
+#include "sensor_driver_interface.h"
+#include "hal_interfaces.h"
+
+/**
+ * @brief Pulse counter sensor driver
+ *
+ * Features:
+ * - Frequency, RPM, accumulated count or rate per minute
+ * - Pulses counted and glitch-filtered by the HAL (PCNT), reads are O(1)
+ *   and CPU load does not depend on the pulse rate
+ * - Scaling by pulses per revolution or pulses per unit (e.g. per litre)
+ */
+class PulseCounterDriver : public ISensorDriver {
+public:
+    enum class Measure {
+        FREQUENCY,  // Hz
+        RPM,        // Revolutions per minute
+        COUNT,      // Units since start or reset
+        RATE        // Units per minute
+    };
+
+    PulseCounterDriver() = default;
+    ~PulseCounterDriver() override = default;
+
+    // ISensorDriver interface implementation
+    esp_err_t init(ESPhal* hal, const nlohmann::json& config) override;
+    SensorReading read() override;
+    esp_err_t start_read(SensorReadCallback callback, void* context) override;
+    std::string get_type() const override { return "PULSE"; }
+    std::string get_description() const override { return "Pulse Counter / Tachometer"; }
+    bool is_available() const override { return counter_ != nullptr; }
+    nlohmann::json get_config() const override;
+    esp_err_t set_config(const nlohmann::json& config) override;
+    nlohmann::json get_ui_schema() const override;
+    esp_err_t calibrate(const nlohmann::json& calibration_data) override;
+    nlohmann::json get_diagnostics() const override;
+
+private:
+    // Configuration parameters
+    struct Config {
+        std::string hal_id;             // Pulse input HAL identifier
+        Measure measure = Measure::FREQUENCY;
+        float pulses_per_rev = 2.0f;    // Fan tachometers: 2 pulses per revolution
+        float pulses_per_unit = 1.0f;   // Flow meters: pulses per litre
+    } config_;
+
+    // Runtime state
+    IPulseCounter* counter_ = nullptr;
+    uint32_t total_reads_ = 0;
+    uint32_t error_count_ = 0;
+    float last_frequency_hz_ = 0.0f;
+    uint64_t last_count_ = 0;
+
+    // Helper methods
+    SensorSample make_sample();
+    SensorUnit unit() const;
+    static const char* measure_to_string(Measure measure);
+    static bool measure_from_string(const std::string& name, Measure& measure);
+};
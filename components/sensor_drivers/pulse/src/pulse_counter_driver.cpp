@@ -0,0 +1,221 @@
+/**
+ * @file pulse_counter_driver.cpp
+ * @brief Implementation of the pulse counter sensor driver
+ */
+
+#include "pulse_counter_driver.h"
+#include "esphal.h"
+#include <esp_log.h>
+#include <esp_timer.h>
+
+static const char* TAG = "PulseCounter";
+
+esp_err_t PulseCounterDriver::init(ESPhal* hal, const nlohmann::json& config) {
+    ESP_LOGI(TAG, "Initializing pulse counter driver");
+
+    if (!config.contains("hal_id") || !config["hal_id"].is_string()) {
+        ESP_LOGE(TAG, "Missing or invalid hal_id in configuration");
+        return ESP_ERR_INVALID_ARG;
+    }
+    config_.hal_id = config["hal_id"].get<std::string>();
+
+    esp_err_t ret = set_config(config);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    counter_ = hal->get_pulse_counter_ptr(config_.hal_id);
+    if (!counter_) {
+        ESP_LOGE(TAG, "Failed to get pulse input '%s'", config_.hal_id.c_str());
+        return ESP_FAIL;
+    }
+
+    ESP_LOGI(TAG, "Pulse input '%s': %s, %.1f pulses/rev, %.1f pulses/unit",
+             config_.hal_id.c_str(), measure_to_string(config_.measure),
+             config_.pulses_per_rev, config_.pulses_per_unit);
+    return ESP_OK;
+}
+
+SensorReading PulseCounterDriver::read() {
+    return make_sample().to_reading();
+}
+
+esp_err_t PulseCounterDriver::start_read(SensorReadCallback callback, void* context) {
+    // Counting runs in hardware, the value is always ready
+    callback(context, make_sample());
+    return ESP_OK;
+}
+
+SensorSample PulseCounterDriver::make_sample() {
+    SensorSample sample = {0.0f, unit(), ESP_OK,
+                           static_cast<uint32_t>(esp_timer_get_time() / 1000)};
+
+    if (!counter_) {
+        sample.status = ESP_ERR_INVALID_STATE;
+        return sample;
+    }
+
+    if (config_.measure == Measure::COUNT) {
+        auto count = counter_->get_count();
+        if (!count.is_ok()) {
+            error_count_++;
+            sample.status = count.error;
+            return sample;
+        }
+        last_count_ = count.value;
+        sample.value = static_cast<float>(count.value) / config_.pulses_per_unit;
+    } else {
+        // ESP_ERR_NOT_FINISHED until the first gate window has passed
+        auto frequency = counter_->get_frequency_hz();
+        if (!frequency.is_ok()) {
+            if (frequency.error != ESP_ERR_NOT_FINISHED) {
+                error_count_++;
+            }
+            sample.status = frequency.error;
+            return sample;
+        }
+        last_frequency_hz_ = frequency.value;
+
+        switch (config_.measure) {
+            case Measure::RPM:
+                sample.value = frequency.value * 60.0f / config_.pulses_per_rev;
+                break;
+            case Measure::RATE:
+                sample.value = frequency.value * 60.0f / config_.pulses_per_unit;
+                break;
+            default:
+                sample.value = frequency.value;
+                break;
+        }
+    }
+
+    total_reads_++;
+    return sample;
+}
+
+SensorUnit PulseCounterDriver::unit() const {
+    switch (config_.measure) {
+        case Measure::FREQUENCY: return SensorUnit::HERTZ;
+        case Measure::RPM: return SensorUnit::RPM;
+        default: return SensorUnit::NONE;
+    }
+}
+
+const char* PulseCounterDriver::measure_to_string(Measure measure) {
+    switch (measure) {
+        case Measure::RPM: return "rpm";
+        case Measure::COUNT: return "count";
+        case Measure::RATE: return "rate";
+        default: return "frequency";
+    }
+}
+
+bool PulseCounterDriver::measure_from_string(const std::string& name, Measure& measure) {
+    for (auto candidate : {Measure::FREQUENCY, Measure::RPM, Measure::COUNT, Measure::RATE}) {
+        if (name == measure_to_string(candidate)) {
+            measure = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+nlohmann::json PulseCounterDriver::get_config() const {
+    return {
+        {"hal_id", config_.hal_id},
+        {"measure", measure_to_string(config_.measure)},
+        {"pulses_per_rev", config_.pulses_per_rev},
+        {"pulses_per_unit", config_.pulses_per_unit}
+    };
+}
+
+esp_err_t PulseCounterDriver::set_config(const nlohmann::json& config) {
+    if (!config.is_object()) {
+        ESP_LOGE(TAG, "Configuration must be an object");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (config.contains("measure") && config["measure"].is_string()) {
+        if (!measure_from_string(config["measure"].get<std::string>(), config_.measure)) {
+            ESP_LOGE(TAG, "Unknown measure '%s'", config["measure"].get<std::string>().c_str());
+            return ESP_ERR_INVALID_ARG;
+        }
+    }
+
+    if (config.contains("pulses_per_rev") && config["pulses_per_rev"].is_number()) {
+        float value = config["pulses_per_rev"].get<float>();
+        if (value <= 0.0f) {
+            return ESP_ERR_INVALID_ARG;
+        }
+        config_.pulses_per_rev = value;
+    }
+
+    if (config.contains("pulses_per_unit") && config["pulses_per_unit"].is_number()) {
+        float value = config["pulses_per_unit"].get<float>();
+        if (value <= 0.0f) {
+            return ESP_ERR_INVALID_ARG;
+        }
+        config_.pulses_per_unit = value;
+    }
+
+    return ESP_OK;
+}
+
+nlohmann::json PulseCounterDriver::get_ui_schema() const {
+    return {
+        {"type", "object"},
+        {"title", "Pulse Counter Settings"},
+        {"properties", {
+            {"measure", {
+                {"type", "string"},
+                {"title", "Measure"},
+                {"enum", {"frequency", "rpm", "count", "rate"}},
+                {"default", "frequency"}
+            }},
+            {"pulses_per_rev", {
+                {"type", "number"},
+                {"title", "Pulses per Revolution"},
+                {"minimum", 1},
+                {"maximum", 100},
+                {"default", 2}
+            }},
+            {"pulses_per_unit", {
+                {"type", "number"},
+                {"title", "Pulses per Unit"},
+                {"minimum", 0.001},
+                {"maximum", 100000},
+                {"default", 1}
+            }}
+        }}
+    };
+}
+
+esp_err_t PulseCounterDriver::calibrate(const nlohmann::json& calibration_data) {
+    if (!calibration_data.is_object()) {
+        ESP_LOGE(TAG, "Calibration data must be an object");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // Reset of a totalizer, e.g. after replacing a water filter
+    if (calibration_data.value("reset_count", false)) {
+        if (!counter_) {
+            return ESP_ERR_INVALID_STATE;
+        }
+        ESP_LOGI(TAG, "Pulse count on '%s' reset", config_.hal_id.c_str());
+        return counter_->reset();
+    }
+
+    return ESP_ERR_INVALID_ARG;
+}
+
+nlohmann::json PulseCounterDriver::get_diagnostics() const {
+    return {
+        {"driver_type", "PULSE"},
+        {"measure", measure_to_string(config_.measure)},
+        {"last_frequency_hz", last_frequency_hz_},
+        {"last_count", last_count_},
+        {"total_reads", total_reads_},
+        {"error_count", error_count_},
+        {"is_available", is_available()}
+    };
+}
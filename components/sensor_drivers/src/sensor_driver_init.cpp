@@ -19,6 +19,18 @@
 #include "ds18b20_async_driver.h"
 #endif
 
+#ifdef CONFIG_SENSOR_DRIVER_GPIO_INPUT_ENABLED
+#include "gpio_input_driver.h"
+#endif
+
+#ifdef CONFIG_SENSOR_DRIVER_VIRTUAL_ENABLED
+#include "virtual_sensor_driver.h"
+#endif
+
+#ifdef CONFIG_SENSOR_DRIVER_PULSE_ENABLED
+#include "pulse_counter_driver.h"
+#endif
+
 static const char* TAG = "SensorDriverInit";
 
 void initialize_builtin_sensor_drivers() {
@@ -41,6 +53,30 @@ void initialize_builtin_sensor_drivers() {
     });
     ESP_LOGI(TAG, "Registered DS18B20_Async driver");
 #endif
+
+#ifdef CONFIG_SENSOR_DRIVER_GPIO_INPUT_ENABLED
+    // Register GPIO input driver
+    registry.register_driver("GPIO_INPUT", []() -> std::unique_ptr<ISensorDriver> {
+        return std::make_unique<GpioInputDriver>();
+    });
+    ESP_LOGI(TAG, "Registered GPIO_INPUT driver");
+#endif
+
+#ifdef CONFIG_SENSOR_DRIVER_VIRTUAL_ENABLED
+    // Register virtual (computed) sensor driver
+    registry.register_driver("VIRTUAL", []() -> std::unique_ptr<ISensorDriver> {
+        return std::make_unique<VirtualSensorDriver>();
+    });
+    ESP_LOGI(TAG, "Registered VIRTUAL driver");
+#endif
+
+#ifdef CONFIG_SENSOR_DRIVER_PULSE_ENABLED
+    // Register pulse counter driver
+    registry.register_driver("PULSE", []() -> std::unique_ptr<ISensorDriver> {
+        return std::make_unique<PulseCounterDriver>();
+    });
+    ESP_LOGI(TAG, "Registered PULSE driver");
+#endif
     
     // Get registered types using public method
     auto registered_types = registry.get_registered_types();
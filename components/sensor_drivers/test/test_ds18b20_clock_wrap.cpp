@@ -0,0 +1,62 @@
+/**
+ * @file test_ds18b20_clock_wrap.cpp
+ * @brief DS18B20 bus coordinator across the 32-bit millisecond clock wrap
+ */
+
+#include "sdkconfig.h"
+
+#ifdef CONFIG_SENSOR_DRIVER_DS18B20_ASYNC_ENABLED
+
+#include "unity.h"
+#include "ds18b20_bus_coordinator.h"
+
+namespace {
+
+// Bus with one sensor that always answers 21.5 C
+class FakeOneWireBus : public IOneWireBus {
+public:
+    std::vector<uint64_t> search_devices() override { return {ADDRESS}; }
+    esp_err_t request_temperatures() override { conversions++; return ESP_OK; }
+    esp_err_t start_temperature_conversion(uint64_t) override { return ESP_OK; }
+    HalResult<float> read_temperature(uint64_t) override { return HalResult<float>{21.5f, ESP_OK}; }
+
+    static constexpr uint64_t ADDRESS = 0x28FF000000000001ULL;
+    int conversions = 0;
+};
+
+} // namespace
+
+TEST_CASE("conversion started before the wrap completes after it", "[ds18b20]")
+{
+    static FakeOneWireBus bus;  // Coordinators live for the whole run
+    DS18B20BusCoordinator& coordinator = DS18B20BusCoordinator::for_bus(&bus);
+    DS18B20BusCoordinator::SlotId slot = coordinator.attach(FakeOneWireBus::ADDRESS, 12);
+    DS18B20BusCoordinator::Result result;
+
+    // Broadcast 200 ms before the clock wraps
+    const uint32_t start_ms = UINT32_MAX - 199;
+    TEST_ASSERT_FALSE(coordinator.poll(slot, start_ms, result));
+    TEST_ASSERT_EQUAL(1, bus.conversions);
+    TEST_ASSERT_TRUE(coordinator.is_converting());
+
+    // Just past the wrap, conversion still running
+    TEST_ASSERT_FALSE(coordinator.poll(slot, start_ms + 500, result));
+    TEST_ASSERT_TRUE(coordinator.is_converting());
+
+    // Conversion time elapsed on the wrapped clock
+    const uint32_t done_ms = start_ms + DS18B20BusCoordinator::conversion_time_ms(12);
+    TEST_ASSERT_TRUE(done_ms < start_ms);
+    TEST_ASSERT_TRUE(coordinator.poll(slot, done_ms, result));
+    TEST_ASSERT_EQUAL(ESP_OK, result.error);
+    TEST_ASSERT_EQUAL_FLOAT(21.5f, result.temperature);
+    TEST_ASSERT_EQUAL(1, coordinator.cycles());
+    TEST_ASSERT_TRUE(coordinator.last_refresh_ms() < 2000);
+
+    // Next cycle runs normally after the wrap
+    TEST_ASSERT_FALSE(coordinator.poll(slot, done_ms + 10, result));
+    TEST_ASSERT_EQUAL(2, bus.conversions);
+
+    coordinator.detach(slot);
+}
+
+#endif // CONFIG_SENSOR_DRIVER_DS18B20_ASYNC_ENABLED
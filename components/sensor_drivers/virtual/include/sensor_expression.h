@@ -0,0 +1,89 @@
+/**
+ * @file sensor_expression.h
+ * @brief Arithmetic expressions over sensor roles compiled to bytecode
+ *
+ * Grammar:
+ *   expr    := term (('+' | '-') term)*
+ *   term    := unary (('*' | '/') unary)*
+ *   unary   := '-' unary | primary
+ *   primary := number | role | func '(' expr (',' expr)* ')' | '(' expr ')'
+ *   func    := min | max | avg | abs
+ *
+ * Example: "avg(chamber_temp, product_temp) - evaporator_temp"
+ */
+
+#pragma once
+
+#include <esp_err.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Compiled expression evaluated on a fixed-size value stack
+ */
+class SensorExpression {
+public:
+    static constexpr size_t MAX_STACK = 16;
+
+    /**
+     * @brief Parse and compile an expression
+     * @return ESP_OK, or ESP_ERR_INVALID_ARG with error() describing the problem
+     */
+    esp_err_t compile(const std::string& text);
+
+    /**
+     * @brief Role names referenced by the expression, in input order
+     */
+    const std::vector<std::string>& inputs() const { return inputs_; }
+
+    /**
+     * @brief Evaluate with input values in inputs() order
+     */
+    float evaluate(const float* values) const;
+
+    const std::string& error() const { return error_; }
+    size_t code_size() const { return code_.size(); }
+
+private:
+    enum class Op : uint8_t {
+        CONST,      // Push constants_[arg]
+        INPUT,      // Push values[arg]
+        ADD,
+        SUB,
+        MUL,
+        DIV,
+        NEG,
+        ABS,
+        MIN,
+        MAX,
+        SCALE       // Multiply by constants_[arg] (avg = sum * 1/n)
+    };
+
+    struct Instr {
+        Op op;
+        uint8_t arg;
+    };
+
+    // Recursive descent parser emitting postfix code
+    bool parse_expr();
+    bool parse_term();
+    bool parse_unary();
+    bool parse_primary();
+    bool parse_call(const std::string& name);
+    void skip_spaces();
+    bool fail(const char* message);
+    void emit(Op op, uint8_t arg = 0);
+    uint8_t add_constant(float value);
+
+    std::vector<Instr> code_;
+    std::vector<float> constants_;
+    std::vector<std::string> inputs_;
+    std::string error_;
+
+    // Parser state
+    const char* text_ = nullptr;
+    size_t pos_ = 0;
+    int depth_ = 0;
+    int max_depth_ = 0;
+};
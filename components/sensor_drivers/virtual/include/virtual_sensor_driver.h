@@ -0,0 +1,66 @@
+/**
+ * @file virtual_sensor_driver.h
+ * @brief Computed sensor whose value is an expression over other sensors
+ *
+ * Derived values (superheat, evaporator-chamber delta, averaged probes)
+ * are configured in sensors.json instead of a dedicated module:
+ *
+ *   {
+ *     "role": "evap_delta",
+ *     "type": "VIRTUAL",
+ *     "publish_key": "temp.evap_delta",
+ *     "config": {"expression": "chamber_temp - evaporator_temp", "unit": "°C"}
+ *   }
+ */
+
+#pragma once
+
+#include "sensor_driver_interface.h"
+#include "sensor_expression.h"
+#include <vector>
+
+/**
+ * @brief Virtual sensor driver
+ *
+ * Features:
+ * - Expression compiled once to bytecode at init
+ * - Inputs read from SensorValueTable by pre-resolved slots
+ * - Re-evaluated only when an input has been updated
+ * - Invalid while any input is invalid or not read yet
+ */
+class VirtualSensorDriver : public ISensorDriver {
+public:
+    VirtualSensorDriver() = default;
+    ~VirtualSensorDriver() override = default;
+
+    // ISensorDriver interface implementation
+    esp_err_t init(ESPhal* hal, const nlohmann::json& config) override;
+    SensorReading read() override;
+    esp_err_t start_read(SensorReadCallback callback, void* context) override;
+    std::string get_type() const override { return "VIRTUAL"; }
+    std::string get_description() const override { return "Computed sensor (expression over other sensors)"; }
+    bool is_available() const override { return !slots_.empty(); }
+    nlohmann::json get_config() const override;
+    esp_err_t set_config(const nlohmann::json& config) override;
+    nlohmann::json get_ui_schema() const override;
+    nlohmann::json get_diagnostics() const override;
+
+private:
+    SensorSample evaluate();
+    esp_err_t compile(const std::string& expression);
+
+    // Configuration
+    std::string expression_text_;
+    SensorUnit unit_ = SensorUnit::NONE;
+
+    // Compiled state
+    SensorExpression expression_;
+    std::vector<int> slots_;            // SensorValueTable slot per input
+    std::vector<uint32_t> versions_;    // Input versions of the cached result
+    std::vector<float> values_;
+    SensorSample cached_ = {0.0f, SensorUnit::NONE, ESP_ERR_NOT_FINISHED, 0};
+
+    // Statistics
+    uint32_t evaluations_ = 0;
+    uint32_t cache_hits_ = 0;
+};
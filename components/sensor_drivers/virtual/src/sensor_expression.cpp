@@ -0,0 +1,225 @@
+/**
+ * @file sensor_expression.cpp
+ * @brief Implementation of the sensor expression compiler and evaluator
+ */
+
+#include "sensor_expression.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+
+esp_err_t SensorExpression::compile(const std::string& text) {
+    code_.clear();
+    constants_.clear();
+    inputs_.clear();
+    error_.clear();
+
+    text_ = text.c_str();
+    pos_ = 0;
+    depth_ = 0;
+    max_depth_ = 0;
+
+    bool ok = parse_expr();
+    skip_spaces();
+    if (ok && text_[pos_] != '\0') {
+        ok = fail("unexpected character");
+    }
+    if (ok && max_depth_ > static_cast<int>(MAX_STACK)) {
+        ok = fail("expression too deep");
+    }
+    if (ok && (inputs_.size() > UINT8_MAX || constants_.size() > UINT8_MAX)) {
+        ok = fail("too many operands");
+    }
+
+    text_ = nullptr;
+    if (!ok) {
+        code_.clear();
+        return ESP_ERR_INVALID_ARG;
+    }
+    return ESP_OK;
+}
+
+float SensorExpression::evaluate(const float* values) const {
+    float stack[MAX_STACK];
+    int top = -1;
+
+    for (const Instr& instr : code_) {
+        switch (instr.op) {
+            case Op::CONST: stack[++top] = constants_[instr.arg]; break;
+            case Op::INPUT: stack[++top] = values[instr.arg]; break;
+            case Op::ADD: top--; stack[top] += stack[top + 1]; break;
+            case Op::SUB: top--; stack[top] -= stack[top + 1]; break;
+            case Op::MUL: top--; stack[top] *= stack[top + 1]; break;
+            case Op::DIV: top--; stack[top] /= stack[top + 1]; break;
+            case Op::NEG: stack[top] = -stack[top]; break;
+            case Op::ABS: stack[top] = std::fabs(stack[top]); break;
+            case Op::MIN: top--; stack[top] = std::min(stack[top], stack[top + 1]); break;
+            case Op::MAX: top--; stack[top] = std::max(stack[top], stack[top + 1]); break;
+            case Op::SCALE: stack[top] *= constants_[instr.arg]; break;
+        }
+    }
+    return top == 0 ? stack[0] : NAN;
+}
+
+// === Parser ===
+
+bool SensorExpression::parse_expr() {
+    if (!parse_term()) return false;
+    for (;;) {
+        skip_spaces();
+        char c = text_[pos_];
+        if (c != '+' && c != '-') return true;
+        pos_++;
+        if (!parse_term()) return false;
+        emit(c == '+' ? Op::ADD : Op::SUB);
+    }
+}
+
+bool SensorExpression::parse_term() {
+    if (!parse_unary()) return false;
+    for (;;) {
+        skip_spaces();
+        char c = text_[pos_];
+        if (c != '*' && c != '/') return true;
+        pos_++;
+        if (!parse_unary()) return false;
+        emit(c == '*' ? Op::MUL : Op::DIV);
+    }
+}
+
+bool SensorExpression::parse_unary() {
+    skip_spaces();
+    if (text_[pos_] == '-') {
+        pos_++;
+        if (!parse_unary()) return false;
+        emit(Op::NEG);
+        return true;
+    }
+    return parse_primary();
+}
+
+bool SensorExpression::parse_primary() {
+    skip_spaces();
+    char c = text_[pos_];
+
+    if (c == '(') {
+        pos_++;
+        if (!parse_expr()) return false;
+        skip_spaces();
+        if (text_[pos_] != ')') return fail("expected ')'");
+        pos_++;
+        return true;
+    }
+
+    if (std::isdigit(static_cast<unsigned char>(c)) || c == '.') {
+        char* end = nullptr;
+        float value = std::strtof(text_ + pos_, &end);
+        if (end == text_ + pos_) return fail("invalid number");
+        pos_ = end - text_;
+        emit(Op::CONST, add_constant(value));
+        return true;
+    }
+
+    if (std::isalpha(static_cast<unsigned char>(c)) || c == '_') {
+        size_t start = pos_;
+        while (std::isalnum(static_cast<unsigned char>(text_[pos_])) || text_[pos_] == '_' || text_[pos_] == '.') {
+            pos_++;
+        }
+        std::string name(text_ + start, pos_ - start);
+
+        skip_spaces();
+        if (text_[pos_] == '(') {
+            pos_++;
+            return parse_call(name);
+        }
+
+        // Sensor role - each distinct role is one input
+        auto it = std::find(inputs_.begin(), inputs_.end(), name);
+        size_t index = it - inputs_.begin();
+        if (it == inputs_.end()) {
+            inputs_.push_back(name);
+        }
+        emit(Op::INPUT, static_cast<uint8_t>(index));
+        return true;
+    }
+
+    return fail("expected value");
+}
+
+bool SensorExpression::parse_call(const std::string& name) {
+    Op fold;
+    if (name == "min") fold = Op::MIN;
+    else if (name == "max") fold = Op::MAX;
+    else if (name == "avg" || name == "abs") fold = Op::ADD;
+    else return fail("unknown function");
+
+    // Variadic functions fold their arguments pairwise
+    int count = 0;
+    for (;;) {
+        if (!parse_expr()) return false;
+        if (++count > 1) emit(fold);
+        skip_spaces();
+        if (text_[pos_] == ',') {
+            pos_++;
+            continue;
+        }
+        if (text_[pos_] == ')') {
+            pos_++;
+            break;
+        }
+        return fail("expected ',' or ')'");
+    }
+
+    if (name == "abs") {
+        if (count != 1) return fail("abs() takes one argument");
+        emit(Op::ABS);
+    } else if (name == "avg" && count > 1) {
+        emit(Op::SCALE, add_constant(1.0f / count));
+    }
+    return true;
+}
+
+void SensorExpression::skip_spaces() {
+    while (text_[pos_] == ' ' || text_[pos_] == '\t') {
+        pos_++;
+    }
+}
+
+bool SensorExpression::fail(const char* message) {
+    if (error_.empty()) {
+        error_ = std::string(message) + " at position " + std::to_string(pos_);
+    }
+    return false;
+}
+
+void SensorExpression::emit(Op op, uint8_t arg) {
+    switch (op) {
+        case Op::CONST:
+        case Op::INPUT:
+            depth_++;
+            max_depth_ = std::max(max_depth_, depth_);
+            break;
+        case Op::ADD:
+        case Op::SUB:
+        case Op::MUL:
+        case Op::DIV:
+        case Op::MIN:
+        case Op::MAX:
+            depth_--;
+            break;
+        default:
+            break;
+    }
+    code_.push_back({op, arg});
+}
+
+uint8_t SensorExpression::add_constant(float value) {
+    for (size_t i = 0; i < constants_.size(); i++) {
+        if (constants_[i] == value) {
+            return static_cast<uint8_t>(i);
+        }
+    }
+    constants_.push_back(value);
+    return static_cast<uint8_t>(constants_.size() - 1);
+}
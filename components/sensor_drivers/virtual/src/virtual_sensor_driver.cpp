@@ -0,0 +1,150 @@
+/**
+ * @file virtual_sensor_driver.cpp
+ * @brief Implementation of the expression-based virtual sensor
+ */
+
+#include "virtual_sensor_driver.h"
+#include "sensor_value_table.h"
+#include <esp_log.h>
+#include <esp_timer.h>
+#include <cmath>
+
+static const char* TAG = "VirtualSensor";
+
+esp_err_t VirtualSensorDriver::init(ESPhal* hal, const nlohmann::json& config) {
+    if (!config.contains("expression") || !config["expression"].is_string()) {
+        ESP_LOGE(TAG, "Missing or invalid expression in configuration");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    unit_ = sensor_unit_from_string(config.value("unit", std::string("°C")));
+    return compile(config["expression"].get<std::string>());
+}
+
+esp_err_t VirtualSensorDriver::compile(const std::string& expression) {
+    SensorExpression compiled;
+    if (compiled.compile(expression) != ESP_OK) {
+        ESP_LOGE(TAG, "Invalid expression '%s': %s", expression.c_str(), compiled.error().c_str());
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // Roles are resolved once; evaluation only indexes the value table
+    auto& table = SensorValueTable::instance();
+    slots_.clear();
+    for (const auto& role : compiled.inputs()) {
+        slots_.push_back(table.resolve(role));
+    }
+    versions_.assign(slots_.size(), 0);
+    values_.assign(slots_.size(), 0.0f);
+    cached_ = {0.0f, unit_, ESP_ERR_NOT_FINISHED, 0};
+
+    expression_ = std::move(compiled);
+    expression_text_ = expression;
+
+    ESP_LOGI(TAG, "Compiled '%s': %zu inputs, %zu instructions",
+             expression.c_str(), slots_.size(), expression_.code_size());
+    return ESP_OK;
+}
+
+SensorReading VirtualSensorDriver::read() {
+    return evaluate().to_reading();
+}
+
+esp_err_t VirtualSensorDriver::start_read(SensorReadCallback callback, void* context) {
+    callback(context, evaluate());
+    return ESP_OK;
+}
+
+SensorSample VirtualSensorDriver::evaluate() {
+    auto& table = SensorValueTable::instance();
+
+    // Nothing new since the last evaluation - reuse the result
+    bool changed = false;
+    for (size_t i = 0; i < slots_.size(); i++) {
+        if (table.get(slots_[i]).version != versions_[i]) {
+            changed = true;
+            break;
+        }
+    }
+    if (!changed && cached_.status != ESP_ERR_NOT_FINISHED) {
+        cache_hits_++;
+        return cached_;
+    }
+
+    cached_.status = ESP_OK;
+    cached_.timestamp_ms = esp_timer_get_time() / 1000;
+    for (size_t i = 0; i < slots_.size(); i++) {
+        const auto& entry = table.get(slots_[i]);
+        versions_[i] = entry.version;
+        values_[i] = entry.sample.value;
+        if (!entry.sample.is_valid()) {
+            cached_.status = ESP_ERR_INVALID_STATE;     // Input missing or invalid
+        }
+    }
+
+    if (cached_.status == ESP_OK) {
+        cached_.value = expression_.evaluate(values_.data());
+        if (!std::isfinite(cached_.value)) {
+            cached_.status = ESP_ERR_INVALID_RESPONSE;  // Division by zero
+        }
+    }
+    evaluations_++;
+    return cached_;
+}
+
+nlohmann::json VirtualSensorDriver::get_config() const {
+    return {
+        {"expression", expression_text_},
+        {"unit", sensor_unit_to_string(unit_)}
+    };
+}
+
+esp_err_t VirtualSensorDriver::set_config(const nlohmann::json& config) {
+    if (!config.is_object()) {
+        ESP_LOGE(TAG, "Configuration must be an object");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (config.contains("unit") && config["unit"].is_string()) {
+        unit_ = sensor_unit_from_string(config["unit"].get<std::string>());
+        cached_.unit = unit_;
+    }
+
+    if (config.contains("expression") && config["expression"].is_string()) {
+        return compile(config["expression"].get<std::string>());
+    }
+
+    return ESP_OK;
+}
+
+nlohmann::json VirtualSensorDriver::get_ui_schema() const {
+    return {
+        {"type", "object"},
+        {"title", "Virtual Sensor Settings"},
+        {"properties", {
+            {"expression", {
+                {"type", "string"},
+                {"title", "Expression"},
+                {"description", "Sensor roles with + - * / ( ) and min, max, avg, abs"}
+            }},
+            {"unit", {
+                {"type", "string"},
+                {"title", "Unit"},
+                {"enum", {"°C", "%", "Pa", "V", "A", ""}},
+                {"default", "°C"}
+            }}
+        }}
+    };
+}
+
+nlohmann::json VirtualSensorDriver::get_diagnostics() const {
+    return {
+        {"driver_type", "VIRTUAL"},
+        {"expression", expression_text_},
+        {"inputs", expression_.inputs()},
+        {"instructions", expression_.code_size()},
+        {"evaluations", evaluations_},
+        {"cache_hits", cache_hits_},
+        {"is_available", is_available()}
+    };
+}